@@ -457,17 +457,23 @@ int Java_org_yuzu_yuzu_1emu_NativeLibrary_installFileToNand(JNIEnv* env, jobject
     auto jlambdaClass = env->GetObjectClass(jcallback);
     auto jlambdaInvokeMethod = env->GetMethodID(
         jlambdaClass, "invoke", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
-    const auto callback = [env, jcallback, jlambdaInvokeMethod](size_t max, size_t progress) {
-        auto jwasCancelled = env->CallObjectMethod(jcallback, jlambdaInvokeMethod,
-                                                   Common::Android::ToJDouble(env, max),
-                                                   Common::Android::ToJDouble(env, progress));
-        return Common::Android::GetJBoolean(env, jwasCancelled);
+
+    // The NCAs are copied on several threads, which may each report progress.
+    const auto jcallback_global = env->NewGlobalRef(jcallback);
+    const auto callback = [jcallback_global, jlambdaInvokeMethod](size_t max, size_t progress) {
+        JNIEnv* thread_env = Common::Android::GetEnvForThread();
+        auto jwasCancelled = thread_env->CallObjectMethod(
+            jcallback_global, jlambdaInvokeMethod, Common::Android::ToJDouble(thread_env, max),
+            Common::Android::ToJDouble(thread_env, progress));
+        return Common::Android::GetJBoolean(thread_env, jwasCancelled);
     };
 
-    return static_cast<int>(
+    const auto result =
         ContentManager::InstallNSP(EmulationSession::GetInstance().System(),
                                    *EmulationSession::GetInstance().System().GetFilesystem(),
-                                   Common::Android::GetJString(env, j_file), callback));
+                                   Common::Android::GetJString(env, j_file), callback);
+    env->DeleteGlobalRef(jcallback_global);
+    return static_cast<int>(result);
 }
 
 jboolean Java_org_yuzu_yuzu_1emu_NativeLibrary_doesUpdateMatchProgram(JNIEnv* env, jobject jobj,
@@ -30,6 +30,8 @@ void AudioRenderer::Start() {
 
     mailbox.Initialize(AppMailboxId::AudioRenderer);
 
+    session_workers = std::make_unique<Common::ThreadWorker>(MaxRendererSessions - 1,
+                                                             "DSP_AudioRenderer_Session");
     main_thread = std::jthread([this](std::stop_token stop_token) { Main(stop_token); });
 
     mailbox.Send(Direction::DSP, Message::InitializeOK);
@@ -53,10 +55,18 @@ void AudioRenderer::Stop() {
     }
     main_thread.request_stop();
     main_thread.join();
+    session_workers.reset();
 
-    for (auto& stream : streams) {
+    for (u32 index = 0; index < MaxRendererSessions; index++) {
+        auto& stream{streams[index]};
         if (stream) {
             stream->Stop();
+            const auto statistics{stream->GetStatistics()};
+            LOG_INFO(Audio_Sink,
+                     "Render stream {} closed after {} underruns and {} dropped frames, target "
+                     "queue size {}",
+                     index, statistics.underruns, statistics.dropped_frames,
+                     statistics.target_queue_size);
             sink.CloseStream(stream);
             stream = nullptr;
         }
@@ -99,6 +109,23 @@ void AudioRenderer::SetCommandBuffer(s32 session_id, CpuAddr buffer, u64 size, u
     command_buffers[session_id].reset_buffer = reset;
 }
 
+u64 AudioRenderer::ProcessSession(u32 index, u64 start_time) {
+    auto& command_buffer{command_buffers[index]};
+    auto& command_list_processor{command_list_processors[index]};
+
+    u64 render_time_taken{};
+    {
+        MICROPROFILE_SCOPE(Audio_Renderer);
+        render_time_taken = command_list_processor.Process(index) - start_time;
+    }
+
+    const auto end_time{system.CoreTiming().GetGlobalTimeUs().count()};
+
+    command_buffer.remaining_command_count = command_list_processor.GetRemainingCommandCount();
+    command_buffer.render_time_taken_us = end_time - start_time;
+    return render_time_taken;
+}
+
 void AudioRenderer::PostDSPClearCommandBuffer() noexcept {
     for (auto& buffer : command_buffers) {
         buffer.buffer = 0;
@@ -166,54 +193,78 @@ void AudioRenderer::Main(std::stop_token stop_token) {
             std::array<u64, MaxRendererSessions> render_times_taken{};
             const auto start_time{system.CoreTiming().GetGlobalTimeUs().count()};
 
+            // The second session shares the time budget of the first when both belong to the
+            // same applet, so it has to wait for the first to be rendered.
+            const auto shares_budget = [this](u32 index) {
+                return index == 1 && command_buffers[0].buffer != 0 &&
+                       command_buffers[index].applet_resource_user_id ==
+                           command_buffers[0].applet_resource_user_id;
+            };
+
             for (u32 index = 0; index < MaxRendererSessions; index++) {
                 auto& command_buffer{command_buffers[index]};
                 auto& command_list_processor{command_list_processors[index]};
 
                 // Check this buffer is valid, as it may not be used.
-                if (command_buffer.buffer != 0) {
-                    // If there are no remaining commands (from the previous list),
-                    // this is a new command list, initialize it.
-                    if (command_buffer.remaining_command_count == 0) {
-                        command_list_processor.Initialize(system, *command_buffer.process,
-                                                          command_buffer.buffer,
-                                                          command_buffer.size, streams[index]);
-                    }
-
-                    if (command_buffer.reset_buffer && !buffers_reset[index]) {
-                        streams[index]->ClearQueue();
-                        buffers_reset[index] = true;
-                    }
-
-                    u64 max_time{max_process_time};
-                    if (index == 1 && command_buffer.applet_resource_user_id ==
-                                          command_buffers[0].applet_resource_user_id) {
-                        max_time = max_process_time - render_times_taken[0];
-                        if (render_times_taken[0] > max_process_time) {
-                            max_time = 0;
-                        }
-                    }
-
-                    max_time = std::min(command_buffer.time_limit, max_time);
-                    command_list_processor.SetProcessTimeMax(max_time);
-
-                    if (index == 0) {
-                        streams[index]->WaitFreeSpace(stop_token);
-                    }
-
-                    // Process the command list
-                    {
-                        MICROPROFILE_SCOPE(Audio_Renderer);
-                        render_times_taken[index] =
-                            command_list_processor.Process(index) - start_time;
-                    }
-
-                    const auto end_time{system.CoreTiming().GetGlobalTimeUs().count()};
-
-                    command_buffer.remaining_command_count =
-                        command_list_processor.GetRemainingCommandCount();
-                    command_buffer.render_time_taken_us = end_time - start_time;
+                if (command_buffer.buffer == 0) {
+                    continue;
+                }
+
+                // If there are no remaining commands (from the previous list),
+                // this is a new command list, initialize it.
+                if (command_buffer.remaining_command_count == 0) {
+                    command_list_processor.Initialize(system, *command_buffer.process,
+                                                      command_buffer.buffer, command_buffer.size,
+                                                      streams[index]);
+                }
+
+                if (command_buffer.reset_buffer && !buffers_reset[index]) {
+                    streams[index]->ClearQueue();
+                    buffers_reset[index] = true;
+                }
+
+                if (!shares_budget(index)) {
+                    command_list_processor.SetProcessTimeMax(
+                        std::min(command_buffer.time_limit, max_process_time));
+                }
+            }
+
+            if (command_buffers[0].buffer != 0) {
+                streams[0]->WaitFreeSpace(stop_token);
+            }
+
+            // Sessions render into their own mix buffers and streams, so the independent ones
+            // are processed on the workers while the first is processed here.
+            bool queued_sessions{};
+            for (u32 index = 1; index < MaxRendererSessions; index++) {
+                if (command_buffers[index].buffer != 0 && !shares_budget(index)) {
+                    session_workers->QueueWork(
+                        [this, index, start_time] { ProcessSession(index, start_time); });
+                    queued_sessions = true;
+                }
+            }
+
+            if (command_buffers[0].buffer != 0) {
+                render_times_taken[0] = ProcessSession(0, start_time);
+            }
+
+            for (u32 index = 1; index < MaxRendererSessions; index++) {
+                if (command_buffers[index].buffer == 0 || !shares_budget(index)) {
+                    continue;
+                }
+
+                u64 max_time{max_process_time - render_times_taken[0]};
+                if (render_times_taken[0] > max_process_time) {
+                    max_time = 0;
                 }
+                max_time = std::min(command_buffers[index].time_limit, max_time);
+                command_list_processors[index].SetProcessTimeMax(max_time);
+
+                render_times_taken[index] = ProcessSession(index, start_time);
+            }
+
+            if (queued_sessions) {
+                session_workers->WaitForRequests(stop_token);
             }
 
             mailbox.Send(Direction::Host, Message::RenderResponse);
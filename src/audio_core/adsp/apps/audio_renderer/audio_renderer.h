@@ -14,6 +14,7 @@
 #include "common/polyfill_thread.h"
 #include "common/reader_writer_queue.h"
 #include "common/thread.h"
+#include "common/thread_worker.h"
 
 namespace Core {
 class System;
@@ -90,6 +91,15 @@ private:
      */
     void CreateSinkStreams();
 
+    /**
+     * Process the command list of a session, and record the results in its command buffer.
+     *
+     * @param index      - Session to process.
+     * @param start_time - Time the render was started, in microseconds.
+     * @return The time taken to process, relative to start_time.
+     */
+    u64 ProcessSession(u32 index, u64 start_time);
+
     void PostDSPClearCommandBuffer() noexcept;
 
     /// Core system
@@ -100,6 +110,8 @@ private:
     Mailbox mailbox;
     /// Main thread
     std::jthread main_thread{};
+    /// Workers processing the sessions which are independent of the first in parallel with it
+    std::unique_ptr<Common::ThreadWorker> session_workers{};
     /// The current state
     std::atomic<bool> running{};
     /// Shared memory of input command buffers, set by host, read by DSP
@@ -34,6 +34,56 @@ bool IsValidMultiStreamStreamCounts(s32 total_stream_count, s32 stereo_stream_co
     return IsValidMultiStreamChannelCount(total_stream_count) && total_stream_count > 0 &&
            stereo_stream_count >= 0 && stereo_stream_count <= total_stream_count;
 }
+
+template <typename DecodeObject>
+void DecodePacket(Core::System& system, DecodeRequest& request) {
+    MICROPROFILE_SCOPE(OpusDecoder);
+    auto start_time = system.CoreTiming().GetGlobalTimeUs();
+
+    u32 decoded_samples{0};
+
+    auto& decoder_object = DecodeObject::Initialize(request.buffer, request.buffer);
+    s32 error_code{OPUS_OK};
+    if (request.reset) {
+        error_code = decoder_object.ResetDecoder();
+    }
+
+    if (error_code == OPUS_OK) {
+        error_code =
+            decoder_object.Decode(decoded_samples, request.output_data, request.output_data_size,
+                                  request.input_data, request.input_data_size);
+    }
+
+    if (error_code == OPUS_OK) {
+        if (request.final_range && decoder_object.GetFinalRange() != request.final_range) {
+            error_code = OPUS_INVALID_PACKET;
+        }
+    }
+
+    auto end_time = system.CoreTiming().GetGlobalTimeUs();
+    request.error_code = error_code;
+    request.decoded_samples = decoded_samples;
+    request.time_taken = (end_time - start_time).count();
+}
+
+DecodeRequest ReadDecodeRequest(const SharedMemory& shared_memory, bool multi_stream) {
+    return {
+        .buffer = shared_memory.host_send_data[0],
+        .input_data = shared_memory.host_send_data[1],
+        .input_data_size = shared_memory.host_send_data[2],
+        .output_data = shared_memory.host_send_data[3],
+        .output_data_size = shared_memory.host_send_data[4],
+        .final_range = static_cast<u32>(shared_memory.host_send_data[5]),
+        .reset = shared_memory.host_send_data[6] != 0,
+        .multi_stream = multi_stream,
+    };
+}
+
+void WriteDecodeResult(SharedMemory& shared_memory, const DecodeRequest& request) {
+    shared_memory.dsp_return_data[0] = request.error_code;
+    shared_memory.dsp_return_data[1] = request.decoded_samples;
+    shared_memory.dsp_return_data[2] = request.time_taken;
+}
 } // namespace
 
 OpusDecoder::OpusDecoder(Core::System& system_) : system{system_} {
@@ -64,6 +114,16 @@ u32 OpusDecoder::Receive(Direction dir, std::stop_token stop_token) {
     return mailbox.Receive(dir, stop_token);
 }
 
+void OpusDecoder::Decode(DecodeRequest& request) {
+    // The hwopus service has several threads of its own, which already decode separate streams
+    // concurrently, so handing the packet to another thread would only add a wait.
+    if (request.multi_stream) {
+        DecodePacket<OpusMultiStreamDecodeObject>(system, request);
+    } else {
+        DecodePacket<OpusDecodeObject>(system, request);
+    }
+}
+
 void OpusDecoder::Init(std::stop_token stop_token) {
     Common::SetCurrentThreadName("DSP_OpusDecoder_Init");
 
@@ -124,39 +184,9 @@ void OpusDecoder::Main(std::stop_token stop_token) {
         } break;
 
         case DecodeInterleaved: {
-            auto start_time = system.CoreTiming().GetGlobalTimeUs();
-
-            auto buffer = shared_memory->host_send_data[0];
-            auto input_data = shared_memory->host_send_data[1];
-            auto input_data_size = shared_memory->host_send_data[2];
-            auto output_data = shared_memory->host_send_data[3];
-            auto output_data_size = shared_memory->host_send_data[4];
-            auto final_range = static_cast<u32>(shared_memory->host_send_data[5]);
-            auto reset_requested = shared_memory->host_send_data[6];
-
-            u32 decoded_samples{0};
-
-            auto& decoder_object = OpusDecodeObject::Initialize(buffer, buffer);
-            s32 error_code{OPUS_OK};
-            if (reset_requested) {
-                error_code = decoder_object.ResetDecoder();
-            }
-
-            if (error_code == OPUS_OK) {
-                error_code = decoder_object.Decode(decoded_samples, output_data, output_data_size,
-                                                   input_data, input_data_size);
-            }
-
-            if (error_code == OPUS_OK) {
-                if (final_range && decoder_object.GetFinalRange() != final_range) {
-                    error_code = OPUS_INVALID_PACKET;
-                }
-            }
-
-            auto end_time = system.CoreTiming().GetGlobalTimeUs();
-            shared_memory->dsp_return_data[0] = error_code;
-            shared_memory->dsp_return_data[1] = decoded_samples;
-            shared_memory->dsp_return_data[2] = (end_time - start_time).count();
+            auto request = ReadDecodeRequest(*shared_memory, false);
+            DecodePacket<OpusDecodeObject>(system, request);
+            WriteDecodeResult(*shared_memory, request);
 
             Send(Direction::Host, Message::DecodeInterleavedOK);
         } break;
@@ -222,39 +252,9 @@ void OpusDecoder::Main(std::stop_token stop_token) {
         } break;
 
         case DecodeInterleavedForMultiStream: {
-            auto start_time = system.CoreTiming().GetGlobalTimeUs();
-
-            auto buffer = shared_memory->host_send_data[0];
-            auto input_data = shared_memory->host_send_data[1];
-            auto input_data_size = shared_memory->host_send_data[2];
-            auto output_data = shared_memory->host_send_data[3];
-            auto output_data_size = shared_memory->host_send_data[4];
-            auto final_range = static_cast<u32>(shared_memory->host_send_data[5]);
-            auto reset_requested = shared_memory->host_send_data[6];
-
-            u32 decoded_samples{0};
-
-            auto& decoder_object = OpusMultiStreamDecodeObject::Initialize(buffer, buffer);
-            s32 error_code{OPUS_OK};
-            if (reset_requested) {
-                error_code = decoder_object.ResetDecoder();
-            }
-
-            if (error_code == OPUS_OK) {
-                error_code = decoder_object.Decode(decoded_samples, output_data, output_data_size,
-                                                   input_data, input_data_size);
-            }
-
-            if (error_code == OPUS_OK) {
-                if (final_range && decoder_object.GetFinalRange() != final_range) {
-                    error_code = OPUS_INVALID_PACKET;
-                }
-            }
-
-            auto end_time = system.CoreTiming().GetGlobalTimeUs();
-            shared_memory->dsp_return_data[0] = error_code;
-            shared_memory->dsp_return_data[1] = decoded_samples;
-            shared_memory->dsp_return_data[2] = (end_time - start_time).count();
+            auto request = ReadDecodeRequest(*shared_memory, true);
+            DecodePacket<OpusMultiStreamDecodeObject>(system, request);
+            WriteDecodeResult(*shared_memory, request);
 
             Send(Direction::Host, Message::DecodeInterleavedForMultiStreamOK);
         } break;
@@ -46,7 +46,29 @@ enum Message : u32 {
 };
 
 /**
- * The AudioRenderer application running on the ADSP.
+ * A packet to decode, submitted straight to the OpusDecoder rather than through the mailbox, so
+ * that several streams can be decoded at once.
+ */
+struct DecodeRequest {
+    // Input, set by the host.
+    u64 buffer;
+    u64 input_data;
+    u64 input_data_size;
+    u64 output_data;
+    u64 output_data_size;
+    u32 final_range;
+    bool reset;
+    bool multi_stream;
+
+    // Output, set by the OpusDecoder once the packet is decoded.
+    s32 error_code;
+    u32 decoded_samples;
+    /// Time taken to decode the packet, in microseconds.
+    u64 time_taken;
+};
+
+/**
+ * The OpusDecoder application running on the ADSP.
  */
 class OpusDecoder {
 public:
@@ -64,6 +86,14 @@ public:
         shared_memory = &shared_memory_;
     }
 
+    /**
+     * Decode a packet on the calling thread. Requests for different decode objects may be made
+     * from several threads at once.
+     *
+     * @param request - The packet to decode, which receives the results.
+     */
+    void Decode(DecodeRequest& request);
+
 private:
     /**
      * Initializing thread, launched at audio_core boot to avoid blocking the main emu boot thread.
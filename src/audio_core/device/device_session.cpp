@@ -6,6 +6,7 @@
 #include "audio_core/device/audio_buffer.h"
 #include "audio_core/device/device_session.h"
 #include "audio_core/sink/sink_stream.h"
+#include "common/logging/log.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/guest_memory.h"
@@ -55,6 +56,14 @@ Result DeviceSession::Initialize(std::string_view name_, SampleFormat sample_for
 void DeviceSession::Finalize() {
     if (initialized) {
         Stop();
+        if (type != Sink::StreamType::In) {
+            const auto statistics{stream->GetStatistics()};
+            LOG_INFO(Audio_Sink,
+                     "Stream {} closed after {} underruns and {} dropped frames, target queue "
+                     "size {}",
+                     name, statistics.underruns, statistics.dropped_frames,
+                     statistics.target_queue_size);
+        }
         sink->CloseStream(stream);
         stream = nullptr;
     }
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "audio_core/opus/decoder.h"
 #include "audio_core/opus/hardware_opus.h"
 #include "audio_core/opus/parameters.h"
@@ -23,8 +25,19 @@ OpusDecoder::OpusDecoder(Core::System& system_, HardwareOpus& hardware_opus_)
     : system{system_}, hardware_opus{hardware_opus_} {}
 
 OpusDecoder::~OpusDecoder() {
-    if (decode_object_initialized) {
-        hardware_opus.ShutdownDecodeObject(shared_buffer.get(), shared_buffer_size);
+    if (statistics.decode_count > 0) {
+        LOG_DEBUG(Service_Audio, "Decoded {} packets, taking {}us on average and {}us at most",
+                  statistics.decode_count, statistics.total_decode_time / statistics.decode_count,
+                  statistics.max_decode_time);
+    }
+
+    // A work buffer still holding a decode object can't be handed to another decoder.
+    if (decode_object_initialized &&
+        R_FAILED(hardware_opus.ShutdownDecodeObject(shared_buffer.get(), shared_buffer_size))) {
+        return;
+    }
+    if (shared_buffer) {
+        hardware_opus.ReleaseWorkBuffer(std::move(shared_buffer), shared_buffer_size);
     }
 }
 
@@ -32,7 +45,7 @@ Result OpusDecoder::Initialize(const OpusParametersEx& params,
                                Kernel::KTransferMemory* transfer_memory, u64 transfer_memory_size) {
     auto frame_size{params.use_large_frame_size ? 5760 : 1920};
     shared_buffer_size = transfer_memory_size;
-    shared_buffer = std::make_unique<u8[]>(shared_buffer_size);
+    shared_buffer = hardware_opus.AcquireWorkBuffer(shared_buffer_size);
     shared_memory_mapped = true;
 
     buffer_size =
@@ -63,7 +76,7 @@ Result OpusDecoder::Initialize(const OpusMultiStreamParametersEx& params,
                                Kernel::KTransferMemory* transfer_memory, u64 transfer_memory_size) {
     auto frame_size{params.use_large_frame_size ? 5760 : 1920};
     shared_buffer_size = transfer_memory_size;
-    shared_buffer = std::make_unique<u8[]>(shared_buffer_size);
+    shared_buffer = hardware_opus.AcquireWorkBuffer(shared_buffer_size);
     shared_memory_mapped = true;
 
     buffer_size =
@@ -121,6 +134,7 @@ Result OpusDecoder::DecodeInterleaved(u32* out_data_size, u64* out_time_taken,
                                           shared_buffer.get(), time_taken, reset));
 
     std::memcpy(output_data.data(), out_data.data(), out_samples * channel_count * sizeof(s16));
+    UpdateStatistics(time_taken / 1000);
 
     *out_data_size = header.size + sizeof(OpusPacketHeader);
     *out_sample_count = out_samples;
@@ -167,6 +181,7 @@ Result OpusDecoder::DecodeInterleavedForMultiStream(u32* out_data_size, u64* out
         header.size, shared_buffer.get(), time_taken, reset));
 
     std::memcpy(output_data.data(), out_data.data(), out_samples * channel_count * sizeof(s16));
+    UpdateStatistics(time_taken / 1000);
 
     *out_data_size = header.size + sizeof(OpusPacketHeader);
     *out_sample_count = out_samples;
@@ -176,4 +191,10 @@ Result OpusDecoder::DecodeInterleavedForMultiStream(u32* out_data_size, u64* out
     R_SUCCEED();
 }
 
+void OpusDecoder::UpdateStatistics(u64 time_taken) {
+    statistics.decode_count++;
+    statistics.total_decode_time += time_taken;
+    statistics.max_decode_time = std::max(statistics.max_decode_time, time_taken);
+}
+
 } // namespace AudioCore::OpusDecoder
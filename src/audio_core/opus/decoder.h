@@ -17,6 +17,15 @@ class System;
 namespace AudioCore::OpusDecoder {
 class HardwareOpus;
 
+struct DecodeStatistics {
+    /// Number of packets decoded
+    u64 decode_count;
+    /// Total time taken to decode the packets, in microseconds
+    u64 total_decode_time;
+    /// Longest time taken to decode a packet, in microseconds
+    u64 max_decode_time;
+};
+
 class OpusDecoder {
 public:
     explicit OpusDecoder(Core::System& system, HardwareOpus& hardware_opus_);
@@ -34,6 +43,8 @@ public:
                                            std::span<u8> output_data, bool reset);
 
 private:
+    void UpdateStatistics(u64 time_taken);
+
     Core::System& system;
     HardwareOpus& hardware_opus;
     std::unique_ptr<u8[]> shared_buffer{};
@@ -48,6 +59,7 @@ private:
     s32 stereo_stream_count{};
     bool shared_memory_mapped{false};
     bool decode_object_initialized{false};
+    DecodeStatistics statistics{};
 };
 
 } // namespace AudioCore::OpusDecoder
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 
 #include "audio_core/audio_core.h"
@@ -11,6 +12,10 @@ namespace AudioCore::OpusDecoder {
 namespace {
 using namespace Service::Audio;
 
+// Games often open a decoder for every sound they play, with the same parameters, so a few work
+// buffers are kept for the next decoders rather than freed.
+constexpr size_t MaxPooledWorkBuffers = 8;
+
 static constexpr Result ResultCodeFromLibOpusErrorCode(u64 error_code) {
     s32 error{static_cast<s32>(error_code)};
     ASSERT(error <= OPUS_OK);
@@ -153,29 +158,8 @@ Result HardwareOpus::DecodeInterleaved(u32& out_sample_count, void* output_data,
                                        u64 output_data_size, u32 channel_count, void* input_data,
                                        u64 input_data_size, void* buffer, u64& out_time_taken,
                                        bool reset) {
-    std::scoped_lock l{mutex};
-    shared_memory.host_send_data[0] = (u64)buffer;
-    shared_memory.host_send_data[1] = (u64)input_data;
-    shared_memory.host_send_data[2] = input_data_size;
-    shared_memory.host_send_data[3] = (u64)output_data;
-    shared_memory.host_send_data[4] = output_data_size;
-    shared_memory.host_send_data[5] = 0;
-    shared_memory.host_send_data[6] = reset;
-
-    opus_decoder.Send(ADSP::Direction::DSP, ADSP::OpusDecoder::Message::DecodeInterleaved);
-    auto msg = opus_decoder.Receive(ADSP::Direction::Host);
-    if (msg != ADSP::OpusDecoder::Message::DecodeInterleavedOK) {
-        LOG_ERROR(Service_Audio, "OpusDecoder returned invalid message. Expected {} got {}",
-                  ADSP::OpusDecoder::Message::DecodeInterleavedOK, msg);
-        R_THROW(ResultInvalidOpusDSPReturnCode);
-    }
-
-    auto error_code{static_cast<s32>(shared_memory.dsp_return_data[0])};
-    if (error_code == OPUS_OK) {
-        out_sample_count = static_cast<u32>(shared_memory.dsp_return_data[1]);
-        out_time_taken = 1000 * shared_memory.dsp_return_data[2];
-    }
-    R_RETURN(ResultCodeFromLibOpusErrorCode(error_code));
+    R_RETURN(Decode(out_sample_count, output_data, output_data_size, input_data, input_data_size,
+                    buffer, out_time_taken, reset, false));
 }
 
 Result HardwareOpus::DecodeInterleavedForMultiStream(u32& out_sample_count, void* output_data,
@@ -183,30 +167,32 @@ Result HardwareOpus::DecodeInterleavedForMultiStream(u32& out_sample_count, void
                                                      void* input_data, u64 input_data_size,
                                                      void* buffer, u64& out_time_taken,
                                                      bool reset) {
-    std::scoped_lock l{mutex};
-    shared_memory.host_send_data[0] = (u64)buffer;
-    shared_memory.host_send_data[1] = (u64)input_data;
-    shared_memory.host_send_data[2] = input_data_size;
-    shared_memory.host_send_data[3] = (u64)output_data;
-    shared_memory.host_send_data[4] = output_data_size;
-    shared_memory.host_send_data[5] = 0;
-    shared_memory.host_send_data[6] = reset;
-
-    opus_decoder.Send(ADSP::Direction::DSP,
-                      ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStream);
-    auto msg = opus_decoder.Receive(ADSP::Direction::Host);
-    if (msg != ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStreamOK) {
-        LOG_ERROR(Service_Audio, "OpusDecoder returned invalid message. Expected {} got {}",
-                  ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStreamOK, msg);
-        R_THROW(ResultInvalidOpusDSPReturnCode);
-    }
+    R_RETURN(Decode(out_sample_count, output_data, output_data_size, input_data, input_data_size,
+                    buffer, out_time_taken, reset, true));
+}
 
-    auto error_code{static_cast<s32>(shared_memory.dsp_return_data[0])};
-    if (error_code == OPUS_OK) {
-        out_sample_count = static_cast<u32>(shared_memory.dsp_return_data[1]);
-        out_time_taken = 1000 * shared_memory.dsp_return_data[2];
+Result HardwareOpus::Decode(u32& out_sample_count, void* output_data, u64 output_data_size,
+                            void* input_data, u64 input_data_size, void* buffer,
+                            u64& out_time_taken, bool reset, bool multi_stream) {
+    // Decodes don't go through the mailbox and shared memory, which would serialize every stream
+    // behind a single request, but are decoded on the calling service thread.
+    ADSP::OpusDecoder::DecodeRequest request{
+        .buffer = (u64)buffer,
+        .input_data = (u64)input_data,
+        .input_data_size = input_data_size,
+        .output_data = (u64)output_data,
+        .output_data_size = output_data_size,
+        .final_range = 0,
+        .reset = reset,
+        .multi_stream = multi_stream,
+    };
+    opus_decoder.Decode(request);
+
+    if (request.error_code == OPUS_OK) {
+        out_sample_count = request.decoded_samples;
+        out_time_taken = 1000 * request.time_taken;
     }
-    R_RETURN(ResultCodeFromLibOpusErrorCode(error_code));
+    R_RETURN(ResultCodeFromLibOpusErrorCode(request.error_code));
 }
 
 Result HardwareOpus::MapMemory(void* buffer, u64 buffer_size) {
@@ -239,4 +225,25 @@ Result HardwareOpus::UnmapMemory(void* buffer, u64 buffer_size) {
     R_SUCCEED();
 }
 
+std::unique_ptr<u8[]> HardwareOpus::AcquireWorkBuffer(u64 buffer_size) {
+    {
+        std::scoped_lock l{work_buffer_mutex};
+        const auto it = std::ranges::find(work_buffers, buffer_size, &PooledWorkBuffer::size);
+        if (it != work_buffers.end()) {
+            auto buffer = std::move(it->buffer);
+            work_buffers.erase(it);
+            return buffer;
+        }
+    }
+    return std::make_unique<u8[]>(buffer_size);
+}
+
+void HardwareOpus::ReleaseWorkBuffer(std::unique_ptr<u8[]> buffer, u64 buffer_size) {
+    std::scoped_lock l{work_buffer_mutex};
+    if (work_buffers.size() >= MaxPooledWorkBuffers) {
+        work_buffers.erase(work_buffers.begin());
+    }
+    work_buffers.push_back({std::move(buffer), buffer_size});
+}
+
 } // namespace AudioCore::OpusDecoder
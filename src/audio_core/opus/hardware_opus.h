@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
+#include <vector>
 #include <opus.h>
 
 #include "audio_core/adsp/apps/opus/opus_decoder.h"
@@ -36,9 +38,36 @@ public:
     Result MapMemory(void* buffer, u64 buffer_size);
     Result UnmapMemory(void* buffer, u64 buffer_size);
 
+    /**
+     * Take a work buffer from those released by previous decoders, or allocate a new one.
+     *
+     * @param buffer_size - Size of the work buffer.
+     * @return The work buffer, with no decode object initialized in it.
+     */
+    std::unique_ptr<u8[]> AcquireWorkBuffer(u64 buffer_size);
+
+    /**
+     * Return a work buffer to be reused by a later decoder, once its decode object is shut down.
+     *
+     * @param buffer      - The work buffer.
+     * @param buffer_size - Size of the work buffer.
+     */
+    void ReleaseWorkBuffer(std::unique_ptr<u8[]> buffer, u64 buffer_size);
+
 private:
+    Result Decode(u32& out_sample_count, void* output_data, u64 output_data_size, void* input_data,
+                  u64 input_data_size, void* buffer, u64& out_time_taken, bool reset,
+                  bool multi_stream);
+
+    struct PooledWorkBuffer {
+        std::unique_ptr<u8[]> buffer;
+        u64 size;
+    };
+
     Core::System& system;
     std::mutex mutex;
+    std::mutex work_buffer_mutex;
+    std::vector<PooledWorkBuffer> work_buffers;
     ADSP::OpusDecoder::OpusDecoder& opus_decoder;
     ADSP::OpusDecoder::SharedMemory shared_memory;
 };
@@ -17,6 +17,19 @@ namespace AudioCore::Renderer {
 constexpr u32 TempBufferSize = 0x3F00;
 constexpr std::array<u8, 3> PitchBySrcQuality = {4, 8, 4};
 
+/**
+ * Get the buffer wave buffer samples are read into when they are not contiguous in host memory,
+ * so that they are otherwise read in place rather than copied.
+ *
+ * @tparam T - Type of the samples.
+ * @return The scratch buffer of the calling thread.
+ */
+template <typename T>
+static Common::ScratchBuffer<T>& GetDecodeScratch() {
+    thread_local Common::ScratchBuffer<T> scratch;
+    return scratch;
+}
+
 /**
  * Decode PCM data. Only s16 or f32 is supported.
  *
@@ -51,7 +64,7 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         const u64 size{channel_count * samples_to_decode};
 
         Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, size);
+            memory, source, size, &GetDecodeScratch<T>());
         if constexpr (std::is_floating_point_v<T>) {
             for (u32 i = 0; i < samples_to_decode; i++) {
                 auto sample{static_cast<s32>(samples[i * channel_count + req.target_channel] *
@@ -74,7 +87,7 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
 
         const VAddr source{req.buffer + ((req.start_offset + req.offset) * sizeof(T))};
         Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, samples_to_decode);
+            memory, source, samples_to_decode, &GetDecodeScratch<T>());
 
         if constexpr (std::is_floating_point_v<T>) {
             for (u32 i = 0; i < samples_to_decode; i++) {
@@ -139,9 +152,14 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         position_in_frame += 2;
     }
 
-    const auto size{std::max((samples_to_process / 8U) * SamplesPerFrame, 8U)};
+    // Read exactly the frames holding the samples to decode, from the first one's header or
+    // nibble to the last sample's nibble.
+    const auto last_sample{start_pos + samples_to_process - 1};
+    const auto last_nibble{(last_sample / SamplesPerFrame) * NibblesPerFrame + 2 +
+                           last_sample % SamplesPerFrame};
+    const auto size{last_nibble / 2 - position_in_frame / 2 + 1};
     Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> wavebuffer(
-        memory, req.buffer + position_in_frame / 2, size);
+        memory, req.buffer + position_in_frame / 2, size, &GetDecodeScratch<u8>());
 
     auto context{req.adpcm_context};
     auto header{context->header};
@@ -270,7 +288,17 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
     u32 offset{voice_state.offset};
 
     auto output_buffer{args.output};
-    std::array<s16, TempBufferSize> temp_buffer{};
+
+    // Only the samples decoded, the zeroes padding them and the sample history are read back, so
+    // the buffer does not need to be cleared.
+    std::array<s16, TempBufferSize> temp_buffer;
+
+    // The coefficients are shared by all of the voice's wave buffers.
+    std::array<s16, 16> adpcm_coefficients{};
+    if (args.sample_format == SampleFormat::Adpcm) {
+        memory.ReadBlockUnsafe(args.data_address, adpcm_coefficients.data(),
+                               std::min<u64>(args.data_size, sizeof(adpcm_coefficients)));
+    }
 
     while (remaining_sample_count > 0) {
         const auto samples_to_write{std::min(remaining_sample_count, max_remaining_sample_count)};
@@ -347,7 +375,7 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
 
             case SampleFormat::Adpcm: {
                 decode_arg.adpcm_context = &voice_state.adpcm_context;
-                memory.ReadBlockUnsafe(args.data_address, &decode_arg.coefficients, args.data_size);
+                decode_arg.coefficients = adpcm_coefficients;
                 samples_decoded = DecodeAdpcm(
                     memory, {&temp_buffer[temp_buffer_pos], TempBufferSize - temp_buffer_pos},
                     decode_arg);
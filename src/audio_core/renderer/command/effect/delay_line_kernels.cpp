@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <limits>
+
+#include "audio_core/renderer/command/effect/delay_line_kernels.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#define DELAY_LINE_KERNELS_X86_64
+#endif
+
+namespace AudioCore::Renderer {
+namespace {
+
+using Fixed = Common::FixedPoint<50, 14>;
+
+constexpr u32 FractionalBits = 14;
+
+template <bool Accumulate>
+void ProcessScalar(s64* output, const Fixed* input, Fixed gain, u32 begin, u32 end) {
+    for (u32 i = begin; i < end; i++) {
+        if constexpr (Accumulate) {
+            output[i] = (Fixed::from_base(output[i]) + input[i] * gain).to_raw();
+        } else {
+            output[i] = (Fixed::from_base(output[i]) * gain).to_raw();
+        }
+    }
+}
+
+#if defined(DELAY_LINE_KERNELS_X86_64)
+
+#ifdef _MSC_VER
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+/*
+ * The vector kernels multiply 64-bit samples by gains which fit in 31 bits, using the unsigned
+ * 32-bit multiplies. Each sample is split into its integer part, multiplied 32 bits at a time and
+ * wrapping around as the 64-bit FixedPoint arithmetic does, and its fraction, whose product is
+ * shifted down on its own. As the gain is positive, the sum is the product rounded down, exactly
+ * as FixedPoint's multiply computes it.
+ */
+
+__m128i MultiplySse2(__m128i samples, __m128i gain, __m128i fractional_mask) {
+    const __m128i integer_low = _mm_srli_epi64(samples, FractionalBits);
+    const __m128i integer_high = _mm_srli_epi64(_mm_srai_epi32(samples, FractionalBits), 32);
+    const __m128i fraction = _mm_and_si128(samples, fractional_mask);
+
+    const __m128i low = _mm_mul_epu32(integer_low, gain);
+    const __m128i high = _mm_slli_epi64(_mm_mul_epu32(integer_high, gain), 32);
+    const __m128i fractional = _mm_srli_epi64(_mm_mul_epu32(fraction, gain), FractionalBits);
+    return _mm_add_epi64(_mm_add_epi64(low, high), fractional);
+}
+
+AVX2_TARGET __m256i MultiplyAvx2(__m256i samples, __m256i gain, __m256i fractional_mask) {
+    const __m256i integer_low = _mm256_srli_epi64(samples, FractionalBits);
+    const __m256i integer_high =
+        _mm256_srli_epi64(_mm256_srai_epi32(samples, FractionalBits), 32);
+    const __m256i fraction = _mm256_and_si256(samples, fractional_mask);
+
+    const __m256i low = _mm256_mul_epu32(integer_low, gain);
+    const __m256i high = _mm256_slli_epi64(_mm256_mul_epu32(integer_high, gain), 32);
+    const __m256i fractional =
+        _mm256_srli_epi64(_mm256_mul_epu32(fraction, gain), FractionalBits);
+    return _mm256_add_epi64(_mm256_add_epi64(low, high), fractional);
+}
+
+template <bool Accumulate>
+u32 ProcessSse2(s64* output, const Fixed* input, Fixed gain, u32 sample_count) {
+    constexpr u32 Lanes = 2;
+    const __m128i gains = _mm_set1_epi64x(gain.to_raw());
+    const __m128i fractional_mask = _mm_set1_epi64x((s64{1} << FractionalBits) - 1);
+
+    u32 i = 0;
+    for (; i + Lanes <= sample_count; i += Lanes) {
+        auto* out = reinterpret_cast<__m128i*>(output + i);
+        if constexpr (Accumulate) {
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            _mm_storeu_si128(out, _mm_add_epi64(_mm_loadu_si128(out),
+                                                MultiplySse2(in, gains, fractional_mask)));
+        } else {
+            _mm_storeu_si128(out, MultiplySse2(_mm_loadu_si128(out), gains, fractional_mask));
+        }
+    }
+    return i;
+}
+
+template <bool Accumulate>
+AVX2_TARGET u32 ProcessAvx2(s64* output, const Fixed* input, Fixed gain, u32 sample_count) {
+    constexpr u32 Lanes = 4;
+    const __m256i gains = _mm256_set1_epi64x(gain.to_raw());
+    const __m256i fractional_mask = _mm256_set1_epi64x((s64{1} << FractionalBits) - 1);
+
+    u32 i = 0;
+    for (; i + Lanes <= sample_count; i += Lanes) {
+        auto* out = reinterpret_cast<__m256i*>(output + i);
+        if constexpr (Accumulate) {
+            const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            _mm256_storeu_si256(out, _mm256_add_epi64(_mm256_loadu_si256(out),
+                                                      MultiplyAvx2(in, gains, fractional_mask)));
+        } else {
+            _mm256_storeu_si256(out,
+                                MultiplyAvx2(_mm256_loadu_si256(out), gains, fractional_mask));
+        }
+    }
+    return i;
+}
+
+#endif
+
+template <bool Accumulate>
+void Process(s64* output, const Fixed* input, Fixed gain, u32 sample_count) {
+    u32 processed = 0;
+#if defined(DELAY_LINE_KERNELS_X86_64)
+    if (gain.to_raw() >= 0 && gain.to_raw() <= std::numeric_limits<s32>::max()) {
+        if (Common::GetCPUCaps().avx2) {
+            processed = ProcessAvx2<Accumulate>(output, input, gain, sample_count);
+        } else {
+            processed = ProcessSse2<Accumulate>(output, input, gain, sample_count);
+        }
+    }
+#endif
+    ProcessScalar<Accumulate>(output, input, gain, processed, sample_count);
+}
+
+} // Anonymous namespace
+
+void AccumulateTap(std::span<s64> output, std::span<const Fixed> buffer, u32 position,
+                   Fixed gain) {
+    u32 processed = 0;
+    while (processed < output.size()) {
+        const auto count = std::min(static_cast<u32>(output.size()) - processed,
+                                    static_cast<u32>(buffer.size()) - position);
+        Process<true>(output.data() + processed, buffer.data() + position, gain, count);
+        processed += count;
+        position = 0;
+    }
+}
+
+void ApplyGain(std::span<s64> samples, Fixed gain) {
+    Process<false>(samples.data(), nullptr, gain, static_cast<u32>(samples.size()));
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+#include "common/fixed_point.h"
+
+namespace AudioCore::Renderer {
+
+/*
+ * Sample kernels shared by the reverb effects, vectorised with SSE2 or AVX2 when the host supports
+ * them. Samples are the raw values of a Common::FixedPoint<50, 14>, and the output is exactly that
+ * of the equivalent FixedPoint arithmetic.
+ */
+
+/**
+ * Read consecutive samples from a delay line, wrapping around its end, apply gain to them and add
+ * them to output.
+ *
+ * @param output   - Raw fixed point samples to add to, one for each sample read.
+ * @param buffer   - Delay line samples, sized to the length the delay line wraps at.
+ * @param position - Index within buffer of the first sample to read.
+ * @param gain     - Gain to apply to the samples read.
+ */
+void AccumulateTap(std::span<s64> output, std::span<const Common::FixedPoint<50, 14>> buffer,
+                   u32 position, Common::FixedPoint<50, 14> gain);
+
+/**
+ * Apply gain to samples in place.
+ *
+ * @param samples - Raw fixed point samples to scale.
+ * @param gain    - Gain to apply.
+ */
+void ApplyGain(std::span<s64> samples, Common::FixedPoint<50, 14> gain);
+
+} // namespace AudioCore::Renderer
@@ -4,6 +4,7 @@
 #include <numbers>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/effect/delay_line_kernels.h"
 #include "audio_core/renderer/command/effect/i3dl2_reverb.h"
 #include "common/polyfill_ranges.h"
 
@@ -48,11 +49,14 @@ constexpr std::array<f32, I3dl2ReverbInfo::MaxDelayTaps> EarlyTapTimes{
     0.85166400671f,
 };
 
-constexpr std::array<f32, I3dl2ReverbInfo::MaxDelayTaps> EarlyGains{
+constexpr std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayTaps> EarlyGains{
     0.67096f, 0.61027f, 1.0f,     0.3568f,  0.68361f, 0.65978f, 0.51939f,
     0.24712f, 0.45945f, 0.45021f, 0.64196f, 0.54879f, 0.92925f, 0.3827f,
     0.72867f, 0.69794f, 0.5464f,  0.24563f, 0.45214f, 0.44042f};
 
+/// Maximum number of samples whose early reflections are computed together.
+constexpr u32 EarlyBlockSize = 64;
+
 /**
  * Update the I3dl2ReverbInfo state according to the given parameters.
  *
@@ -207,23 +211,27 @@ static void ApplyI3dl2ReverbEffectBypass(std::span<std::span<const s32>> inputs,
  * Tick the delay lines, reading and returning their current output, and writing a new decaying
  * sample (mix).
  *
- * @param decay0 - The first decay line.
- * @param decay1 - The second decay line.
- * @param fdn    - Feedback delay network.
- * @param mix    - The new calculated sample to be written and decayed.
+ * @param decay0      - The first decay line.
+ * @param decay1      - The second decay line.
+ * @param fdn         - Feedback delay network.
+ * @param decay0_gain - Wet gain of the first decay line, converted to fixed point.
+ * @param decay1_gain - Wet gain of the second decay line, converted to fixed point.
+ * @param mix         - The new calculated sample to be written and decayed.
  * @return The next delayed and decayed sample.
  */
 static Common::FixedPoint<50, 14> Axfx2AllPassTick(I3dl2ReverbInfo::I3dl2DelayLine& decay0,
                                                    I3dl2ReverbInfo::I3dl2DelayLine& decay1,
                                                    I3dl2ReverbInfo::I3dl2DelayLine& fdn,
+                                                   const Common::FixedPoint<50, 14> decay0_gain,
+                                                   const Common::FixedPoint<50, 14> decay1_gain,
                                                    const Common::FixedPoint<50, 14> mix) {
     auto val{decay0.Read()};
-    auto mixed{mix - (val * decay0.wet_gain)};
-    auto out{decay0.Tick(mixed) + (mixed * decay0.wet_gain)};
+    auto mixed{mix - (val * decay0_gain)};
+    auto out{decay0.Tick(mixed) + (mixed * decay0_gain)};
 
     val = decay1.Read();
-    mixed = out - (val * decay1.wet_gain);
-    out = decay1.Tick(mixed) + (mixed * decay1.wet_gain);
+    mixed = out - (val * decay1_gain);
+    out = decay1.Tick(mixed) + (mixed * decay1_gain);
 
     fdn.Tick(out);
     return out;
@@ -268,89 +276,143 @@ static void ApplyI3dl2ReverbEffect(I3dl2ReverbInfo::State& state,
         tap_indexes = OutTapIndexes6Ch;
     }
 
-    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
-        Common::FixedPoint<50, 14> early_to_late_tap{
-            state.early_delay_line.TapOut(state.early_to_late_taps)};
-        std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
+    // The float gains are converted to fixed point once, rather than for every sample.
+    using Fixed = Common::FixedPoint<50, 14>;
+    constexpr Fixed CenterGain{0.5f};
+    const Fixed early_gain{state.early_gain};
+    const Fixed late_gain{state.late_gain};
+    const Fixed lowpass_2{state.lowpass_2};
+    std::array<std::array<Fixed, 3>, I3dl2ReverbInfo::MaxDelayLines> lowpass_coeff{};
+    std::array<Fixed, I3dl2ReverbInfo::MaxDelayLines> decay0_gains{};
+    std::array<Fixed, I3dl2ReverbInfo::MaxDelayLines> decay1_gains{};
+    for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+        for (u32 i = 0; i < lowpass_coeff[delay_line].size(); i++) {
+            lowpass_coeff[delay_line][i] = state.lowpass_coeff[delay_line][i];
+        }
+        decay0_gains[delay_line] = state.decay_delay_lines0[delay_line].wet_gain;
+        decay1_gains[delay_line] = state.decay_delay_lines1[delay_line].wet_gain;
+    }
 
+    // Every early tap reads a sample written at least one sample earlier, so the early reflections
+    // of a block no longer than the shortest tap only read samples written before the block, and
+    // are computed a tap at a time before the block is processed. Blocks also end where the input
+    // of the delay line wraps around, as TapOut wraps its reads one sample further than that.
+    auto& early_delay_line{state.early_delay_line};
+    const std::span<const Fixed> early_buffer{early_delay_line.buffer.data(),
+                                              static_cast<size_t>(early_delay_line.max_delay) + 1};
+    const auto max_block_size{std::min(
+        EarlyBlockSize, static_cast<u32>(std::ranges::min(state.early_tap_steps)) + 1)};
+
+    for (u32 block_start = 0; block_start < sample_count;) {
+        const auto input_index{
+            static_cast<s32>(early_delay_line.input - early_delay_line.buffer.data())};
+        const auto input_remaining{std::max(early_delay_line.max_delay - input_index, 1)};
+        const auto block_size{std::min(
+            {max_block_size, sample_count - block_start, static_cast<u32>(input_remaining)})};
+
+        std::array<std::array<s64, EarlyBlockSize>, NumChannels> early_samples{};
         for (u32 early_tap = 0; early_tap < I3dl2ReverbInfo::MaxDelayTaps; early_tap++) {
-            output_samples[tap_indexes[early_tap]] +=
-                state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
-                EarlyGains[early_tap];
-            if constexpr (NumChannels == 6) {
-                output_samples[static_cast<u32>(Channels::LFE)] +=
-                    state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
-                    EarlyGains[early_tap];
+            auto position{input_index - (state.early_tap_steps[early_tap] + 1)};
+            if (position < 0) {
+                position += static_cast<s32>(early_buffer.size());
             }
+            AccumulateTap(std::span(early_samples[tap_indexes[early_tap]]).first(block_size),
+                          early_buffer, static_cast<u32>(position), EarlyGains[early_tap]);
         }
 
-        Common::FixedPoint<50, 14> current_sample{};
-        for (u32 channel = 0; channel < NumChannels; channel++) {
-            current_sample += inputs[channel][sample_index];
+        // No tap is output to the LFE channel directly, it receives all of them.
+        if constexpr (NumChannels == 6) {
+            auto& lfe_samples{early_samples[static_cast<u32>(Channels::LFE)]};
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                if (channel == static_cast<u32>(Channels::LFE)) {
+                    continue;
+                }
+                for (u32 i = 0; i < block_size; i++) {
+                    lfe_samples[i] += early_samples[channel][i];
+                }
+            }
         }
 
-        state.lowpass_0 =
-            (current_sample * state.lowpass_2 + state.lowpass_0 * state.lowpass_1).to_float();
-        state.early_delay_line.Tick(state.lowpass_0);
-
         for (u32 channel = 0; channel < NumChannels; channel++) {
-            output_samples[channel] *= state.early_gain;
+            ApplyGain(std::span(early_samples[channel]).first(block_size), early_gain);
         }
 
-        std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> filtered_samples{};
-        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
-            filtered_samples[delay_line] =
-                state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][0] +
-                state.shelf_filter[delay_line];
-            state.shelf_filter[delay_line] =
-                (filtered_samples[delay_line] * state.lowpass_coeff[delay_line][2] +
-                 state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][1])
-                    .to_float();
-        }
-
-        const std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> mix_matrix{
-            filtered_samples[1] + filtered_samples[2] + early_to_late_tap * state.late_gain,
-            -filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
-            filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
-            filtered_samples[1] - filtered_samples[2] + early_to_late_tap * state.late_gain,
-        };
-
-        std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> allpass_samples{};
-        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
-            allpass_samples[delay_line] = Axfx2AllPassTick(
-                state.decay_delay_lines0[delay_line], state.decay_delay_lines1[delay_line],
-                state.fdn_delay_lines[delay_line], mix_matrix[delay_line]);
-        }
-
-        if constexpr (NumChannels == 6) {
-            const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
-                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
-                allpass_samples[3], allpass_samples[2], allpass_samples[3],
-            };
+        for (u32 i = 0; i < block_size; i++) {
+            const auto sample_index{block_start + i};
+            const Fixed late_sample{early_delay_line.TapOut(state.early_to_late_taps) *
+                                    late_gain};
 
+            Fixed current_sample{};
             for (u32 channel = 0; channel < NumChannels; channel++) {
-                Common::FixedPoint<50, 14> allpass{};
+                current_sample += inputs[channel][sample_index];
+            }
 
-                if (channel == static_cast<u32>(Channels::Center)) {
-                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
-                } else {
-                    allpass = allpass_outputs[channel];
-                }
+            state.lowpass_0 =
+                (current_sample * lowpass_2 + state.lowpass_0 * state.lowpass_1).to_float();
+            early_delay_line.Tick(state.lowpass_0);
+
+            std::array<Fixed, I3dl2ReverbInfo::MaxDelayLines> filtered_samples{};
+            for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+                const auto fdn_sample{state.fdn_delay_lines[delay_line].Read()};
+                filtered_samples[delay_line] =
+                    fdn_sample * lowpass_coeff[delay_line][0] + state.shelf_filter[delay_line];
+                state.shelf_filter[delay_line] =
+                    (filtered_samples[delay_line] * lowpass_coeff[delay_line][2] +
+                     fdn_sample * lowpass_coeff[delay_line][1])
+                        .to_float();
+            }
 
-                auto out_sample{output_samples[channel] + allpass +
-                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
+            const std::array<Fixed, I3dl2ReverbInfo::MaxDelayLines> mix_matrix{
+                filtered_samples[1] + filtered_samples[2] + late_sample,
+                -filtered_samples[0] - filtered_samples[3] + late_sample,
+                filtered_samples[0] - filtered_samples[3] + late_sample,
+                filtered_samples[1] - filtered_samples[2] + late_sample,
+            };
 
-                outputs[channel][sample_index] =
-                    static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+            std::array<Fixed, I3dl2ReverbInfo::MaxDelayLines> allpass_samples{};
+            for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+                allpass_samples[delay_line] = Axfx2AllPassTick(
+                    state.decay_delay_lines0[delay_line], state.decay_delay_lines1[delay_line],
+                    state.fdn_delay_lines[delay_line], decay0_gains[delay_line],
+                    decay1_gains[delay_line], mix_matrix[delay_line]);
             }
-        } else {
-            for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto out_sample{output_samples[channel] + allpass_samples[channel] +
-                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
-                outputs[channel][sample_index] =
-                    static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+
+            if constexpr (NumChannels == 6) {
+                const std::array<Fixed, MaxChannels> allpass_outputs{
+                    allpass_samples[0], allpass_samples[1],
+                    allpass_samples[2] - allpass_samples[3], allpass_samples[3],
+                    allpass_samples[2], allpass_samples[3],
+                };
+
+                for (u32 channel = 0; channel < NumChannels; channel++) {
+                    Fixed allpass{};
+
+                    if (channel == static_cast<u32>(Channels::Center)) {
+                        allpass =
+                            state.center_delay_line.Tick(allpass_outputs[channel] * CenterGain);
+                    } else {
+                        allpass = allpass_outputs[channel];
+                    }
+
+                    auto out_sample{
+                        Fixed::from_base(early_samples[channel][i]) + allpass +
+                        state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
+
+                    outputs[channel][sample_index] = static_cast<s32>(
+                        std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+                }
+            } else {
+                for (u32 channel = 0; channel < NumChannels; channel++) {
+                    auto out_sample{
+                        Fixed::from_base(early_samples[channel][i]) + allpass_samples[channel] +
+                        state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
+                    outputs[channel][sample_index] = static_cast<s32>(
+                        std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+                }
             }
         }
+
+        block_start += block_size;
     }
 }
 
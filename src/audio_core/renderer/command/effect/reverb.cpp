@@ -5,6 +5,7 @@
 #include <ranges>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/effect/delay_line_kernels.h"
 #include "audio_core/renderer/command/effect/reverb.h"
 #include "common/polyfill_ranges.h"
 
@@ -70,6 +71,9 @@ constexpr std::array<std::array<f32, ReverbInfo::MaxDelayLines>, ReverbInfo::Num
         {7.000000f, 9.000000f, 13.000000f, 17.000000f},
     }};
 
+/// Maximum number of samples whose early reflections are computed together.
+constexpr u32 EarlyBlockSize = 64;
+
 /**
  * Update the ReverbInfo state according to the given parameters.
  *
@@ -85,9 +89,6 @@ static void UpdateReverbEffectParameter(const ReverbInfo::ParameterVersion2& par
         return std::cos(degrees * std::numbers::pi_v<f32> / 180.0f);
     };
 
-    static bool unk_initialized{false};
-    static Common::FixedPoint<50, 14> unk_value{};
-
     const auto sample_rate{Common::FixedPoint<50, 14>::from_base(params.sample_rate)};
     const auto pre_delay_time{Common::FixedPoint<50, 14>::from_base(params.pre_delay)};
 
@@ -109,10 +110,8 @@ static void UpdateReverbEffectParameter(const ReverbInfo::ParameterVersion2& par
         ((pre_delay_time + EarlyDelayTimes[params.early_mode][10]) * sample_rate).to_int()};
     state.pre_delay_time = std::min(pre_time, state.pre_delay_line.sample_count_max);
 
-    if (!unk_initialized) {
-        unk_value = cos((1280.0f / sample_rate).to_float());
-        unk_initialized = true;
-    }
+    // Initialized once, by the first update, which may run on any of the session workers.
+    static const Common::FixedPoint<50, 14> unk_value{cos((1280.0f / sample_rate).to_float())};
 
     for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
         const auto fdn_delay{(FdnDelayTimes[params.late_mode][i] * sample_rate).to_int()};
@@ -276,84 +275,125 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         tap_indexes = OutTapIndexes6Ch;
     }
 
-    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
-        std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
-
+    using Fixed = Common::FixedPoint<50, 14>;
+    constexpr Fixed LfeGain{0.2f};
+    constexpr Fixed CenterGain{0.5f};
+    const auto base_gain{Fixed::from_base(params.base_gain)};
+    const auto late_gain{Fixed::from_base(params.late_gain)};
+    const auto dry_gain{Fixed::from_base(params.dry_gain)};
+    const auto wet_gain{Fixed::from_base(params.wet_gain)};
+
+    // Dividing by 64 as FixedPoint does needs a 128-bit division, while the raw value is divided
+    // by it directly with the same result, truncated towards zero.
+    const auto divide_by_64 = [](Fixed sample) { return Fixed::from_base(sample.to_raw() / 64); };
+
+    // Every early tap reads a sample written at least one sample earlier, so the early reflections
+    // of a block no longer than the shortest tap only read samples written before the block, and
+    // are computed a tap at a time before the block is processed.
+    auto& pre_delay_line{state.pre_delay_line};
+    const std::span<const Fixed> pre_delay_buffer{pre_delay_line.buffer.data(),
+                                                  static_cast<size_t>(pre_delay_line.sample_count)};
+    const auto max_block_size{std::min(
+        EarlyBlockSize, static_cast<u32>(std::ranges::min(state.early_delay_times)) + 1)};
+
+    for (u32 block_start = 0; block_start < sample_count;) {
+        const auto input_index{
+            static_cast<s32>(pre_delay_line.input - pre_delay_line.buffer.data())};
+        const auto block_size{std::min(max_block_size, sample_count - block_start)};
+
+        std::array<std::array<s64, EarlyBlockSize>, NumChannels> early_samples{};
         for (u32 early_tap = 0; early_tap < ReverbInfo::MaxDelayTaps; early_tap++) {
-            const auto sample{state.pre_delay_line.TapOut(state.early_delay_times[early_tap]) *
-                              state.early_gains[early_tap]};
-            output_samples[tap_indexes[early_tap]] += sample;
-            if constexpr (NumChannels == 6) {
-                output_samples[static_cast<u32>(Channels::LFE)] += sample;
+            auto position{input_index - (state.early_delay_times[early_tap] + 1)};
+            while (position < 0) {
+                position += pre_delay_line.sample_count;
             }
+            AccumulateTap(std::span(early_samples[tap_indexes[early_tap]]).first(block_size),
+                          pre_delay_buffer, static_cast<u32>(position),
+                          state.early_gains[early_tap]);
         }
 
+        // No tap is output to the LFE channel directly, it receives all of them.
         if constexpr (NumChannels == 6) {
-            output_samples[static_cast<u32>(Channels::LFE)] *= 0.2f;
+            auto& lfe_samples{early_samples[static_cast<u32>(Channels::LFE)]};
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                if (channel == static_cast<u32>(Channels::LFE)) {
+                    continue;
+                }
+                for (u32 i = 0; i < block_size; i++) {
+                    lfe_samples[i] += early_samples[channel][i];
+                }
+            }
+            ApplyGain(std::span(lfe_samples).first(block_size), LfeGain);
         }
 
-        Common::FixedPoint<50, 14> input_sample{};
-        for (u32 channel = 0; channel < NumChannels; channel++) {
-            input_sample += inputs[channel][sample_index];
-        }
+        for (u32 i = 0; i < block_size; i++) {
+            const auto sample_index{block_start + i};
 
-        input_sample *= 64;
-        input_sample *= Common::FixedPoint<50, 14>::from_base(params.base_gain);
-        state.pre_delay_line.Write(input_sample);
+            Fixed input_sample{};
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                input_sample += inputs[channel][sample_index];
+            }
 
-        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
-            state.prev_feedback_output[i] =
-                state.prev_feedback_output[i] * state.hf_decay_prev_gain[i] +
-                state.fdn_delay_lines[i].Read() * state.hf_decay_gain[i];
-        }
+            input_sample *= 64;
+            input_sample *= base_gain;
+            pre_delay_line.Write(input_sample);
 
-        Common::FixedPoint<50, 14> pre_delay_sample{
-            state.pre_delay_line.TapOut(state.pre_delay_time) *
-            Common::FixedPoint<50, 14>::from_base(params.late_gain)};
-
-        std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> mix_matrix{
-            state.prev_feedback_output[2] + state.prev_feedback_output[1] + pre_delay_sample,
-            -state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
-            state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
-            state.prev_feedback_output[1] - state.prev_feedback_output[2] + pre_delay_sample,
-        };
-
-        std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> allpass_samples{};
-        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
-            allpass_samples[i] = Axfx2AllPassTick(state.decay_delay_lines[i],
-                                                  state.fdn_delay_lines[i], mix_matrix[i]);
-        }
+            for (u32 delay_line = 0; delay_line < ReverbInfo::MaxDelayLines; delay_line++) {
+                state.prev_feedback_output[delay_line] =
+                    state.prev_feedback_output[delay_line] * state.hf_decay_prev_gain[delay_line] +
+                    state.fdn_delay_lines[delay_line].Read() * state.hf_decay_gain[delay_line];
+            }
 
-        const auto dry_gain{Common::FixedPoint<50, 14>::from_base(params.dry_gain)};
-        const auto wet_gain{Common::FixedPoint<50, 14>::from_base(params.wet_gain)};
+            const Fixed pre_delay_sample{pre_delay_line.TapOut(state.pre_delay_time) * late_gain};
 
-        if constexpr (NumChannels == 6) {
-            const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
-                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
-                allpass_samples[3], allpass_samples[2], allpass_samples[3],
+            const std::array<Fixed, ReverbInfo::MaxDelayLines> mix_matrix{
+                state.prev_feedback_output[2] + state.prev_feedback_output[1] + pre_delay_sample,
+                -state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
+                state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
+                state.prev_feedback_output[1] - state.prev_feedback_output[2] + pre_delay_sample,
             };
 
-            for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
+            std::array<Fixed, ReverbInfo::MaxDelayLines> allpass_samples{};
+            for (u32 delay_line = 0; delay_line < ReverbInfo::MaxDelayLines; delay_line++) {
+                allpass_samples[delay_line] =
+                    Axfx2AllPassTick(state.decay_delay_lines[delay_line],
+                                     state.fdn_delay_lines[delay_line], mix_matrix[delay_line]);
+            }
 
-                Common::FixedPoint<50, 14> allpass{};
-                if (channel == static_cast<u32>(Channels::Center)) {
-                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
-                } else {
-                    allpass = allpass_outputs[channel];
+            if constexpr (NumChannels == 6) {
+                const std::array<Fixed, MaxChannels> allpass_outputs{
+                    allpass_samples[0], allpass_samples[1],
+                    allpass_samples[2] - allpass_samples[3], allpass_samples[3],
+                    allpass_samples[2], allpass_samples[3],
+                };
+
+                for (u32 channel = 0; channel < NumChannels; channel++) {
+                    auto in_sample{inputs[channel][sample_index] * dry_gain};
+
+                    Fixed allpass{};
+                    if (channel == static_cast<u32>(Channels::Center)) {
+                        allpass =
+                            state.center_delay_line.Tick(allpass_outputs[channel] * CenterGain);
+                    } else {
+                        allpass = allpass_outputs[channel];
+                    }
+
+                    auto out_sample{divide_by_64(
+                        (Fixed::from_base(early_samples[channel][i]) + allpass) * wet_gain)};
+                    outputs[channel][sample_index] = (in_sample + out_sample).to_int();
+                }
+            } else {
+                for (u32 channel = 0; channel < NumChannels; channel++) {
+                    auto in_sample{inputs[channel][sample_index] * dry_gain};
+                    auto out_sample{divide_by_64((Fixed::from_base(early_samples[channel][i]) +
+                                                  allpass_samples[channel]) *
+                                                 wet_gain)};
+                    outputs[channel][sample_index] = (in_sample + out_sample).to_int();
                 }
-
-                auto out_sample{((output_samples[channel] + allpass) * wet_gain) / 64};
-                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
-            }
-        } else {
-            for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
-                auto out_sample{((output_samples[channel] + allpass_samples[channel]) * wet_gain) /
-                                64};
-                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
             }
         }
+
+        block_start += block_size;
     }
 }
 
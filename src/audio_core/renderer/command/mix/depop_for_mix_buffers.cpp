@@ -20,20 +20,27 @@ static s32 ApplyDepopMix(std::span<s32> output, const s32 depop_sample,
                          Common::FixedPoint<49, 15>& decay_, const u32 sample_count) {
     auto sample{std::abs(depop_sample)};
     auto decay{decay_.to_raw()};
+    const s32 sign{depop_sample <= 0 ? -1 : 1};
 
-    if (depop_sample <= 0) {
-        for (u32 i = 0; i < sample_count; i++) {
-            sample = static_cast<s32>((static_cast<s64>(sample) * decay) >> 15);
-            output[i] -= sample;
+    // The decay is serial, but the sample soon settles, usually at 0, on a value which no longer
+    // decays. From then on the remaining samples are all offset by that same value.
+    u32 i = 0;
+    for (; i < sample_count; i++) {
+        const auto next_sample{static_cast<s32>((static_cast<s64>(sample) * decay) >> 15)};
+        if (next_sample == sample) {
+            break;
         }
-        return -sample;
-    } else {
-        for (u32 i = 0; i < sample_count; i++) {
-            sample = static_cast<s32>((static_cast<s64>(sample) * decay) >> 15);
-            output[i] += sample;
+        sample = next_sample;
+        output[i] += sign * sample;
+    }
+
+    if (sample != 0) {
+        const auto offset{sign * sample};
+        for (; i < sample_count; i++) {
+            output[i] += offset;
         }
-        return sample;
     }
+    return sign * sample;
 }
 
 void DepopForMixBuffersCommand::Dump(
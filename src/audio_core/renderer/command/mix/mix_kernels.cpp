@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#define MIX_KERNELS_X86_64
+#endif
+
+namespace AudioCore::Renderer {
+namespace {
+
+/**
+ * Convert a raw fixed point sample to an integer, rounding as Common::FixedPoint::to_int does by
+ * adding half of the fraction before truncating.
+ */
+template <size_t Q>
+s32 ToInt(s64 raw) {
+    constexpr s64 FractionalMask = (s64{1} << Q) - 1;
+    raw += (raw & FractionalMask) >> 1;
+    return static_cast<s32>(raw >> Q);
+}
+
+/**
+ * Apply volume to an input sample, and add the output sample to it if accumulating. Products
+ * wrap around as the 64-bit FixedPoint arithmetic does.
+ */
+template <size_t Q, bool Accumulate>
+s64 ApplyVolume(s32 output, s32 input, s64 volume) {
+    u64 raw = static_cast<u64>(static_cast<s64>(input)) * static_cast<u64>(volume);
+    if constexpr (Accumulate) {
+        raw += static_cast<u64>(static_cast<s64>(output)) << Q;
+    }
+    return static_cast<s64>(raw);
+}
+
+template <size_t Q, bool Accumulate>
+void ProcessScalar(s32* output, const s32* input, s64 volume, s64 ramp, u32 begin, u32 end) {
+    for (u32 i = begin; i < end; i++) {
+        output[i] = ToInt<Q>(ApplyVolume<Q, Accumulate>(output[i], input[i], volume));
+        volume += ramp;
+    }
+}
+
+#if defined(MIX_KERNELS_X86_64)
+
+#ifdef _MSC_VER
+#define SSE41_TARGET
+#define AVX2_TARGET
+#else
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+/*
+ * The vector kernels multiply the even and odd samples separately into 64-bit lanes, using the
+ * signed 32-bit multiplies, so they require every volume to fit in 32 bits. Only the low 32 bits
+ * of the rounded result are kept, and those only depend on the low Q + 32 bits of the sum, so the
+ * output samples are shifted into place without being sign extended first.
+ */
+
+// Rounds raw fixed point samples as ToInt does, leaving the integers in the low half of the lanes.
+template <size_t Q>
+SSE41_TARGET __m128i RoundSse41(__m128i raw, __m128i fractional_mask) {
+    raw = _mm_add_epi64(raw, _mm_srli_epi64(_mm_and_si128(raw, fractional_mask), 1));
+    return _mm_srli_epi64(raw, Q);
+}
+
+template <size_t Q>
+AVX2_TARGET __m256i RoundAvx2(__m256i raw, __m256i fractional_mask) {
+    raw = _mm256_add_epi64(raw, _mm256_srli_epi64(_mm256_and_si256(raw, fractional_mask), 1));
+    return _mm256_srli_epi64(raw, Q);
+}
+
+template <size_t Q, bool Accumulate>
+SSE41_TARGET u32 ProcessSse41(s32* output, const s32* input, s64 volume, s64 ramp,
+                              u32 sample_count) {
+    constexpr u32 Lanes = 4;
+    const __m128i fractional_mask = _mm_set1_epi64x((s64{1} << Q) - 1);
+    const __m128i step = _mm_set1_epi64x(ramp * Lanes);
+    __m128i even_volumes = _mm_set_epi64x(volume + ramp * 2, volume);
+    __m128i odd_volumes = _mm_set_epi64x(volume + ramp * 3, volume + ramp);
+
+    u32 i = 0;
+    for (; i + Lanes <= sample_count; i += Lanes) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i even = _mm_mul_epi32(in, even_volumes);
+        __m128i odd = _mm_mul_epi32(_mm_srli_epi64(in, 32), odd_volumes);
+        if constexpr (Accumulate) {
+            const __m128i out = _mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i));
+            even = _mm_add_epi64(even, _mm_slli_epi64(out, Q));
+            odd = _mm_add_epi64(odd, _mm_slli_epi64(_mm_srli_epi64(out, 32), Q));
+        }
+
+        even = RoundSse41<Q>(even, fractional_mask);
+        odd = RoundSse41<Q>(odd, fractional_mask);
+        const __m128i result = _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+
+        even_volumes = _mm_add_epi64(even_volumes, step);
+        odd_volumes = _mm_add_epi64(odd_volumes, step);
+    }
+    return i;
+}
+
+template <size_t Q, bool Accumulate>
+AVX2_TARGET u32 ProcessAvx2(s32* output, const s32* input, s64 volume, s64 ramp,
+                            u32 sample_count) {
+    constexpr u32 Lanes = 8;
+    const __m256i fractional_mask = _mm256_set1_epi64x((s64{1} << Q) - 1);
+    const __m256i step = _mm256_set1_epi64x(ramp * Lanes);
+    __m256i even_volumes =
+        _mm256_set_epi64x(volume + ramp * 6, volume + ramp * 4, volume + ramp * 2, volume);
+    __m256i odd_volumes = _mm256_set_epi64x(volume + ramp * 7, volume + ramp * 5,
+                                            volume + ramp * 3, volume + ramp);
+
+    u32 i = 0;
+    for (; i + Lanes <= sample_count; i += Lanes) {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        __m256i even = _mm256_mul_epi32(in, even_volumes);
+        __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(in, 32), odd_volumes);
+        if constexpr (Accumulate) {
+            const __m256i out = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(output + i));
+            even = _mm256_add_epi64(even, _mm256_slli_epi64(out, Q));
+            odd = _mm256_add_epi64(odd, _mm256_slli_epi64(_mm256_srli_epi64(out, 32), Q));
+        }
+
+        even = RoundAvx2<Q>(even, fractional_mask);
+        odd = RoundAvx2<Q>(odd, fractional_mask);
+        const __m256i result = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), result);
+
+        even_volumes = _mm256_add_epi64(even_volumes, step);
+        odd_volumes = _mm256_add_epi64(odd_volumes, step);
+    }
+    return i;
+}
+
+/**
+ * Check whether every volume applied to the samples fits in 32 bits. Volumes change linearly, so
+ * only the first and the last need to be checked.
+ */
+bool VolumesFitIn32Bits(s64 volume, s64 ramp, u32 sample_count) {
+    constexpr s64 Min = std::numeric_limits<s32>::min();
+    constexpr s64 Max = std::numeric_limits<s32>::max();
+    if (volume < Min || volume > Max || ramp < Min || ramp > Max) {
+        return false;
+    }
+    const s64 last_volume = volume + ramp * static_cast<s64>(sample_count);
+    return last_volume >= Min && last_volume <= Max;
+}
+
+#endif
+
+template <size_t Q, bool Accumulate>
+void Process(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+             u32 sample_count) {
+    u32 processed = 0;
+#if defined(MIX_KERNELS_X86_64)
+    if (VolumesFitIn32Bits(volume, ramp, sample_count)) {
+        const auto& caps = Common::GetCPUCaps();
+        if (caps.avx2) {
+            processed = ProcessAvx2<Q, Accumulate>(output.data(), input.data(), volume, ramp,
+                                                   sample_count);
+        } else if (caps.sse4_1) {
+            processed = ProcessSse41<Q, Accumulate>(output.data(), input.data(), volume, ramp,
+                                                    sample_count);
+        }
+    }
+#endif
+    ProcessScalar<Q, Accumulate>(output.data(), input.data(),
+                                 volume + ramp * static_cast<s64>(processed), ramp, processed,
+                                 sample_count);
+}
+
+} // Anonymous namespace
+
+template <size_t Q>
+s32 MixSamples(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+               u32 sample_count) {
+    if (sample_count == 0) {
+        return 0;
+    }
+
+    // The input may alias the output, so the last sample is computed before mixing.
+    const auto last_volume = volume + ramp * static_cast<s64>(sample_count - 1);
+    const auto last_sample =
+        ToInt<Q>(ApplyVolume<Q, false>(0, input[sample_count - 1], last_volume));
+
+    Process<Q, true>(output, input, volume, ramp, sample_count);
+    return last_sample;
+}
+
+template <size_t Q>
+void ScaleSamples(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+                  u32 sample_count) {
+    Process<Q, false>(output, input, volume, ramp, sample_count);
+}
+
+template s32 MixSamples<15>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+template s32 MixSamples<23>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+template void ScaleSamples<15>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+template void ScaleSamples<23>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/*
+ * Sample kernels shared by the mix commands, vectorised with SSE4.1 or AVX2 when the host supports
+ * them. Volumes are the raw values of a Common::FixedPoint<64 - Q, Q>, and the output is exactly
+ * that of the equivalent FixedPoint arithmetic, including its rounding.
+ */
+
+/**
+ * Mix input mix buffer into output mix buffer, with volume applied to the input and ramped by
+ * ramp every sample.
+ *
+ * @tparam Q           - Number of bits for fixed point operations.
+ * @param output       - Output mix buffer.
+ * @param input        - Input mix buffer.
+ * @param volume       - Raw fixed point volume applied to the first sample.
+ * @param ramp         - Raw fixed point ramp added to the volume every sample.
+ * @param sample_count - Number of samples to process.
+ * @return The last input sample with its volume applied, or 0 if there are no samples.
+ */
+template <size_t Q>
+s32 MixSamples(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+               u32 sample_count);
+
+/**
+ * Apply volume to input mix buffer, ramped by ramp every sample, saving to output mix buffer.
+ *
+ * @tparam Q           - Number of bits for fixed point operations.
+ * @param output       - Output mix buffer, which may be the same as the input.
+ * @param input        - Input mix buffer.
+ * @param volume       - Raw fixed point volume applied to the first sample.
+ * @param ramp         - Raw fixed point ramp added to the volume every sample.
+ * @param sample_count - Number of samples to process.
+ */
+template <size_t Q>
+void ScaleSamples(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+                  u32 sample_count);
+
+} // namespace AudioCore::Renderer
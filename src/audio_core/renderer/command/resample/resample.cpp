@@ -3,8 +3,106 @@
 
 #include "audio_core/renderer/command/resample/resample.h"
 
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#define RESAMPLE_X86_64
+#endif
+
 namespace AudioCore::Renderer {
 
+#if defined(RESAMPLE_X86_64)
+
+#ifdef _MSC_VER
+#define SSE41_TARGET
+#else
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#endif
+
+/**
+ * Vectorised ResampleFilter, computing four output samples per iteration. The taps of each output
+ * sample are converted and truncated exactly as the scalar FixedPoint<56, 8> conversions do, and
+ * as they are then summed as integers, the order of the sums does not change the result.
+ *
+ * @return Number of samples written, a multiple of four.
+ */
+template <u32 TapCount>
+SSE41_TARGET static u32 ResampleFilterSse41(s32* output, const s16* input, const f32* lut,
+                                            const s64 ratio, s64& fraction, u32& read_index,
+                                            const u32 samples_to_write) {
+    constexpr s64 FractionalMask{(1 << 15) - 1};
+    const __m128 scale{_mm_set1_ps(256.0f)};
+
+    u32 i{0};
+    for (; i + 4 <= samples_to_write; i += 4) {
+        __m128i sums[4];
+        for (auto& sum : sums) {
+            const auto lut_index{static_cast<u32>(fraction >> 8) * TapCount};
+            sum = _mm_setzero_si128();
+            for (u32 tap = 0; tap < TapCount; tap += 4) {
+                const __m128i samples{_mm_cvtepi16_epi32(
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + read_index + tap)))};
+                const __m128 products{_mm_mul_ps(
+                    _mm_mul_ps(_mm_cvtepi32_ps(samples), _mm_loadu_ps(lut + lut_index + tap)),
+                    scale)};
+                sum = _mm_add_epi32(sum, _mm_cvttps_epi32(products));
+            }
+            fraction += ratio;
+            read_index += static_cast<u32>(fraction >> 15);
+            fraction &= FractionalMask;
+        }
+
+        const __m128i totals{_mm_hadd_epi32(_mm_hadd_epi32(sums[0], sums[1]),
+                                            _mm_hadd_epi32(sums[2], sums[3]))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_srai_epi32(totals, 8));
+    }
+    return i;
+}
+
+#endif
+
+/**
+ * Resample with a polyphase filter of TapCount taps, selected from lut by the read fraction.
+ *
+ * @tparam TapCount         - Number of input samples filtered into each output sample.
+ * @param output            - Output buffer.
+ * @param input             - Input buffer.
+ * @param lut               - Filter taps, TapCount for each of the 128 fraction steps.
+ * @param sample_rate_ratio - Ratio for resampling.
+ * @param fraction          - Current read fraction, updated for the samples written.
+ * @param samples_to_write  - Number of samples to write.
+ */
+template <u32 TapCount>
+static void ResampleFilter(std::span<s32> output, std::span<const s16> input,
+                           std::span<const f32> lut,
+                           const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                           Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
+    u32 read_index{0};
+    u32 i{0};
+
+#if defined(RESAMPLE_X86_64)
+    if (Common::GetCPUCaps().sse4_1) {
+        auto raw_fraction{fraction.to_raw()};
+        i = ResampleFilterSse41<TapCount>(output.data(), input.data(), lut.data(),
+                                          sample_rate_ratio.to_raw(), raw_fraction, read_index,
+                                          samples_to_write);
+        fraction = Common::FixedPoint<49, 15>::from_base(raw_fraction);
+    }
+#endif
+
+    for (; i < samples_to_write; i++) {
+        const auto lut_index{(fraction.get_frac() >> 8) * TapCount};
+        Common::FixedPoint<56, 8> sum{0};
+        for (u32 tap = 0; tap < TapCount; tap++) {
+            sum += Common::FixedPoint<56, 8>{input[read_index + tap] * lut[lut_index + tap]};
+        }
+        output[i] = sum.to_int_floor();
+        fraction += sample_rate_ratio;
+        read_index += static_cast<u32>(fraction.to_int_floor());
+        fraction.clear_int();
+    }
+}
+
 static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input,
                                const Common::FixedPoint<49, 15>& sample_rate_ratio,
                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
@@ -292,19 +390,7 @@ static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> in
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 4};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        output[i] = (sample0 + sample1 + sample2 + sample3).to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    ResampleFilter<4>(output, input, get_lut(), sample_rate_ratio, fraction, samples_to_write);
 }
 
 static void ResampleHighQuality(std::span<s32> output, std::span<const s16> input,
@@ -842,24 +928,7 @@ static void ResampleHighQuality(std::span<s32> output, std::span<const s16> inpu
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 8};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        const Common::FixedPoint<56, 8> sample4{input[read_index + 4] * lut[lut_index + 4]};
-        const Common::FixedPoint<56, 8> sample5{input[read_index + 5] * lut[lut_index + 5]};
-        const Common::FixedPoint<56, 8> sample6{input[read_index + 6] * lut[lut_index + 6]};
-        const Common::FixedPoint<56, 8> sample7{input[read_index + 7] * lut[lut_index + 7]};
-        output[i] = (sample0 + sample1 + sample2 + sample3 + sample4 + sample5 + sample6 + sample7)
-                        .to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    ResampleFilter<8>(output, input, get_lut(), sample_rate_ratio, fraction, samples_to_write);
 }
 
 void Resample(std::span<s32> output, std::span<const s16> input,
@@ -4,6 +4,8 @@
 #include <chrono>
 #include <span>
 
+#include <fmt/format.h>
+
 #include "audio_core/adsp/apps/audio_renderer/audio_renderer.h"
 #include "audio_core/adsp/apps/audio_renderer/command_buffer.h"
 #include "audio_core/audio_core.h"
@@ -29,6 +31,8 @@
 #include "audio_core/renderer/voice/voice_info.h"
 #include "audio_core/renderer/voice/voice_state.h"
 #include "common/alignment.h"
+#include "common/fs/path_util.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_event.h"
@@ -97,8 +101,12 @@ u64 System::GetWorkBufferSize(const AudioRendererParameterInternal& params) {
 }
 
 System::System(Core::System& core_, Kernel::KEvent* adsp_rendered_event_)
-    : core{core_}, audio_renderer{core.AudioCore().ADSP().AudioRenderer()},
-      adsp_rendered_event{adsp_rendered_event_} {}
+    : System{core_, core_.AudioCore().ADSP().AudioRenderer(), adsp_rendered_event_} {}
+
+System::System(Core::System& core_,
+               ::AudioCore::ADSP::AudioRenderer::AudioRenderer& audio_renderer_,
+               Kernel::KEvent* adsp_rendered_event_)
+    : core{core_}, audio_renderer{audio_renderer_}, adsp_rendered_event{adsp_rendered_event_} {}
 
 Result System::Initialize(const AudioRendererParameterInternal& params,
                           Kernel::KTransferMemory* transfer_memory, u64 transfer_memory_size,
@@ -394,6 +402,13 @@ Result System::Initialize(const AudioRendererParameterInternal& params,
                                                                      mix_buffer_count);
     }
 
+    if (Settings::values.dump_audio_renderer_updates) {
+        const auto path{Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir) / "audio" /
+                        fmt::format("{:016X}_{}.bin", process_handle->GetProgramId(), session_id)};
+        update_recorder =
+            std::make_unique<UpdateRecorder>(path, params, transfer_memory_size, *process_handle);
+    }
+
     initialized = true;
     return ResultSuccess;
 }
@@ -423,6 +438,7 @@ void System::Finalize() {
         // dsp::ProcessCleanup
         // close handle
     }
+    update_recorder.reset();
     initialized = false;
 }
 
@@ -537,6 +553,11 @@ Result System::Update(std::span<const u8> input, std::span<u8> performance, std:
         return result;
     }
 
+    if (update_recorder) {
+        update_recorder->RecordUpdate(input, performance.size_bytes(), output.size_bytes(),
+                                      memory_pool_workbuffer.first(memory_pool_count));
+    }
+
     adsp_rendered_event->Clear();
     num_times_updated++;
 
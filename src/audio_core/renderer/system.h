@@ -15,6 +15,7 @@
 #include "audio_core/renderer/performance/performance_manager.h"
 #include "audio_core/renderer/sink/sink_context.h"
 #include "audio_core/renderer/splitter/splitter_context.h"
+#include "audio_core/renderer/update_recorder.h"
 #include "audio_core/renderer/upsampler/upsampler_manager.h"
 #include "audio_core/renderer/voice/voice_context.h"
 #include "common/thread.h"
@@ -58,6 +59,18 @@ class System {
 public:
     explicit System(Core::System& core, Kernel::KEvent* adsp_rendered_event);
 
+    /**
+     * Create a system which sends its command lists to the given AudioRenderer, rather than to
+     * the one of the core's ADSP.
+     *
+     * @param core                - The core system.
+     * @param audio_renderer      - The AudioRenderer processing the generated command lists.
+     * @param adsp_rendered_event - Event signalled when a command list is sent to be processed.
+     */
+    explicit System(Core::System& core,
+                    ::AudioCore::ADSP::AudioRenderer::AudioRenderer& audio_renderer,
+                    Kernel::KEvent* adsp_rendered_event);
+
     /**
      * Calculate the total size required for all audio render workbuffers.
      *
@@ -323,6 +336,8 @@ private:
     u64 render_start_tick{};
     /// Parameter to control the threshold for dropping voices if the audio graph gets too large
     f32 drop_voice_param{1.0f};
+    /// Records the updates for replay, when enabled
+    std::unique_ptr<UpdateRecorder> update_recorder{};
 };
 
 } // namespace Renderer
@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "audio_core/renderer/memory/memory_pool_info.h"
+#include "audio_core/renderer/update_recorder.h"
+#include "common/common_funcs.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/memory.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+constexpr u32 RecordingMagic = Common::MakeMagic('A', 'R', 'U', 'R');
+constexpr u32 RecordingVersion = 1;
+
+/// Granularity at which changes to the pools are recorded.
+constexpr u64 ChunkSize = 0x1000;
+
+/// Upper bound for the size of a single record, to reject corrupt recordings.
+constexpr u64 MaxRecordSize = 0x4000'0000;
+
+} // Anonymous namespace
+
+UpdateRecorder::UpdateRecorder(const std::filesystem::path& path,
+                               const AudioRendererParameterInternal& params,
+                               u64 transfer_memory_size, Kernel::KProcess& process_)
+    : process{process_} {
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Service_Audio, "Failed to create the audio renderer recording directory");
+        return;
+    }
+
+    file.Open(path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Service_Audio, "Failed to open audio renderer recording {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+
+    const Header header{
+        .magic = RecordingMagic,
+        .version = RecordingVersion,
+        .params = params,
+        .address_space_width = process.GetPageTable().GetAddressSpaceWidth(),
+        .is_64bit = process.Is64Bit(),
+        .reserved = {},
+        .transfer_memory_size = transfer_memory_size,
+    };
+    if (!file.WriteObject(header)) {
+        file.Close();
+        return;
+    }
+
+    LOG_INFO(Service_Audio, "Recording audio renderer updates to {}",
+             Common::FS::PathToUTF8String(path));
+}
+
+bool UpdateRecorder::IsOpen() const {
+    return file.IsOpen();
+}
+
+void UpdateRecorder::RecordUpdate(std::span<const u8> input, u64 performance_size,
+                                  u64 output_size, std::span<const MemoryPoolInfo> pools) {
+    if (!IsOpen()) {
+        return;
+    }
+
+    const RecordHeader update_header{
+        .type = RecordType::Update,
+        .reserved = 0,
+        .address = 0,
+        .size = input.size(),
+        .performance_size = performance_size,
+        .output_size = output_size,
+    };
+    bool success = WriteRecord(update_header, input);
+
+    for (const auto& pool : pools) {
+        if (!success) {
+            break;
+        }
+        if (pool.GetLocation() != MemoryPoolInfo::Location::CPU || !pool.IsMapped() ||
+            pool.GetSize() == 0) {
+            continue;
+        }
+
+        const auto address{pool.GetCpuAddress()};
+        const auto it = std::ranges::find_if(snapshots, [&](const PoolSnapshot& snapshot) {
+            return snapshot.address == address && snapshot.data.size() == pool.GetSize();
+        });
+        if (it == snapshots.end()) {
+            RecordPool(pool);
+            continue;
+        }
+
+        // Only the chunks written by the game since the last update are recorded, as most of a
+        // pool is usually sample data which never changes once loaded.
+        scratch.resize(it->data.size());
+        process.GetMemory().ReadBlock(address, scratch.data(), scratch.size());
+        for (u64 start = 0; success && start < scratch.size();) {
+            const auto chunk_size = [&](u64 offset) {
+                return std::min<u64>(ChunkSize, scratch.size() - offset);
+            };
+            const auto is_chunk_dirty = [&](u64 offset) {
+                return std::memcmp(scratch.data() + offset, it->data.data() + offset,
+                                   chunk_size(offset)) != 0;
+            };
+            if (!is_chunk_dirty(start)) {
+                start += chunk_size(start);
+                continue;
+            }
+
+            u64 end = start + chunk_size(start);
+            while (end < scratch.size() && is_chunk_dirty(end)) {
+                end += chunk_size(end);
+            }
+
+            const auto dirty = std::span(scratch).subspan(start, end - start);
+            const RecordHeader memory_header{
+                .type = RecordType::Memory,
+                .reserved = 0,
+                .address = address + start,
+                .size = dirty.size(),
+                .performance_size = 0,
+                .output_size = 0,
+            };
+            success = WriteRecord(memory_header, dirty);
+            std::ranges::copy(dirty, it->data.begin() + start);
+            start = end;
+        }
+    }
+
+    if (!success) {
+        LOG_ERROR(Service_Audio, "Failed to write the audio renderer recording, stopping it");
+        file.Close();
+    }
+}
+
+void UpdateRecorder::RecordPool(const MemoryPoolInfo& pool) {
+    auto& snapshot{snapshots.emplace_back(PoolSnapshot{
+        .address = pool.GetCpuAddress(),
+        .data = std::vector<u8>(pool.GetSize()),
+    })};
+    process.GetMemory().ReadBlock(snapshot.address, snapshot.data.data(), snapshot.data.size());
+
+    const RecordHeader pool_header{
+        .type = RecordType::Pool,
+        .reserved = 0,
+        .address = snapshot.address,
+        .size = snapshot.data.size(),
+        .performance_size = 0,
+        .output_size = 0,
+    };
+    RecordHeader memory_header{pool_header};
+    memory_header.type = RecordType::Memory;
+    if (!WriteRecord(pool_header, {}) || !WriteRecord(memory_header, snapshot.data)) {
+        file.Close();
+    }
+}
+
+bool UpdateRecorder::WriteRecord(const RecordHeader& header, std::span<const u8> data) {
+    return file.IsOpen() && file.WriteObject(header) && file.WriteSpan(data) == data.size();
+}
+
+std::optional<UpdateRecording> ReadUpdateRecording(const std::filesystem::path& path) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return std::nullopt;
+    }
+
+    UpdateRecording recording{};
+    if (!file.ReadObject(recording.header) || recording.header.magic != RecordingMagic ||
+        recording.header.version != RecordingVersion) {
+        return std::nullopt;
+    }
+
+    using RecordType = UpdateRecorder::RecordType;
+    UpdateRecorder::RecordHeader header{};
+    while (file.ReadObject(header)) {
+        const bool has_data{header.type != RecordType::Pool};
+        if (header.size > MaxRecordSize ||
+            (header.type != RecordType::Update && recording.frames.empty())) {
+            return std::nullopt;
+        }
+
+        std::vector<u8> data(has_data ? header.size : 0);
+        if (file.ReadSpan<u8>(data) != data.size()) {
+            return std::nullopt;
+        }
+
+        switch (header.type) {
+        case RecordType::Update:
+            recording.frames.push_back({
+                .input = std::move(data),
+                .performance_size = header.performance_size,
+                .output_size = header.output_size,
+                .memory = {},
+            });
+            break;
+        case RecordType::Pool:
+            recording.pools.emplace_back(header.address, header.size);
+            break;
+        case RecordType::Memory:
+            recording.frames.back().memory.push_back({
+                .address = header.address,
+                .data = std::move(data),
+            });
+            break;
+        default:
+            return std::nullopt;
+        }
+    }
+    return recording;
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "audio_core/common/audio_renderer_parameter.h"
+#include "audio_core/common/common.h"
+#include "common/common_types.h"
+#include "common/fs/file.h"
+
+namespace Kernel {
+class KProcess;
+}
+
+namespace AudioCore::Renderer {
+class MemoryPoolInfo;
+
+/**
+ * Records the updates a game sends to an audio renderer, along with the contents of the memory
+ * pools they reference, so that the renderer can be replayed and benchmarked without the game.
+ *
+ * A recording is a header followed by records. Each update record is followed by the pools
+ * attached to the renderer at that point, and the pages of those pools which changed since the
+ * last update.
+ */
+class UpdateRecorder {
+public:
+    enum class RecordType : u32 {
+        Update,
+        Pool,
+        Memory,
+    };
+
+    struct Header {
+        /* 0x00 */ u32 magic;
+        /* 0x04 */ u32 version;
+        /* 0x08 */ AudioRendererParameterInternal params;
+        /* 0x3C */ u32 address_space_width;
+        /* 0x40 */ bool is_64bit;
+        /* 0x41 */ std::array<u8, 7> reserved;
+        /* 0x48 */ u64 transfer_memory_size;
+    };
+    static_assert(sizeof(Header) == 0x50, "UpdateRecorder::Header has the wrong size!");
+
+    struct RecordHeader {
+        /* 0x00 */ RecordType type;
+        /* 0x04 */ u32 reserved;
+        /* 0x08 */ u64 address;
+        /* 0x10 */ u64 size;
+        /* 0x18 */ u64 performance_size;
+        /* 0x20 */ u64 output_size;
+    };
+    static_assert(sizeof(RecordHeader) == 0x28,
+                  "UpdateRecorder::RecordHeader has the wrong size!");
+
+    /**
+     * Start a recording.
+     *
+     * @param path                 - Path to write the recording to.
+     * @param params               - Parameters the renderer was initialized with.
+     * @param transfer_memory_size - Size of the transfer memory given to the renderer.
+     * @param process              - Process the renderer reads its memory pools from.
+     */
+    explicit UpdateRecorder(const std::filesystem::path& path,
+                            const AudioRendererParameterInternal& params,
+                            u64 transfer_memory_size, Kernel::KProcess& process);
+
+    /**
+     * Check if the recording could be written.
+     *
+     * @return True if the recording is open.
+     */
+    bool IsOpen() const;
+
+    /**
+     * Record a successful update, followed by the memory pools as they are after it.
+     *
+     * @param input            - Input buffer given to the update.
+     * @param performance_size - Size of the performance buffer given to the update.
+     * @param output_size      - Size of the output buffer given to the update.
+     * @param pools            - Memory pools of the renderer.
+     */
+    void RecordUpdate(std::span<const u8> input, u64 performance_size, u64 output_size,
+                      std::span<const MemoryPoolInfo> pools);
+
+private:
+    /// Contents of a pool as of the last update, to only record the pages which change.
+    struct PoolSnapshot {
+        CpuAddr address;
+        std::vector<u8> data;
+    };
+
+    void RecordPool(const MemoryPoolInfo& pool);
+    bool WriteRecord(const RecordHeader& header, std::span<const u8> data);
+
+    Common::FS::IOFile file;
+    Kernel::KProcess& process;
+    std::vector<PoolSnapshot> snapshots;
+    std::vector<u8> scratch;
+};
+
+/**
+ * A recording read back for replay, split into frames of one update each.
+ */
+struct UpdateRecording {
+    struct Memory {
+        CpuAddr address;
+        std::vector<u8> data;
+    };
+
+    struct Frame {
+        std::vector<u8> input;
+        u64 performance_size;
+        u64 output_size;
+        /// Pool contents changed by this update, to be written after it.
+        std::vector<Memory> memory;
+    };
+
+    UpdateRecorder::Header header;
+    /// Address and size of every pool used during the recording.
+    std::vector<std::pair<CpuAddr, u64>> pools;
+    std::vector<Frame> frames;
+};
+
+/**
+ * Read a recording written by UpdateRecorder.
+ *
+ * @param path - Path of the recording.
+ * @return The recording, or nullopt if it could not be read.
+ */
+std::optional<UpdateRecording> ReadUpdateRecording(const std::filesystem::path& path);
+
+} // namespace AudioCore::Renderer
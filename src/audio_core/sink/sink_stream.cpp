@@ -12,12 +12,23 @@
 #include "audio_core/sink/sink_stream.h"
 #include "common/common_types.h"
 #include "common/fixed_point.h"
+#include "common/logging/log.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 
 namespace AudioCore::Sink {
+namespace {
+
+/// Lowest target queue size, in buffers
+constexpr u32 MinTargetQueueSize = 2;
+/// Longest time to play without an underrun before lowering the target queue size
+constexpr u64 MaxRequiredStableFrames = TargetSampleRate * 64;
+/// Number of buffers queued beyond the target before frames are dropped to correct drift
+constexpr u32 DriftQueueThreshold = 2;
+
+} // Anonymous namespace
 
 void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
     SCOPE_EXIT {
@@ -206,6 +217,7 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
     const std::size_t frame_size_bytes = frame_size * sizeof(s16);
     size_t frames_written{0};
     size_t actual_frames_written{0};
+    bool underrun{false};
 
     // If we're paused or going to shut down, we don't want to consume buffers as coretiming is
     // paused and we'll desync, so just play silence.
@@ -225,6 +237,12 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         return;
     }
 
+    // If the render queue has grown well past its target, the device is playing slower than the
+    // ADSP produces samples. Drop a single frame to bring the latency back down, rather than
+    // stretching the audio. Audio out streams are left alone, games choose their own queue depth.
+    bool drop_frame{type == StreamType::Render &&
+                    queued_buffers > target_queue_size + DriftQueueThreshold};
+
     while (frames_written < num_frames) {
         // If the playing buffer has been consumed or has no frames, we need a new one
         if (playing_buffer.consumed || playing_buffer.frames == 0) {
@@ -235,14 +253,12 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
                     std::memcpy(&output_buffer[i * frame_size], &last_frame[0], frame_size_bytes);
                 }
                 frames_written = num_frames;
+                underrun = true;
                 continue;
             }
             // Successfully dequeued a new buffer.
             queued_buffers--;
-
-            { std::unique_lock lk{release_mutex}; }
-
-            release_cv.notify_one();
+            SignalFreeSpace();
         }
 
         // Get the minimum frames available between the currently playing buffer, and the
@@ -257,6 +273,15 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         actual_frames_written += frames_available;
         playing_buffer.frames_played += frames_available;
 
+        if (drop_frame && playing_buffer.frames_played < playing_buffer.frames) {
+            std::array<s16, MaxChannels> dropped_frame;
+            samples_buffer.Pop(dropped_frame.data(), frame_size);
+            actual_frames_written++;
+            playing_buffer.frames_played++;
+            dropped_frame_count++;
+            drop_frame = false;
+        }
+
         // If that's all the frames in the current buffer, add its samples and mark it as
         // consumed
         if (playing_buffer.frames_played >= playing_buffer.frames) {
@@ -273,6 +298,8 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         min_played_sample_count = max_played_sample_count;
         max_played_sample_count += actual_frames_written;
     }
+
+    UpdateTargetQueueSize(underrun, num_frames);
 }
 
 u64 SinkStream::GetExpectedPlayedSampleCount() {
@@ -286,13 +313,85 @@ u64 SinkStream::GetExpectedPlayedSampleCount() {
     return std::min<u64>(exp_played_sample_count, max_played_sample_count) + TargetSampleCount * 3;
 }
 
+SinkStreamStatistics SinkStream::GetStatistics() const {
+    return {
+        .underruns = underrun_count,
+        .dropped_frames = dropped_frame_count,
+        .target_queue_size = target_queue_size,
+        .queued_buffers = queued_buffers,
+        .queued_frames = samples_buffer.Size() / device_channels,
+    };
+}
+
 void SinkStream::WaitFreeSpace(std::stop_token stop_token) {
+    const auto has_free_space = [this] { return paused || queued_buffers < target_queue_size; };
+    if (has_free_space()) {
+        return;
+    }
+
     std::unique_lock lk{release_mutex};
-    release_cv.wait_for(lk, std::chrono::milliseconds(5),
-                        [this]() { return paused || queued_buffers < max_queue_size; });
-    if (queued_buffers > max_queue_size + 3) {
-        Common::CondvarWait(release_cv, lk, stop_token,
-                            [this] { return paused || queued_buffers < max_queue_size; });
+    waiting_for_space = true;
+    SCOPE_EXIT {
+        waiting_for_space = false;
+    };
+
+    release_cv.wait_for(lk, std::chrono::milliseconds(5), has_free_space);
+    if (queued_buffers > target_queue_size + 3) {
+        Common::CondvarWait(release_cv, lk, stop_token, has_free_space);
+    }
+}
+
+void SinkStream::SignalFreeSpace() {
+    // WaitFreeSpace sets the flag before checking the queue size under the lock, so either it
+    // sees the new size, or the flag is seen here and the notification is not lost.
+    if (!waiting_for_space) {
+        return;
+    }
+
+    { std::scoped_lock lk{release_mutex}; }
+
+    release_cv.notify_one();
+}
+
+void SinkStream::UpdateTargetQueueSize(bool underrun, std::size_t num_frames) {
+    if (underrun) {
+        // Only count running out of buffers once, until the stream plays normally again.
+        if (starved) {
+            return;
+        }
+        starved = true;
+        underrun_count++;
+    } else {
+        starved = false;
+    }
+
+    // Only the ADSP waits for free space, the games pace audio out streams themselves.
+    if (type != StreamType::Render || max_queue_size == 0) {
+        return;
+    }
+
+    if (underrun) {
+        stable_frames = 0;
+        required_stable_frames = std::min(required_stable_frames * 2, MaxRequiredStableFrames);
+
+        if (target_queue_size < max_queue_size * 2) {
+            target_queue_size++;
+            LOG_DEBUG(Audio_Sink, "Stream {} underran, target queue size raised to {}", name,
+                      target_queue_size.load());
+        }
+        return;
+    }
+
+    stable_frames += num_frames;
+    if (stable_frames < required_stable_frames) {
+        return;
+    }
+    stable_frames = 0;
+
+    if (target_queue_size > std::min(MinTargetQueueSize, max_queue_size)) {
+        target_queue_size--;
+        LOG_DEBUG(Audio_Sink, "Stream {} is stable, target queue size lowered to {}", name,
+                  target_queue_size.load());
     }
 }
 
@@ -37,6 +37,19 @@ struct SinkBuffer {
     bool consumed;
 };
 
+struct SinkStreamStatistics {
+    /// Number of times the stream ran out of buffers while playing
+    u64 underruns;
+    /// Number of frames dropped to bring the queue back down to its target size
+    u64 dropped_frames;
+    /// Number of buffers the stream currently aims to keep queued
+    u32 target_queue_size;
+    /// Number of buffers waiting to be played
+    u32 queued_buffers;
+    /// Number of frames waiting to be played
+    u64 queued_frames;
+};
+
 /**
  * Contains a real backend stream for outputting samples to hardware,
  * created only via a Sink (See Sink::AcquireSinkStream).
@@ -158,12 +171,20 @@ public:
     }
 
     /**
-     * Set the maximum buffer queue size.
+     * Set the buffer queue size, which the target queue size adapts around.
      */
     void SetRingSize(u32 ring_size) {
         max_queue_size = ring_size;
+        target_queue_size = ring_size;
     }
 
+    /**
+     * Get the underrun and latency statistics of this stream.
+     *
+     * @return The current statistics.
+     */
+    SinkStreamStatistics GetStatistics() const;
+
     /**
      * Append a new buffer and its samples to a waiting queue to play.
      *
@@ -219,6 +240,22 @@ protected:
      */
     void SignalPause();
 
+private:
+    /**
+     * Wake WaitFreeSpace if it is waiting. Only takes the lock when it is, as this is called
+     * from the audio callback.
+     */
+    void SignalFreeSpace();
+
+    /**
+     * Count underruns, and adapt the target queue size of render streams to how the last
+     * callback went, growing it after an underrun and shrinking it once playback is stable.
+     *
+     * @param underrun   - True if the callback ran out of buffers.
+     * @param num_frames - Number of frames the callback played.
+     */
+    void UpdateTargetQueueSize(bool underrun, std::size_t num_frames);
+
 protected:
     /// Core system
     Core::System& system;
@@ -246,6 +283,19 @@ private:
     std::atomic<u32> queued_buffers{};
     /// The ring size for audio out buffers (usually 4, rarely 2 or 8)
     u32 max_queue_size{};
+    /// Number of buffers WaitFreeSpace lets queue up, adapted to the underruns
+    std::atomic<u32> target_queue_size{};
+    /// Frames played since the last underrun or target queue size change
+    u64 stable_frames{};
+    /// Frames to play without an underrun before lowering the target queue size, doubled by
+    /// every underrun so a target which is too low is not retried too often
+    u64 required_stable_frames{TargetSampleRate * 2};
+    /// Set while the callback is out of buffers, so a long starvation counts as one underrun
+    bool starved{true};
+    /// Number of times the callback ran out of buffers while playing
+    std::atomic<u64> underrun_count{};
+    /// Number of frames dropped to correct drift
+    std::atomic<u64> dropped_frame_count{};
     /// Locks access to sample count tracking info
     std::mutex sample_count_lock;
     /// Minimum number of total samples that have been played since the last callback
@@ -261,6 +311,8 @@ private:
     /// Signalled when ring buffer entries are consumed
     std::condition_variable_any release_cv;
     std::mutex release_mutex;
+    /// Set while WaitFreeSpace is waiting on release_cv
+    std::atomic<bool> waiting_for_space{};
 };
 
 using SinkStreamPtr = std::unique_ptr<SinkStream>;
@@ -0,0 +1,409 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Replays audio renderer updates recorded with dump_audio_renderer_updates through
+// System::Update, the command generator and the CommandListProcessor, into a NullSink, reporting
+// the time taken by each type of command and how much faster than real time the frames render.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "audio_core/adsp/apps/audio_renderer/audio_renderer.h"
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/common/audio_renderer_parameter.h"
+#include "audio_core/renderer/behavior/behavior_info.h"
+#include "audio_core/renderer/command/command_generator.h"
+#include "audio_core/renderer/command/icommand.h"
+#include "audio_core/renderer/system.h"
+#include "audio_core/renderer/update_recorder.h"
+#include "audio_core/sink/null_sink.h"
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/hle/kernel/k_event.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/k_scoped_resource_reservation.h"
+#include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/k_transfer_memory.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/memory.h"
+
+using namespace AudioCore;
+using namespace AudioCore::Renderer;
+
+namespace {
+
+constexpr size_t CommandIdCount = static_cast<size_t>(CommandId::Compressor) + 1;
+
+struct CommandProfile {
+    u64 count;
+    std::chrono::nanoseconds time;
+    u64 estimated_time;
+};
+
+using CommandProfiles = std::array<CommandProfile, CommandIdCount>;
+
+const char* GetCommandName(CommandId id) {
+    switch (id) {
+    case CommandId::DataSourcePcmInt16Version1:
+        return "DataSourcePcmInt16Version1";
+    case CommandId::DataSourcePcmInt16Version2:
+        return "DataSourcePcmInt16Version2";
+    case CommandId::DataSourcePcmFloatVersion1:
+        return "DataSourcePcmFloatVersion1";
+    case CommandId::DataSourcePcmFloatVersion2:
+        return "DataSourcePcmFloatVersion2";
+    case CommandId::DataSourceAdpcmVersion1:
+        return "DataSourceAdpcmVersion1";
+    case CommandId::DataSourceAdpcmVersion2:
+        return "DataSourceAdpcmVersion2";
+    case CommandId::Volume:
+        return "Volume";
+    case CommandId::VolumeRamp:
+        return "VolumeRamp";
+    case CommandId::BiquadFilter:
+        return "BiquadFilter";
+    case CommandId::Mix:
+        return "Mix";
+    case CommandId::MixRamp:
+        return "MixRamp";
+    case CommandId::MixRampGrouped:
+        return "MixRampGrouped";
+    case CommandId::DepopPrepare:
+        return "DepopPrepare";
+    case CommandId::DepopForMixBuffers:
+        return "DepopForMixBuffers";
+    case CommandId::Delay:
+        return "Delay";
+    case CommandId::Upsample:
+        return "Upsample";
+    case CommandId::DownMix6chTo2ch:
+        return "DownMix6chTo2ch";
+    case CommandId::Aux:
+        return "Aux";
+    case CommandId::DeviceSink:
+        return "DeviceSink";
+    case CommandId::CircularBufferSink:
+        return "CircularBufferSink";
+    case CommandId::Reverb:
+        return "Reverb";
+    case CommandId::I3dl2Reverb:
+        return "I3dl2Reverb";
+    case CommandId::Performance:
+        return "Performance";
+    case CommandId::ClearMixBuffer:
+        return "ClearMixBuffer";
+    case CommandId::CopyMixBuffer:
+        return "CopyMixBuffer";
+    case CommandId::LightLimiterVersion1:
+        return "LightLimiterVersion1";
+    case CommandId::LightLimiterVersion2:
+        return "LightLimiterVersion2";
+    case CommandId::MultiTapBiquadFilter:
+        return "MultiTapBiquadFilter";
+    case CommandId::Capture:
+        return "Capture";
+    case CommandId::Compressor:
+        return "Compressor";
+    default:
+        return "Invalid";
+    }
+}
+
+FileSys::ProgramAddressSpaceType GetAddressSpaceType(u32 address_space_width) {
+    switch (address_space_width) {
+    case 39:
+        return FileSys::ProgramAddressSpaceType::Is39Bit;
+    case 36:
+        return FileSys::ProgramAddressSpaceType::Is36Bit;
+    default:
+        return FileSys::ProgramAddressSpaceType::Is32Bit;
+    }
+}
+
+/**
+ * Replays a recording in a process laid out like the one it was recorded from, with the recorded
+ * memory pools mapped at the addresses the updates refer to.
+ */
+class Replayer {
+public:
+    explicit Replayer(const UpdateRecording& recording_) : recording{recording_} {
+        system.Initialize();
+        kernel.Initialize();
+    }
+
+    ~Replayer() {
+        if (process) {
+            process->Close();
+        }
+        kernel.Shutdown();
+    }
+
+    /**
+     * Replay the recording on a thread of the replay process, as the kernel expects.
+     *
+     * @return True if every frame was replayed.
+     */
+    bool Run() {
+        const auto& header{recording.header};
+        FileSys::ProgramMetadata metadata{FileSys::ProgramMetadata::GetDefault()};
+        // Allow use of cores 0~3 and thread priorities 16~63.
+        metadata.LoadManual(header.is_64bit, GetAddressSpaceType(header.address_space_width),
+                            0x2c, 0, 0x100000, 0, 0xFFFFFFFFFFFFFFFF, 0, {0x30043F7});
+
+        process = Kernel::KProcess::Create(kernel);
+        if (R_FAILED(process->LoadFromMetadata(metadata, Kernel::PageSize, 0, false))) {
+            LOG_ERROR(Audio, "Failed to create the replay process");
+            return false;
+        }
+        Kernel::KProcess::Register(kernel, process);
+
+        Kernel::KScopedResourceReservation thread_reservation(
+            process, Kernel::LimitableResource::ThreadCountMax);
+        Kernel::KThread* thread = Kernel::KThread::Create(kernel);
+        if (!thread_reservation.Succeeded() ||
+            R_FAILED(Kernel::KThread::InitializeDummyThread(thread, process))) {
+            LOG_ERROR(Audio, "Failed to create the replay thread");
+            return false;
+        }
+        thread_reservation.Commit();
+        Kernel::KThread::Register(kernel, thread);
+
+        bool success{};
+        std::jthread([&] {
+            kernel.RegisterHostThread(thread);
+            success = MapPools() && Replay();
+            thread->Close();
+        }).join();
+        return success;
+    }
+
+    void PrintReport() const {
+        if (frame_count == 0) {
+            return;
+        }
+
+        std::chrono::nanoseconds total_time{};
+        for (size_t id = 0; id < profiles.size(); id++) {
+            const auto& profile{profiles[id]};
+            if (profile.count == 0) {
+                continue;
+            }
+            total_time += profile.time;
+            fmt::print("{:<28} {:>9} commands {:>10.0f} ns measured {:>8} estimated per command\n",
+                       GetCommandName(static_cast<CommandId>(id)), profile.count,
+                       static_cast<f64>(profile.time.count()) / static_cast<f64>(profile.count),
+                       profile.estimated_time / profile.count);
+        }
+
+        const auto& params{recording.header.params};
+        const std::chrono::duration<f64> audio_time{static_cast<f64>(frame_count) *
+                                                    params.sample_count / params.sample_rate};
+        const std::chrono::duration<f64> render_time{total_time};
+        const std::chrono::duration<f64> host_time{update_time + generate_time};
+        fmt::print("{} frames, {:.3f} s of audio\n", frame_count, audio_time.count());
+        fmt::print("Update {:.3f} ms and command generation {:.3f} ms per frame\n",
+                   update_time.count() / 1e6 / frame_count,
+                   generate_time.count() / 1e6 / frame_count);
+        fmt::print("Real-time factor: {:.1f}x for the commands, {:.1f}x with the host side\n",
+                   audio_time / render_time, audio_time / (render_time + host_time));
+    }
+
+private:
+    /// Map the recorded pools where the updates expect them, merging pools sharing pages.
+    bool MapPools() {
+        std::map<u64, u64> ranges;
+        for (const auto& [address, size] : recording.pools) {
+            u64 start{Common::AlignDown(address, Kernel::PageSize)};
+            u64 end{Common::AlignUp(address + size, Kernel::PageSize)};
+            auto it{ranges.upper_bound(start)};
+            if (it != ranges.begin() && std::prev(it)->second >= start) {
+                --it;
+            }
+            while (it != ranges.end() && it->first <= end) {
+                start = std::min(start, it->first);
+                end = std::max(end, it->second);
+                it = ranges.erase(it);
+            }
+            ranges.emplace(start, end);
+        }
+
+        auto& page_table{process->GetPageTable()};
+        const auto is_in_region = [](u64 start, u64 end, Kernel::KProcessAddress region_start,
+                                     size_t region_size) {
+            return start >= GetInteger(region_start) &&
+                   end <= GetInteger(region_start) + region_size;
+        };
+        for (const auto& [start, end] : ranges) {
+            // The region the title had the pool in may differ from the one of the same
+            // addresses here, so pick a state which the region at that address accepts.
+            auto state{Kernel::KMemoryState::Shared};
+            if (is_in_region(start, end, page_table.GetHeapRegionStart(),
+                             page_table.GetHeapRegionSize())) {
+                state = Kernel::KMemoryState::Normal;
+            } else if (is_in_region(start, end, page_table.GetAliasRegionStart(),
+                                    page_table.GetAliasRegionSize())) {
+                state = Kernel::KMemoryState::Ipc;
+            }
+            if (R_FAILED(page_table.MapPages(start, (end - start) / Kernel::PageSize, state,
+                                             Kernel::KMemoryPermission::UserReadWrite))) {
+                LOG_ERROR(Audio, "Failed to map the memory pool at {:016X}-{:016X}", start, end);
+                return false;
+            }
+        }
+
+        // The transfer memory only has to exist, the renderer allocates its workbuffers itself.
+        const auto transfer_memory_size{
+            Common::AlignUp(recording.header.transfer_memory_size, Kernel::PageSize)};
+        Kernel::KProcessAddress transfer_memory_address{};
+        if (R_FAILED(page_table.MapPages(std::addressof(transfer_memory_address),
+                                         transfer_memory_size / Kernel::PageSize,
+                                         Kernel::KMemoryState::Normal,
+                                         Kernel::KMemoryPermission::UserReadWrite))) {
+            LOG_ERROR(Audio, "Failed to map the transfer memory");
+            return false;
+        }
+        transfer_memory = Kernel::KTransferMemory::Create(kernel);
+        if (R_FAILED(transfer_memory->Initialize(transfer_memory_address, transfer_memory_size,
+                                                 Kernel::Svc::MemoryPermission::None))) {
+            LOG_ERROR(Audio, "Failed to create the transfer memory");
+            return false;
+        }
+        Kernel::KTransferMemory::Register(kernel, transfer_memory);
+        return true;
+    }
+
+    bool Replay() {
+        rendered_event = Kernel::KEvent::Create(kernel);
+        rendered_event->Initialize(process);
+        Kernel::KEvent::Register(kernel, rendered_event);
+
+        Sink::NullSink sink{""};
+        ADSP::AudioRenderer::AudioRenderer adsp{system, sink};
+        auto* stream{sink.AcquireSinkStream(system, 2, "AudioRendererReplay",
+                                            Sink::StreamType::Render)};
+
+        // Auto mode sends the command lists to the core's ADSP, here they are processed below.
+        auto params{recording.header.params};
+        params.execution_mode = ExecutionMode::Manual;
+
+        Renderer::System renderer{system, adsp, rendered_event};
+        const auto result{renderer.Initialize(params, transfer_memory,
+                                              recording.header.transfer_memory_size, process, 0,
+                                              0)};
+        if (result.IsError()) {
+            LOG_ERROR(Audio, "Failed to initialize the renderer, error {:08X}", result.raw);
+            return false;
+        }
+        renderer.Start();
+
+        BehaviorInfo behavior{};
+        behavior.SetUserLibRevision(params.revision);
+        std::vector<u8> command_list(CommandGenerator::CalculateCommandBufferSize(behavior, params));
+        std::vector<u8> performance;
+        std::vector<u8> output;
+        ADSP::AudioRenderer::CommandListProcessor processor{};
+
+        for (const auto& frame : recording.frames) {
+            performance.assign(frame.performance_size, 0);
+            output.assign(frame.output_size, 0);
+
+            const auto update_start{std::chrono::steady_clock::now()};
+            const auto update_result{renderer.Update(frame.input, performance, output)};
+            update_time += std::chrono::steady_clock::now() - update_start;
+            if (update_result.IsError()) {
+                LOG_ERROR(Audio, "Update {} failed, error {:08X}", frame_count,
+                          update_result.raw);
+                break;
+            }
+
+            for (const auto& memory : frame.memory) {
+                process->GetMemory().WriteBlock(memory.address, memory.data.data(),
+                                                memory.data.size());
+            }
+
+            const auto generate_start{std::chrono::steady_clock::now()};
+            const auto command_size{renderer.GenerateCommand(command_list, command_list.size())};
+            generate_time += std::chrono::steady_clock::now() - generate_start;
+
+            processor.Initialize(system, *process, CpuAddr(command_list.data()), command_size,
+                                 stream);
+            ProcessCommands(processor);
+            frame_count++;
+        }
+
+        renderer.Stop();
+        renderer.Finalize();
+        rendered_event->Close();
+        transfer_memory->Close();
+        return frame_count == recording.frames.size();
+    }
+
+    /// Process a command list as the ADSP does, timing each command.
+    void ProcessCommands(ADSP::AudioRenderer::CommandListProcessor& processor) {
+        auto* commands{processor.commands};
+        for (u32 index = 0; index < processor.command_count; index++) {
+            auto& command{*reinterpret_cast<ICommand*>(commands)};
+            if (command.magic != CommandMagic || !command.Verify(processor)) {
+                break;
+            }
+
+            if (command.enabled) {
+                const auto start_time{std::chrono::steady_clock::now()};
+                command.Process(processor);
+                auto& profile{profiles[static_cast<size_t>(command.type)]};
+                profile.count++;
+                profile.time += std::chrono::steady_clock::now() - start_time;
+                profile.estimated_time += command.estimated_process_time;
+            }
+            commands += command.size;
+        }
+    }
+
+    const UpdateRecording& recording;
+    Core::System system;
+    Kernel::KernelCore& kernel{system.Kernel()};
+    Kernel::KProcess* process{};
+    Kernel::KTransferMemory* transfer_memory{};
+    Kernel::KEvent* rendered_event{};
+    CommandProfiles profiles{};
+    std::chrono::nanoseconds update_time{};
+    std::chrono::nanoseconds generate_time{};
+    u64 frame_count{};
+};
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+
+    if (argc != 2) {
+        fmt::print(stderr, "Usage: {} <recording>\n", argv[0]);
+        return 1;
+    }
+
+    const auto recording{ReadUpdateRecording(argv[1])};
+    if (!recording) {
+        fmt::print(stderr, "Could not read the audio renderer recording {}\n", argv[1]);
+        return 1;
+    }
+
+    Replayer replayer{*recording};
+    const bool success{replayer.Run()};
+    replayer.PrintReport();
+    return success ? 0 : 1;
+}
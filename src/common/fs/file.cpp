@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "common/fs/file.h"
@@ -13,7 +15,10 @@
 #ifdef _WIN32
 #include <io.h>
 #include <share.h>
+#include <windows.h>
 #else
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -318,6 +323,91 @@ size_t IOFile::WriteString(std::span<const char> string) const {
     return WriteSpan(string);
 }
 
+size_t IOFile::ReadAt(std::span<u8> data, u64 offset) const {
+    if (!IsOpen()) {
+        return 0;
+    }
+
+    size_t total_read = 0;
+    while (total_read < data.size()) {
+        const u64 cur_offset = offset + total_read;
+        const size_t remaining = data.size() - total_read;
+
+#ifdef _WIN32
+        // Reads of synchronous handles with an OVERLAPPED offset are positional.
+        const auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(fileno(file)));
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(cur_offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(cur_offset >> 32);
+
+        DWORD bytes_read = 0;
+        const auto to_read = static_cast<DWORD>(std::min<size_t>(remaining, 0x40000000));
+        if (!ReadFile(handle, data.data() + total_read, to_read, &bytes_read, &overlapped) ||
+            bytes_read == 0) {
+            break;
+        }
+#else
+        const auto bytes_read =
+            pread(fileno(file), data.data() + total_read, remaining, static_cast<off_t>(cur_offset));
+        if (bytes_read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes_read <= 0) {
+            break;
+        }
+#endif
+
+        total_read += static_cast<size_t>(bytes_read);
+    }
+
+    return total_read;
+}
+
+bool IOFile::Prefetch(u64 offset, u64 size) const {
+    if (!IsOpen()) {
+        return false;
+    }
+
+#if defined(__linux__)
+    return posix_fadvise(fileno(file), static_cast<off_t>(offset), static_cast<off_t>(size),
+                         POSIX_FADV_WILLNEED) == 0;
+#else
+    return false;
+#endif
+}
+
+size_t IOFile::CopyRangeFrom(const IOFile& src, u64 src_offset, u64 offset, u64 size) const {
+    if (!IsOpen() || !src.IsOpen()) {
+        return 0;
+    }
+
+#if defined(__linux__) && !defined(ANDROID)
+    // Data buffered for writing would otherwise land on top of the copied range later.
+    if (std::fflush(file) != 0) {
+        return 0;
+    }
+
+    auto in_offset = static_cast<off64_t>(src_offset);
+    auto out_offset = static_cast<off64_t>(offset);
+    size_t total_copied = 0;
+    while (total_copied < size) {
+        const auto copied = copy_file_range(fileno(src.file), &in_offset, fileno(file), &out_offset,
+                                            static_cast<size_t>(size - total_copied), 0);
+        if (copied < 0 && errno == EINTR) {
+            continue;
+        }
+        if (copied <= 0) {
+            break;
+        }
+        total_copied += static_cast<size_t>(copied);
+    }
+
+    return total_copied;
+#else
+    return 0;
+#endif
+}
+
 bool IOFile::Flush() const {
     if (!IsOpen()) {
         return false;
@@ -452,4 +542,86 @@ s64 IOFile::Tell() const {
     return ftello(file);
 }
 
+FileMapping::FileMapping() = default;
+
+FileMapping::FileMapping(const IOFile& file) {
+    if (!file.IsOpen()) {
+        return;
+    }
+
+    const auto file_size = file.GetSize();
+    if (file_size == 0 || file_size > std::numeric_limits<size_t>::max()) {
+        return;
+    }
+
+#ifdef _WIN32
+    const auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(fileno(file.file)));
+    const auto mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        LOG_ERROR(Common_Filesystem, "Failed to create a mapping of the file at path={}",
+                  PathToUTF8String(file.file_path));
+        return;
+    }
+
+    // The view keeps the mapping object alive on its own.
+    const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        LOG_ERROR(Common_Filesystem, "Failed to map a view of the file at path={}",
+                  PathToUTF8String(file.file_path));
+        return;
+    }
+#else
+    const auto view = mmap(nullptr, static_cast<size_t>(file_size), PROT_READ, MAP_SHARED,
+                           fileno(file.file), 0);
+    if (view == MAP_FAILED) {
+        const auto ec = std::error_code{errno, std::generic_category()};
+        LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}, ec_message={}",
+                  PathToUTF8String(file.file_path), ec.message());
+        return;
+    }
+#endif
+
+    data = static_cast<const u8*>(view);
+    size = static_cast<size_t>(file_size);
+}
+
+FileMapping::~FileMapping() {
+    Unmap();
+}
+
+FileMapping::FileMapping(FileMapping&& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+}
+
+FileMapping& FileMapping::operator=(FileMapping&& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+    return *this;
+}
+
+bool FileMapping::IsMapped() const {
+    return data != nullptr;
+}
+
+std::span<const u8> FileMapping::GetSpan() const {
+    return {data, size};
+}
+
+void FileMapping::Unmap() {
+    if (!IsMapped()) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<u8*>(data), size);
+#endif
+
+    data = nullptr;
+    size = 0;
+}
+
 } // namespace Common::FS
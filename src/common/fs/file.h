@@ -391,6 +391,47 @@ public:
      */
     [[nodiscard]] size_t WriteString(std::span<const char> string) const;
 
+    /**
+     * Reads a span of bytes from the specified offset of the file.
+     * Unlike ReadSpan, this does not depend on the file pointer and bypasses the buffering of the
+     * file, so several threads may read concurrently. Data written to the file must be flushed
+     * before it can be read this way, and the file pointer must be set with Seek before the next
+     * sequential access.
+     *
+     * @param data Span of bytes to read into
+     * @param offset Offset from the start of the file
+     *
+     * @returns Count of bytes successfully read.
+     */
+    [[nodiscard]] size_t ReadAt(std::span<u8> data, u64 offset) const;
+
+    /**
+     * Hints to the OS that the specified range of the file will be read soon, allowing it to
+     * read the range into its cache in the background.
+     *
+     * @param offset Offset from the start of the file
+     * @param size Size of the range in bytes
+     *
+     * @returns True if the hint was issued, false if it is not supported on this platform.
+     */
+    bool Prefetch(u64 offset, u64 size) const;
+
+    /**
+     * Copies a range of another file into this file within the OS, without passing the data
+     * through user memory. Filesystems supporting it may share the underlying blocks between both
+     * files instead of duplicating them.
+     *
+     * @param src File to copy from
+     * @param src_offset Offset from the start of the source file
+     * @param offset Offset from the start of this file
+     * @param size Size of the range in bytes
+     *
+     * @returns Count of bytes successfully copied, which is 0 if this is not supported on this
+     * platform or between these files.
+     */
+    [[nodiscard]] size_t CopyRangeFrom(const IOFile& src, u64 src_offset, u64 offset,
+                                       u64 size) const;
+
     /**
      * Attempts to flush any unwritten buffered data into the file.
      *
@@ -449,6 +490,8 @@ public:
     [[nodiscard]] s64 Tell() const;
 
 private:
+    friend class FileMapping;
+
     std::filesystem::path file_path;
     FileAccessMode file_access_mode{};
     FileType file_type{};
@@ -456,4 +499,50 @@ private:
     std::FILE* file = nullptr;
 };
 
+/**
+ * A read-only mapping of the whole contents of a file into memory.
+ * The mapping stays valid after the file it was created from is closed, but its contents are
+ * unspecified if the file is modified or truncated while it is mapped.
+ */
+class FileMapping final {
+public:
+    FileMapping();
+
+    /**
+     * Maps the contents of an open file into memory.
+     * Use IsMapped() to check whether the mapping succeeded. Empty files are never mapped.
+     *
+     * @param file Open file to map
+     */
+    explicit FileMapping(const IOFile& file);
+
+    ~FileMapping();
+
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    FileMapping(FileMapping&& other) noexcept;
+    FileMapping& operator=(FileMapping&& other) noexcept;
+
+    /**
+     * Checks whether the file is mapped.
+     *
+     * @returns True if the file is mapped, false otherwise.
+     */
+    [[nodiscard]] bool IsMapped() const;
+
+    /**
+     * Gets a view of the mapped contents of the file.
+     *
+     * @returns The mapped contents, or an empty span if the file is not mapped.
+     */
+    [[nodiscard]] std::span<const u8> GetSpan() const;
+
+private:
+    void Unmap();
+
+    const u8* data = nullptr;
+    size_t size = 0;
+};
+
 } // namespace Common::FS
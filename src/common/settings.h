@@ -189,6 +189,12 @@ struct Values {
         linkage, false, "audio_muted", Category::Audio, Specialization::Default, true, true};
     Setting<bool, false> dump_audio_commands{
         linkage, false, "dump_audio_commands", Category::Audio, Specialization::Default, false};
+    Setting<bool, false> dump_audio_renderer_updates{linkage,
+                                                     false,
+                                                     "dump_audio_renderer_updates",
+                                                     Category::Audio,
+                                                     Specialization::Default,
+                                                     false};
 
     // Core
     SwitchableSetting<bool> use_multi_core{linkage, true, "use_multi_core", Category::Core};
@@ -210,6 +216,9 @@ struct Values {
                                              true,
                                              true,
                                              &use_speed_limit};
+    SwitchableSetting<bool> use_adaptive_spin_yield{linkage, false, "use_adaptive_spin_yield",
+                                                    Category::Core};
+    SwitchableSetting<bool> use_jit_warmup{linkage, false, "use_jit_warmup", Category::Core};
 
     // Cpu
     SwitchableSetting<CpuBackend, true> cpu_backend{linkage,
@@ -294,6 +303,8 @@ struct Values {
         true};
     SwitchableSetting<NvdecEmulation> nvdec_emulation{linkage, NvdecEmulation::Gpu,
                                                       "nvdec_emulation", Category::Renderer};
+    SwitchableSetting<bool> nvdec_frame_threading{linkage, false, "nvdec_frame_threading",
+                                                   Category::Renderer};
     // *nix platforms may have issues with the borderless windowed fullscreen mode.
     // Default to exclusive fullscreen on these platforms for now.
     SwitchableSetting<FullscreenMode, true> fullscreen_mode{linkage,
@@ -566,6 +577,7 @@ struct Values {
     // Data Storage
     Setting<bool> use_virtual_sd{linkage, true, "use_virtual_sd", Category::DataStorage};
     Setting<bool> gamecard_inserted{linkage, false, "gamecard_inserted", Category::DataStorage};
+    Setting<bool> savedata_write_back{linkage, true, "savedata_write_back", Category::DataStorage};
     Setting<bool> gamecard_current_game{linkage, false, "gamecard_current_game",
                                         Category::DataStorage};
     Setting<std::string> gamecard_path{linkage, std::string(), "gamecard_path",
@@ -584,6 +596,10 @@ struct Values {
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
+    Setting<bool> enable_guest_profiler{linkage, false, "enable_guest_profiler",
+                                        Category::Debugging};
+    Setting<u16> guest_profiler_interval_us{linkage, 1000, "guest_profiler_interval_us",
+                                           Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
     Setting<bool> quest_flag{linkage, false, "quest_flag", Category::Debugging};
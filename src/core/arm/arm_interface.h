@@ -35,6 +35,7 @@ enum class HaltReason : u64 {
     BreakLoop = 0x02000000,
     SupervisorCall = 0x04000000,
     InstructionBreakpoint = 0x08000000,
+    ProfileSample = 0x10000000,
     PrefetchAbort = 0x20000000,
 };
 DECLARE_ENUM_FLAG_OPERATORS(HaltReason);
@@ -94,6 +95,15 @@ public:
     // It is safe to call this if the CPU is not running.
     virtual void SignalInterrupt(Kernel::KThread* thread) = 0;
 
+    // Signal for execution to halt briefly so that the guest context can be sampled.
+    // Backends which cannot support this ignore the request.
+    virtual void SignalProfileSample() {}
+
+    // Translate the guest code blocks at the given addresses ahead of their first execution.
+    // Must be called from the thread of the core, while no guest code is running on it.
+    // Backends which cannot support this ignore the request.
+    virtual void WarmUpTranslation(std::span<const u64> addresses) {}
+
     // Stack trace generation.
     void LogBacktrace(Kernel::KProcess* process) const;
 
@@ -79,59 +79,20 @@ constexpr std::array<u64, 2> SegmentBases{
     0x7100000000ULL,
 };
 
-void SymbolicateBacktrace(Kernel::KProcess* process, std::vector<BacktraceEntry>& out) {
-    auto modules = FindModules(process);
-
-    const bool is_64 = process->Is64Bit();
-
-    std::map<std::string, Symbols::Symbols> symbols;
-    for (const auto& module : modules) {
-        symbols.insert_or_assign(module.second,
-                                 Symbols::GetSymbols(module.first, process->GetMemory(), is_64));
-    }
-
-    for (auto& entry : out) {
-        VAddr base = 0;
-        for (auto iter = modules.rbegin(); iter != modules.rend(); ++iter) {
-            const auto& module{*iter};
-            if (entry.original_address >= module.first) {
-                entry.module = module.second;
-                base = module.first;
-                break;
-            }
-        }
-
-        entry.offset = entry.original_address - base;
-        entry.address = SegmentBases[is_64] + entry.offset;
-
-        if (entry.module.empty()) {
-            entry.module = "unknown";
-        }
-
-        const auto symbol_set = symbols.find(entry.module);
-        if (symbol_set != symbols.end()) {
-            const auto symbol = Symbols::GetSymbolName(symbol_set->second, entry.offset);
-            if (symbol) {
-                entry.name = Common::DemangleSymbol(*symbol);
-            }
-        }
-    }
-}
-
-std::vector<BacktraceEntry> GetAArch64Backtrace(Kernel::KProcess* process,
-                                                const Kernel::Svc::ThreadContext& ctx) {
-    std::vector<BacktraceEntry> out;
+std::vector<u64> GetAArch64RawBacktrace(Kernel::KProcess* process,
+                                        const Kernel::Svc::ThreadContext& ctx, size_t max_depth) {
+    std::vector<u64> out;
     auto& memory = process->GetMemory();
     auto pc = ctx.pc, lr = ctx.lr, fp = ctx.fp;
 
-    out.push_back({"", 0, pc, 0, ""});
+    out.push_back(pc);
 
     // fp (= x29) points to the previous frame record.
     // Frame records are two words long:
     // fp+0 : pointer to previous frame record
     // fp+8 : value of lr for frame
-    for (size_t i = 0; i < 256; i++) {
-        out.push_back({"", 0, lr, 0, ""});
+    for (size_t i = 0; i < max_depth; i++) {
+        out.push_back(lr);
         if (!fp || (fp % 4 != 0) || !memory.IsValidVirtualAddressRange(fp, 16)) {
             break;
         }
@@ -139,25 +100,23 @@ std::vector<BacktraceEntry> GetAArch64Backtrace(Kernel::KProcess* process,
         fp = memory.Read64(fp);
     }
 
-    SymbolicateBacktrace(process, out);
-
     return out;
 }
 
-std::vector<BacktraceEntry> GetAArch32Backtrace(Kernel::KProcess* process,
-                                                const Kernel::Svc::ThreadContext& ctx) {
-    std::vector<BacktraceEntry> out;
+std::vector<u64> GetAArch32RawBacktrace(Kernel::KProcess* process,
+                                        const Kernel::Svc::ThreadContext& ctx, size_t max_depth) {
+    std::vector<u64> out;
     auto& memory = process->GetMemory();
     auto pc = ctx.pc, lr = ctx.lr, fp = ctx.fp;
 
-    out.push_back({"", 0, pc, 0, ""});
+    out.push_back(pc);
 
     // fp (= r11) points to the last frame record.
     // Frame records are two words long:
     // fp+0 : pointer to previous frame record
     // fp+4 : value of lr for frame
-    for (size_t i = 0; i < 256; i++) {
-        out.push_back({"", 0, lr, 0, ""});
+    for (size_t i = 0; i < max_depth; i++) {
+        out.push_back(lr);
         if (!fp || (fp % 4 != 0) || !memory.IsValidVirtualAddressRange(fp, 8)) {
             break;
         }
@@ -165,8 +124,6 @@ std::vector<BacktraceEntry> GetAArch32Backtrace(Kernel::KProcess* process,
         fp = memory.Read32(fp);
     }
 
-    SymbolicateBacktrace(process, out);
-
     return out;
 }
 
@@ -337,13 +294,65 @@ void InvalidateInstructionCacheRange(const Kernel::KProcess* process, u64 addres
     }
 }
 
-std::vector<BacktraceEntry> GetBacktraceFromContext(Kernel::KProcess* process,
-                                                    const Kernel::Svc::ThreadContext& ctx) {
+void SymbolicateBacktrace(Kernel::KProcess* process, std::vector<BacktraceEntry>& out) {
+    auto modules = FindModules(process);
+
+    const bool is_64 = process->Is64Bit();
+
+    std::map<std::string, Symbols::Symbols> symbols;
+    for (const auto& module : modules) {
+        symbols.insert_or_assign(module.second,
+                                 Symbols::GetSymbols(module.first, process->GetMemory(), is_64));
+    }
+
+    for (auto& entry : out) {
+        VAddr base = 0;
+        for (auto iter = modules.rbegin(); iter != modules.rend(); ++iter) {
+            const auto& module{*iter};
+            if (entry.original_address >= module.first) {
+                entry.module = module.second;
+                base = module.first;
+                break;
+            }
+        }
+
+        entry.offset = entry.original_address - base;
+        entry.address = SegmentBases[is_64] + entry.offset;
+
+        if (entry.module.empty()) {
+            entry.module = "unknown";
+        }
+
+        const auto symbol_set = symbols.find(entry.module);
+        if (symbol_set != symbols.end()) {
+            const auto symbol = Symbols::GetSymbolName(symbol_set->second, entry.offset);
+            if (symbol) {
+                entry.name = Common::DemangleSymbol(*symbol);
+            }
+        }
+    }
+}
+
+std::vector<u64> GetRawBacktraceFromContext(Kernel::KProcess* process,
+                                            const Kernel::Svc::ThreadContext& ctx,
+                                            size_t max_depth) {
     if (process->Is64Bit()) {
-        return GetAArch64Backtrace(process, ctx);
+        return GetAArch64RawBacktrace(process, ctx, max_depth);
     } else {
-        return GetAArch32Backtrace(process, ctx);
+        return GetAArch32RawBacktrace(process, ctx, max_depth);
+    }
+}
+
+std::vector<BacktraceEntry> GetBacktraceFromContext(Kernel::KProcess* process,
+                                                    const Kernel::Svc::ThreadContext& ctx) {
+    std::vector<BacktraceEntry> out;
+    for (const u64 address : GetRawBacktraceFromContext(process, ctx)) {
+        out.push_back({"", 0, address, 0, ""});
     }
+
+    SymbolicateBacktrace(process, out);
+
+    return out;
 }
 
 std::vector<BacktraceEntry> GetBacktrace(const Kernel::KThread* thread) {
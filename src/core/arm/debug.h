@@ -28,6 +28,11 @@ struct BacktraceEntry {
     std::string name;
 };
 
+std::vector<u64> GetRawBacktraceFromContext(Kernel::KProcess* process,
+                                            const Kernel::Svc::ThreadContext& ctx,
+                                            size_t max_depth = 256);
+void SymbolicateBacktrace(Kernel::KProcess* process, std::vector<BacktraceEntry>& out);
+
 std::vector<BacktraceEntry> GetBacktraceFromContext(Kernel::KProcess* process,
                                                     const Kernel::Svc::ThreadContext& ctx);
 std::vector<BacktraceEntry> GetBacktrace(const Kernel::KThread* thread);
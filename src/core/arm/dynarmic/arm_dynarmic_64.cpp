@@ -1,10 +1,14 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <thread>
+
 #include "common/settings.h"
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #include "core/arm/dynarmic/arm_dynarmic_64.h"
 #include "core/arm/dynarmic/dynarmic_exclusive_monitor.h"
+#include "core/arm/translation_profile.h"
+#include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_process.h"
 
@@ -13,6 +17,33 @@ namespace Core {
 using Vector = Dynarmic::A64::Vector;
 using namespace Common::Literals;
 
+namespace {
+
+// Returns whether the instruction is a branch or an exception generating instruction, either of
+// which ends the block being translated.
+constexpr bool IsBlockTerminator(u32 instruction) {
+    // B, BL
+    if ((instruction & 0x7C000000) == 0x14000000) {
+        return true;
+    }
+    // B.cond
+    if ((instruction & 0xFF000010) == 0x54000000) {
+        return true;
+    }
+    // CBZ, CBNZ, TBZ, TBNZ
+    if ((instruction & 0x7C000000) == 0x34000000) {
+        return true;
+    }
+    // SVC, HVC, SMC, BRK, HLT, DCPS
+    if ((instruction & 0xFF000000) == 0xD4000000) {
+        return true;
+    }
+    // BR, BLR, RET, ERET, DRPS and their pointer authenticated forms
+    return (instruction & 0xFE000000) == 0xD6000000;
+}
+
+} // Anonymous namespace
+
 class DynarmicCallbacks64 : public Dynarmic::A64::UserCallbacks {
 public:
     explicit DynarmicCallbacks64(ArmDynarmic64& parent, Kernel::KProcess* process)
@@ -45,7 +76,20 @@ public:
         if (!m_memory.IsValidVirtualAddressRange(vaddr, sizeof(u32))) {
             return std::nullopt;
         }
-        return m_memory.Read32(vaddr);
+
+        const u32 instruction = m_memory.Read32(vaddr);
+
+        // Instructions of a block are read in order and a block ends at its first branch, so
+        // a non-sequential read, or a read following a branch, starts a block.
+        auto& translation_profile = m_parent.m_system.GetTranslationProfile();
+        if (translation_profile.IsRecording() &&
+            (vaddr != m_last_code_read + sizeof(u32) || m_last_code_ended_block)) {
+            translation_profile.RecordBlock(m_process, vaddr);
+        }
+        m_last_code_read = vaddr;
+        m_last_code_ended_block = IsBlockTerminator(instruction);
+
+        return instruction;
     }
 
     void MemoryWrite8(u64 vaddr, u8 value) override {
@@ -128,11 +172,14 @@ public:
 
     void ExceptionRaised(u64 pc, Dynarmic::A64::Exception exception) override {
         switch (exception) {
-        case Dynarmic::A64::Exception::WaitForInterrupt:
         case Dynarmic::A64::Exception::WaitForEvent:
+        case Dynarmic::A64::Exception::Yield:
+            // The guest is spin-waiting, so give our host time to other emulator threads.
+            std::this_thread::yield();
+            return;
+        case Dynarmic::A64::Exception::WaitForInterrupt:
         case Dynarmic::A64::Exception::SendEvent:
         case Dynarmic::A64::Exception::SendEventLocal:
-        case Dynarmic::A64::Exception::Yield:
             return;
         case Dynarmic::A64::Exception::NoExecuteFault:
             LOG_CRITICAL(Core_ARM, "Cannot execute instruction at unmapped address {:#016x}", pc);
@@ -217,6 +264,8 @@ public:
     u64 m_tpidrro_el0{};
     u64 m_tpidr_el0{};
     Kernel::KProcess* m_process{};
+    u64 m_last_code_read{};
+    bool m_last_code_ended_block{};
     const bool m_debugger_enabled{};
     const bool m_check_memory_access{};
     static constexpr u64 MinimumRunCycles = 10000U;
@@ -265,6 +314,10 @@ std::shared_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Common::PageTable* pa
     config.wall_clock_cntpct = m_uses_wall_clock;
     config.enable_cycle_counting = !m_uses_wall_clock;
 
+    // Hint instructions, used to back off the host when the guest spin-waits
+    config.hook_hint_instructions =
+        m_uses_wall_clock && Settings::values.use_adaptive_spin_yield.GetValue();
+
     // Code cache size
 #ifdef ARCHITECTURE_arm64
     config.code_cache_size = 128_MiB;
@@ -466,6 +519,29 @@ void ArmDynarmic64::SignalInterrupt(Kernel::KThread* thread) {
     m_jit->HaltExecution(BreakLoop);
 }
 
+void ArmDynarmic64::SignalProfileSample() {
+    m_jit->HaltExecution(ProfileSample);
+}
+
+void ArmDynarmic64::WarmUpTranslation(std::span<const u64> addresses) {
+    // Running the JIT would add ticks to the guest clock when it is not using the wall clock.
+    if (!m_uses_wall_clock) {
+        return;
+    }
+
+    ScopedJitExecution sj(m_cb->m_process);
+
+    // Dynarmic translates the block at the current PC before checking for a pending halt on
+    // entry, so running with a halt already requested translates the block without executing it.
+    const u64 pc = m_jit->GetPC();
+    for (const u64 address : addresses) {
+        m_jit->SetPC(address);
+        m_jit->HaltExecution(TranslationWarmup);
+        m_jit->Run();
+    }
+    m_jit->SetPC(pc);
+}
+
 void ArmDynarmic64::ClearInstructionCache() {
     m_jit->ClearCache();
 }
@@ -45,6 +45,8 @@ public:
     u32 GetSvcNumber() const override;
 
     void SignalInterrupt(Kernel::KThread* thread) override;
+    void SignalProfileSample() override;
+    void WarmUpTranslation(std::span<const u64> addresses) override;
     void ClearInstructionCache() override;
     void InvalidateCacheRange(u64 addr, std::size_t size) override;
 
@@ -0,0 +1,263 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "common/common_funcs.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/arm/debug.h"
+#include "core/arm/translation_profile.h"
+#include "core/core.h"
+#include "core/hle/kernel/k_process.h"
+
+namespace Core {
+namespace {
+
+constexpr u32 ProfileMagic = Common::MakeMagic('Y', 'T', 'P', 'F');
+constexpr u32 ProfileVersion = 1;
+
+// Upper bound on the number of recorded blocks, to keep profiles of large titles bounded.
+constexpr std::size_t MaxBlocks = 0x40000;
+
+struct ProfileHeader {
+    u32 magic;
+    u32 version;
+    u64 program_id;
+    std::array<u8, 0x20> build_id;
+    u32 num_modules;
+    u32 reserved;
+};
+static_assert(sizeof(ProfileHeader) == 0x38, "ProfileHeader has incorrect size.");
+
+struct ModuleHeader {
+    u32 name_size;
+    u32 num_blocks;
+};
+static_assert(sizeof(ModuleHeader) == 0x8, "ModuleHeader has incorrect size.");
+
+std::filesystem::path GetProfilePath(u64 program_id) {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "jit" /
+           fmt::format("{:016X}.bin", program_id);
+}
+
+std::vector<TranslationProfileModule> GetModules(Kernel::KProcess* process) {
+    std::vector<TranslationProfileModule> modules;
+    for (const auto& [base, name] : FindModules(process)) {
+        // GetModuleEnd returns the last byte of the module.
+        modules.push_back({
+            .name = name,
+            .base = base,
+            .end = GetInteger(GetModuleEnd(process, base)) + 1,
+        });
+    }
+    return modules;
+}
+
+} // Anonymous namespace
+
+TranslationProfile::TranslationProfile(System& system_) : system{system_} {}
+
+TranslationProfile::~TranslationProfile() = default;
+
+void TranslationProfile::Start(Kernel::KProcess* process_, u64 program_id_) {
+    Stop();
+
+    warmup_ready.store(false, std::memory_order_relaxed);
+    process = process_;
+    program_id = program_id_;
+    build_id = system.GetApplicationProcessBuildID();
+    blocks.clear();
+    block_set.clear();
+    warmup_blocks.clear();
+    warmup_cursors = {};
+
+    Load();
+
+    // Previously recorded blocks are kept, so that blocks which were not reached this session
+    // are not lost from the profile.
+    for (const u64 block : warmup_blocks) {
+        if (block_set.insert(block).second) {
+            blocks.push_back(block);
+        }
+    }
+
+    warmup_ready.store(true, std::memory_order_release);
+    is_recording.store(true, std::memory_order_relaxed);
+}
+
+void TranslationProfile::Stop() {
+    if (!is_recording.exchange(false)) {
+        return;
+    }
+
+    Save();
+}
+
+void TranslationProfile::RecordBlock(const Kernel::KProcess* process_, u64 address) {
+    std::scoped_lock lk{mutex};
+    if (!IsRecording() || process_ != process || blocks.size() >= MaxBlocks) {
+        return;
+    }
+
+    if (block_set.insert(address).second) {
+        blocks.push_back(address);
+    }
+}
+
+bool TranslationProfile::HasPendingBlocks(std::size_t core_index) const {
+    if (!warmup_ready.load(std::memory_order_acquire)) {
+        return false;
+    }
+    return warmup_cursors[core_index] < warmup_blocks.size();
+}
+
+std::size_t TranslationProfile::TakePendingBlocks(std::size_t core_index, std::span<u64> out) {
+    if (!HasPendingBlocks(core_index)) {
+        return 0;
+    }
+
+    auto& cursor = warmup_cursors[core_index];
+    const std::size_t count = std::min(out.size(), warmup_blocks.size() - cursor);
+    std::copy_n(warmup_blocks.begin() + static_cast<std::ptrdiff_t>(cursor), count, out.begin());
+    cursor += count;
+    return count;
+}
+
+void TranslationProfile::Load() {
+    const auto path = GetProfilePath(program_id);
+    warmup_blocks = ReadTranslationProfile(path, program_id, build_id, GetModules(process));
+    if (!warmup_blocks.empty()) {
+        LOG_INFO(Core_ARM, "Loaded {} blocks to warm up from translation profile",
+                 warmup_blocks.size());
+    }
+}
+
+void TranslationProfile::Save() {
+    std::scoped_lock lk{mutex};
+    if (process == nullptr || blocks.empty()) {
+        return;
+    }
+
+    const auto path = GetProfilePath(program_id);
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Core_ARM, "Failed to create translation profile directory");
+        return;
+    }
+
+    if (!WriteTranslationProfile(path, program_id, build_id, GetModules(process), blocks)) {
+        LOG_ERROR(Core_ARM, "Failed to write translation profile {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+
+    LOG_INFO(Core_ARM, "Saved {} translated blocks to translation profile", blocks.size());
+}
+
+bool WriteTranslationProfile(const std::filesystem::path& path, u64 program_id,
+                             const std::array<u8, 0x20>& build_id,
+                             std::span<const TranslationProfileModule> modules,
+                             std::span<const u64> blocks) {
+    // Group the blocks by the module containing them, dropping any outside of a module.
+    std::map<std::size_t, std::vector<u32>> module_blocks;
+    for (const u64 block : blocks) {
+        const auto it = std::ranges::find_if(modules, [block](const auto& module) {
+            return block >= module.base && block < module.end;
+        });
+        if (it != modules.end()) {
+            const auto index = static_cast<std::size_t>(std::distance(modules.begin(), it));
+            module_blocks[index].push_back(static_cast<u32>(block - it->base));
+        }
+    }
+
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return false;
+    }
+
+    const ProfileHeader header{
+        .magic = ProfileMagic,
+        .version = ProfileVersion,
+        .program_id = program_id,
+        .build_id = build_id,
+        .num_modules = static_cast<u32>(module_blocks.size()),
+        .reserved = 0,
+    };
+    bool success = file.WriteObject(header);
+    for (const auto& [index, offsets] : module_blocks) {
+        const auto& name = modules[index].name;
+        const ModuleHeader module_header{
+            .name_size = static_cast<u32>(name.size()),
+            .num_blocks = static_cast<u32>(offsets.size()),
+        };
+        success = success && file.WriteObject(module_header) &&
+                  file.WriteSpan<char>(name) == name.size() &&
+                  file.WriteSpan<u32>(offsets) == offsets.size();
+    }
+    return success;
+}
+
+std::vector<u64> ReadTranslationProfile(const std::filesystem::path& path, u64 program_id,
+                                        const std::array<u8, 0x20>& build_id,
+                                        std::span<const TranslationProfileModule> modules) {
+    std::vector<u64> blocks;
+    if (!Common::FS::Exists(path)) {
+        return blocks;
+    }
+
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return blocks;
+    }
+
+    ProfileHeader header{};
+    if (!file.ReadObject(header) || header.magic != ProfileMagic ||
+        header.version != ProfileVersion || header.program_id != program_id) {
+        LOG_WARNING(Core_ARM, "Ignoring invalid translation profile {}",
+                    Common::FS::PathToUTF8String(path));
+        return blocks;
+    }
+    if (header.build_id != build_id) {
+        // The application was updated, so the recorded offsets no longer apply.
+        LOG_INFO(Core_ARM, "Discarding outdated translation profile for {:016X}", program_id);
+        return blocks;
+    }
+
+    for (u32 i = 0; i < header.num_modules; i++) {
+        ModuleHeader module_header{};
+        if (!file.ReadObject(module_header) || module_header.name_size > 0x200 ||
+            module_header.num_blocks > MaxBlocks) {
+            break;
+        }
+
+        std::string name(module_header.name_size, '\0');
+        std::vector<u32> offsets(module_header.num_blocks);
+        if (file.ReadSpan<char>(name) != name.size() ||
+            file.ReadSpan<u32>(offsets) != offsets.size()) {
+            break;
+        }
+
+        // Relocate the offsets to where the module was loaded this session.
+        const auto it = std::ranges::find(modules, name, &TranslationProfileModule::name);
+        if (it == modules.end()) {
+            continue;
+        }
+        for (const u32 offset : offsets) {
+            const u64 address = it->base + offset;
+            if (address < it->end && blocks.size() < MaxBlocks) {
+                blocks.push_back(address);
+            }
+        }
+    }
+    return blocks;
+}
+
+} // namespace Core
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/hardware_properties.h"
+
+namespace Core {
+class System;
+}
+
+namespace Kernel {
+class KProcess;
+}
+
+namespace Core {
+
+/// A module loaded in the application process, spanning [base, end).
+struct TranslationProfileModule {
+    std::string name;
+    u64 base;
+    u64 end;
+};
+
+// Writes a translation profile of the given blocks, as offsets relative to the module containing
+// them. Blocks outside of every module are dropped. Returns whether the file was fully written.
+bool WriteTranslationProfile(const std::filesystem::path& path, u64 program_id,
+                             const std::array<u8, 0x20>& build_id,
+                             std::span<const TranslationProfileModule> modules,
+                             std::span<const u64> blocks);
+
+// Reads the blocks of a translation profile, relocated to where the modules are loaded now.
+// Returns no blocks if the profile is missing, invalid, or was recorded for another build.
+std::vector<u64> ReadTranslationProfile(const std::filesystem::path& path, u64 program_id,
+                                        const std::array<u8, 0x20>& build_id,
+                                        std::span<const TranslationProfileModule> modules);
+
+/**
+ * Records the guest code blocks translated by the JIT for the running application, and saves
+ * them per title as module-relative offsets. On the next boot of the same build, the recorded
+ * blocks are handed out to idle cores, which translate them ahead of time so the application
+ * does not stall on translation when it first reaches them.
+ */
+class TranslationProfile {
+public:
+    explicit TranslationProfile(System& system_);
+    ~TranslationProfile();
+
+    // Loads the profile recorded for the given application process, queueing its blocks for
+    // warm-up, and starts recording newly translated blocks.
+    void Start(Kernel::KProcess* process, u64 program_id);
+
+    // Stops recording and saves the profile of the current application process.
+    void Stop();
+
+    // Records a translated block entry point. Called by the JIT of any core.
+    void RecordBlock(const Kernel::KProcess* process, u64 address);
+
+    // Returns whether or not the recorder is active.
+    bool IsRecording() const {
+        return is_recording.load(std::memory_order_relaxed);
+    }
+
+    // Returns whether or not the given core has blocks left to warm up.
+    bool HasPendingBlocks(std::size_t core_index) const;
+
+    // Takes up to out.size() blocks left to warm up for the given core, returning how many were
+    // written. Must only be called from the thread of the given core.
+    std::size_t TakePendingBlocks(std::size_t core_index, std::span<u64> out);
+
+private:
+    void Load();
+    void Save();
+
+    System& system;
+
+    Kernel::KProcess* process{};
+    u64 program_id{};
+    std::array<u8, 0x20> build_id{};
+
+    std::atomic_bool is_recording{};
+    std::mutex mutex;
+    std::vector<u64> blocks;
+    std::unordered_set<u64> block_set;
+
+    // Blocks loaded from the previous session. Immutable once published by warmup_ready.
+    std::atomic_bool warmup_ready{};
+    std::vector<u64> warmup_blocks;
+    std::array<std::size_t, Hardware::NUM_CPU_CORES> warmup_cursors{};
+};
+
+} // namespace Core
@@ -9,12 +9,14 @@
 
 #include "audio_core/audio_core.h"
 #include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "common/settings_enums.h"
 #include "common/string_util.h"
 #include "core/arm/exclusive_monitor.h"
+#include "core/arm/translation_profile.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
@@ -58,6 +60,7 @@
 #include "core/reporter.h"
 #include "core/telemetry_session.h"
 #include "core/tools/freezer.h"
+#include "core/tools/guest_profiler.h"
 #include "core/tools/renderdoc.h"
 #include "hid_core/hid_core.h"
 #include "network/network.h"
@@ -138,7 +141,8 @@ FileSys::VirtualFile GetGameFileFromPath(const FileSys::VirtualFilesystem& vfs,
 struct System::Impl {
     explicit Impl(System& system)
         : kernel{system}, fs_controller{system}, hid_core{}, room_network{}, cpu_manager{system},
-          reporter{system}, applet_manager{system}, frontend_applets{system}, profile_manager{} {}
+          reporter{system}, translation_profile{system}, applet_manager{system},
+          frontend_applets{system}, profile_manager{} {}
 
     void Initialize(System& system) {
         device_memory = std::make_unique<Core::DeviceMemory>();
@@ -327,6 +331,8 @@ struct System::Impl {
             renderdoc_api = std::make_unique<Tools::RenderdocAPI>();
         }
 
+        guest_profiler = std::make_unique<Tools::GuestProfiler>(system);
+
         LOG_DEBUG(Core, "Initialized OK");
 
         return SystemResultStatus::Success;
@@ -391,11 +397,21 @@ struct System::Impl {
         applet_manager.CreateAndInsertByFrontendAppletParameters(main_process->GetProcessId(),
                                                                  params);
 
+        // Queue the guest code recorded in previous sessions for translation by idle cores.
+        if (Settings::values.use_jit_warmup) {
+            translation_profile.Start(main_process, params.program_id);
+        }
+
         // All threads are started, begin main process execution, now that we're in the clear.
         main_process->Run(load_parameters->main_thread_priority,
                           load_parameters->main_thread_stack_size);
         main_process->Close();
 
+        if (Settings::values.enable_guest_profiler) {
+            guest_profiler->Start(
+                std::chrono::microseconds{Settings::values.guest_profiler_interval_us.GetValue()});
+        }
+
         if (Settings::values.gamecard_inserted) {
             if (Settings::values.gamecard_current_game) {
                 fs_controller.SetGameCard(GetGameFileFromPath(virtual_filesystem, filepath));
@@ -432,6 +448,22 @@ struct System::Impl {
     void ShutdownMainProcess() {
         SetShuttingDown(true);
 
+        // Save the translation profile while the application process is still alive
+        translation_profile.Stop();
+
+        // Write out the guest profile while the application process is still alive
+        if (guest_profiler && guest_profiler->IsRunning()) {
+            guest_profiler->Stop();
+
+            auto* const process = kernel.ApplicationProcess();
+            if (process != nullptr) {
+                const auto path = Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir) /
+                                  fmt::format("guest_profile_{:016X}.folded",
+                                              process->GetProgramId());
+                guest_profiler->WriteFoldedStacks(process, path);
+            }
+        }
+
         // Log last frame performance stats if game was loaded
         if (perf_stats) {
             const auto perf_results = GetAndResetPerfStats();
@@ -473,6 +505,7 @@ struct System::Impl {
         gpu_core.reset();
         host1x_core.reset();
         perf_stats.reset();
+        guest_profiler.reset();
         cpu_manager.Shutdown();
         debugger.reset();
         kernel.Shutdown();
@@ -534,6 +567,14 @@ struct System::Impl {
     }
 
     PerfStatsResults GetAndResetPerfStats() {
+        // The frontends query the stats periodically, which also samples the utilization of
+        // the emulated cores over the same interval.
+        const auto utilization = cpu_manager.GetCoreUtilization();
+        for (size_t core = 0; core < utilization.size(); core++) {
+            LOG_DEBUG(Core, "Core {}: guest {:.1f}%, idle {:.1f}%, {} spin yields", core,
+                      utilization[core].guest_ratio * 100.0,
+                      utilization[core].idle_ratio * 100.0, utilization[core].spin_yields);
+        }
         return perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs());
     }
 
@@ -570,6 +611,8 @@ struct System::Impl {
     std::array<u8, 0x20> build_id{};
 
     std::unique_ptr<Tools::RenderdocAPI> renderdoc_api;
+    std::unique_ptr<Tools::GuestProfiler> guest_profiler;
+    TranslationProfile translation_profile;
 
     /// Applets
     Service::AM::AppletManager applet_manager;
@@ -1037,6 +1080,22 @@ Tools::RenderdocAPI& System::GetRenderdocAPI() {
     return *impl->renderdoc_api;
 }
 
+Tools::GuestProfiler& System::GetGuestProfiler() {
+    return *impl->guest_profiler;
+}
+
+const Tools::GuestProfiler& System::GetGuestProfiler() const {
+    return *impl->guest_profiler;
+}
+
+TranslationProfile& System::GetTranslationProfile() {
+    return impl->translation_profile;
+}
+
+const TranslationProfile& System::GetTranslationProfile() const {
+    return impl->translation_profile;
+}
+
 void System::RunServer(std::unique_ptr<Service::ServerManager>&& server_manager) {
     return impl->kernel.RunServer(std::move(server_manager));
 }
@@ -109,6 +109,7 @@ class RoomNetwork;
 }
 
 namespace Tools {
+class GuestProfiler;
 class RenderdocAPI;
 }
 
@@ -123,6 +124,7 @@ class PerfStats;
 class Reporter;
 class SpeedLimiter;
 class TelemetrySession;
+class TranslationProfile;
 
 struct PerfStatsResults;
 
@@ -395,6 +397,18 @@ public:
 
     [[nodiscard]] Tools::RenderdocAPI& GetRenderdocAPI();
 
+    /// Gets a mutable reference to the guest sampling profiler.
+    [[nodiscard]] Tools::GuestProfiler& GetGuestProfiler();
+
+    /// Gets an immutable reference to the guest sampling profiler.
+    [[nodiscard]] const Tools::GuestProfiler& GetGuestProfiler() const;
+
+    /// Gets a mutable reference to the JIT translation profile.
+    [[nodiscard]] TranslationProfile& GetTranslationProfile();
+
+    /// Gets an immutable reference to the JIT translation profile.
+    [[nodiscard]] const TranslationProfile& GetTranslationProfile() const;
+
     void SetExitLocked(bool locked);
     bool GetExitLocked() const;
 
@@ -24,6 +24,21 @@ void CpuManager::Initialize() {
     num_cores = is_multicore ? Core::Hardware::NUM_CPU_CORES : 1;
     gpu_barrier = std::make_unique<Common::Barrier>(num_cores + 1);
 
+    // The first utilization sample covers the time since the cores started.
+    {
+        std::scoped_lock lk{utilization_mutex};
+        auto& kernel = system.Kernel();
+        for (std::size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; core++) {
+            const auto current = kernel.PhysicalCore(core).GetUtilization();
+            last_utilization[core] = {
+                .guest_ns = current.guest_ns,
+                .idle_ns = current.idle_ns,
+                .spin_yields = current.spin_yields,
+            };
+        }
+        last_utilization_time = Common::SteadyClock::Now();
+    }
+
     for (std::size_t core = 0; core < num_cores; core++) {
         core_data[core].host_thread =
             std::jthread([this, core](std::stop_token token) { RunThread(token, core); });
@@ -165,6 +180,36 @@ void CpuManager::PreemptSingleCore(bool from_running_environment) {
     }
 }
 
+std::array<CpuManager::CoreUtilization, Core::Hardware::NUM_CPU_CORES>
+CpuManager::GetCoreUtilization() {
+    std::scoped_lock lk{utilization_mutex};
+    auto& kernel = system.Kernel();
+    const auto now = Common::SteadyClock::Now();
+    const auto elapsed_ns = static_cast<f64>((now - last_utilization_time).count());
+    last_utilization_time = now;
+
+    std::array<CoreUtilization, Core::Hardware::NUM_CPU_CORES> utilization{};
+    for (std::size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; core++) {
+        const auto current = kernel.PhysicalCore(core).GetUtilization();
+        auto& last = last_utilization[core];
+
+        if (elapsed_ns > 0) {
+            utilization[core].guest_ratio =
+                static_cast<f64>(current.guest_ns - last.guest_ns) / elapsed_ns;
+            utilization[core].idle_ratio =
+                static_cast<f64>(current.idle_ns - last.idle_ns) / elapsed_ns;
+        }
+        utilization[core].spin_yields = current.spin_yields - last.spin_yields;
+
+        last = {
+            .guest_ns = current.guest_ns,
+            .idle_ns = current.idle_ns,
+            .spin_yields = current.spin_yields,
+        };
+    }
+    return utilization;
+}
+
 void CpuManager::GuestActivate() {
     // Similar to the HorizonKernelMain callback in HOS
     auto& kernel = system.Kernel();
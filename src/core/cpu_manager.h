@@ -7,10 +7,12 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include "common/fiber.h"
 #include "common/polyfill_thread.h"
+#include "common/steady_clock.h"
 #include "common/thread.h"
 #include "core/hardware_properties.h"
 
@@ -25,6 +27,15 @@ class System;
 
 class CpuManager {
 public:
+    struct CoreUtilization {
+        /// Fraction of host time spent executing guest code.
+        f64 guest_ratio{};
+        /// Fraction of host time spent waiting for work in the idle thread.
+        f64 idle_ratio{};
+        /// Number of times the host yielded because the guest was spin-waiting.
+        u64 spin_yields{};
+    };
+
     explicit CpuManager(System& system_);
     CpuManager(const CpuManager&) = delete;
     CpuManager(CpuManager&&) = delete;
@@ -70,6 +81,9 @@ public:
         return current_core.load();
     }
 
+    /// Gets the utilization of each emulated core since the previous call.
+    std::array<CoreUtilization, Core::Hardware::NUM_CPU_CORES> GetCoreUtilization();
+
 private:
     void GuestThreadFunction();
     void IdleThreadFunction();
@@ -91,6 +105,12 @@ private:
         std::jthread host_thread;
     };
 
+    struct UtilizationSample {
+        u64 guest_ns{};
+        u64 idle_ns{};
+        u64 spin_yields{};
+    };
+
     std::unique_ptr<Common::Barrier> gpu_barrier{};
     std::array<CoreData, Core::Hardware::NUM_CPU_CORES> core_data{};
 
@@ -101,6 +121,10 @@ private:
     std::size_t num_cores{};
     static constexpr std::size_t max_cycle_runs = 5;
 
+    std::mutex utilization_mutex;
+    std::array<UtilizationSample, Core::Hardware::NUM_CPU_CORES> last_utilization{};
+    Common::SteadyClock::time_point last_utilization_time{};
+
     System& system;
 };
 
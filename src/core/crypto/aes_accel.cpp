@@ -0,0 +1,362 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "common/assert.h"
+#include "common/scope_exit.h"
+#include "common/swap.h"
+#include "core/crypto/aes_accel.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#define AES_ACCEL_X86_64
+#elif defined(ARCHITECTURE_arm64) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#define AES_ACCEL_ARM64
+#endif
+
+namespace Core::Crypto::AesAccel {
+namespace {
+
+constexpr std::size_t BlockSize = sizeof(Block);
+
+// Number of blocks transcoded together. The AES units are pipelined, so independent blocks in
+// flight hide the latency of each round.
+constexpr std::size_t Parallelism = 8;
+
+// 128-bit big-endian CTR counter, kept in host order so it can be incremented in registers.
+struct Counter {
+    u64 hi;
+    u64 lo;
+};
+
+[[maybe_unused]] Counter LoadCounter(const Block& block) {
+    Counter counter;
+    std::memcpy(&counter.hi, block.data(), sizeof(u64));
+    std::memcpy(&counter.lo, block.data() + sizeof(u64), sizeof(u64));
+    return {Common::swap64(counter.hi), Common::swap64(counter.lo)};
+}
+
+[[maybe_unused]] void StoreCounter(Block& block, const Counter& counter) {
+    const u64 hi = Common::swap64(counter.hi);
+    const u64 lo = Common::swap64(counter.lo);
+    std::memcpy(block.data(), &hi, sizeof(u64));
+    std::memcpy(block.data() + sizeof(u64), &lo, sizeof(u64));
+}
+
+#if defined(AES_ACCEL_X86_64)
+
+#ifdef _MSC_VER
+#define AES_TARGET
+#else
+#define AES_TARGET __attribute__((target("aes,ssse3")))
+#endif
+
+using Vector = __m128i;
+
+AES_TARGET Vector Load(const u8* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+AES_TARGET void Store(u8* data, Vector value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+}
+
+AES_TARGET Vector Xor(Vector a, Vector b) {
+    return _mm_xor_si128(a, b);
+}
+
+AES_TARGET Vector MakeCounterBlock(const Counter& counter) {
+    const Vector byte_swap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const Vector value =
+        _mm_set_epi64x(static_cast<s64>(counter.hi), static_cast<s64>(counter.lo));
+    return _mm_shuffle_epi8(value, byte_swap);
+}
+
+// Multiplies the XTS tweak by the primitive element of GF(2^128), as specified by IEEE 1619.
+AES_TARGET Vector MultiplyTweak(Vector tweak) {
+    // Each 32-bit lane carries its top bit into the next lane, and the top lane reduces by 0x87.
+    const Vector carry = _mm_shuffle_epi32(_mm_srai_epi32(tweak, 31), 0x93);
+    return _mm_xor_si128(_mm_slli_epi32(tweak, 1),
+                         _mm_and_si128(carry, _mm_set_epi32(1, 1, 1, 0x87)));
+}
+
+template <std::size_t... I>
+AES_TARGET void EncryptBlocks(const std::array<Block, 11>& round_keys, Vector* blocks,
+                              std::index_sequence<I...>) {
+    const Vector first_key = Load(round_keys[0].data());
+    ((blocks[I] = _mm_xor_si128(blocks[I], first_key)), ...);
+    for (std::size_t round = 1; round < 10; round++) {
+        const Vector key = Load(round_keys[round].data());
+        ((blocks[I] = _mm_aesenc_si128(blocks[I], key)), ...);
+    }
+    const Vector last_key = Load(round_keys[10].data());
+    ((blocks[I] = _mm_aesenclast_si128(blocks[I], last_key)), ...);
+}
+
+template <std::size_t... I>
+AES_TARGET void DecryptBlocks(const std::array<Block, 11>& round_keys, Vector* blocks,
+                              std::index_sequence<I...>) {
+    const Vector first_key = Load(round_keys[0].data());
+    ((blocks[I] = _mm_xor_si128(blocks[I], first_key)), ...);
+    for (std::size_t round = 1; round < 10; round++) {
+        const Vector key = Load(round_keys[round].data());
+        ((blocks[I] = _mm_aesdec_si128(blocks[I], key)), ...);
+    }
+    const Vector last_key = Load(round_keys[10].data());
+    ((blocks[I] = _mm_aesdeclast_si128(blocks[I], last_key)), ...);
+}
+
+template <int Rcon>
+AES_TARGET Vector ExpandKeyStep(Vector key) {
+    const Vector assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, Rcon), 0xFF);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+AES_TARGET void ExpandKeyImpl(KeySchedule& schedule, const u8* key) {
+    Vector round_keys[11];
+    round_keys[0] = Load(key);
+    round_keys[1] = ExpandKeyStep<0x01>(round_keys[0]);
+    round_keys[2] = ExpandKeyStep<0x02>(round_keys[1]);
+    round_keys[3] = ExpandKeyStep<0x04>(round_keys[2]);
+    round_keys[4] = ExpandKeyStep<0x08>(round_keys[3]);
+    round_keys[5] = ExpandKeyStep<0x10>(round_keys[4]);
+    round_keys[6] = ExpandKeyStep<0x20>(round_keys[5]);
+    round_keys[7] = ExpandKeyStep<0x40>(round_keys[6]);
+    round_keys[8] = ExpandKeyStep<0x80>(round_keys[7]);
+    round_keys[9] = ExpandKeyStep<0x1B>(round_keys[8]);
+    round_keys[10] = ExpandKeyStep<0x36>(round_keys[9]);
+
+    // The decryption rounds use the equivalent inverse cipher, in reverse order.
+    for (std::size_t i = 0; i < 11; i++) {
+        Store(schedule.encrypt[i].data(), round_keys[i]);
+    }
+    Store(schedule.decrypt[0].data(), round_keys[10]);
+    for (std::size_t i = 1; i < 10; i++) {
+        Store(schedule.decrypt[i].data(), _mm_aesimc_si128(round_keys[10 - i]));
+    }
+    Store(schedule.decrypt[10].data(), round_keys[0]);
+}
+
+#elif defined(AES_ACCEL_ARM64)
+
+#define AES_TARGET
+
+using Vector = uint8x16_t;
+
+Vector Load(const u8* data) {
+    return vld1q_u8(data);
+}
+
+void Store(u8* data, Vector value) {
+    vst1q_u8(data, value);
+}
+
+Vector Xor(Vector a, Vector b) {
+    return veorq_u8(a, b);
+}
+
+Vector MakeCounterBlock(const Counter& counter) {
+    return vcombine_u8(vrev64_u8(vcreate_u8(counter.hi)), vrev64_u8(vcreate_u8(counter.lo)));
+}
+
+// Multiplies the XTS tweak by the primitive element of GF(2^128), as specified by IEEE 1619.
+Vector MultiplyTweak(Vector tweak) {
+    // The low lane carries its top bit into the high lane, and the high lane reduces by 0x87.
+    const uint64x2_t value = vreinterpretq_u64_u8(tweak);
+    const uint64x2_t mask = vreinterpretq_u64_s64(vshrq_n_s64(vreinterpretq_s64_u64(value), 63));
+    const uint64x2_t carry = vandq_u64(vextq_u64(mask, mask, 1), vcombine_u64(vcreate_u64(0x87),
+                                                                              vcreate_u64(1)));
+    return vreinterpretq_u8_u64(veorq_u64(vshlq_n_u64(value, 1), carry));
+}
+
+template <std::size_t... I>
+void EncryptBlocks(const std::array<Block, 11>& round_keys, Vector* blocks,
+                   std::index_sequence<I...>) {
+    for (std::size_t round = 0; round < 9; round++) {
+        const Vector key = Load(round_keys[round].data());
+        ((blocks[I] = vaesmcq_u8(vaeseq_u8(blocks[I], key))), ...);
+    }
+    const Vector key = Load(round_keys[9].data());
+    const Vector last_key = Load(round_keys[10].data());
+    ((blocks[I] = veorq_u8(vaeseq_u8(blocks[I], key), last_key)), ...);
+}
+
+template <std::size_t... I>
+void DecryptBlocks(const std::array<Block, 11>& round_keys, Vector* blocks,
+                   std::index_sequence<I...>) {
+    for (std::size_t round = 0; round < 9; round++) {
+        const Vector key = Load(round_keys[round].data());
+        ((blocks[I] = vaesimcq_u8(vaesdq_u8(blocks[I], key))), ...);
+    }
+    const Vector key = Load(round_keys[9].data());
+    const Vector last_key = Load(round_keys[10].data());
+    ((blocks[I] = veorq_u8(vaesdq_u8(blocks[I], key), last_key)), ...);
+}
+
+u32 SubWord(u32 word) {
+    // With every column equal, ShiftRows is a no-op and AESE with a zero key is just SubBytes.
+    const Vector state = vreinterpretq_u8_u32(vdupq_n_u32(word));
+    return vgetq_lane_u32(vreinterpretq_u32_u8(vaeseq_u8(state, vdupq_n_u8(0))), 0);
+}
+
+void ExpandKeyImpl(KeySchedule& schedule, const u8* key) {
+    static constexpr std::array<u32, 10> Rcon{0x01, 0x02, 0x04, 0x08, 0x10,
+                                              0x20, 0x40, 0x80, 0x1B, 0x36};
+
+    std::array<u32, 44> words;
+    std::memcpy(words.data(), key, BlockSize);
+    for (std::size_t i = 4; i < words.size(); i++) {
+        u32 temp = words[i - 1];
+        if (i % 4 == 0) {
+            temp = SubWord((temp >> 8) | (temp << 24)) ^ Rcon[i / 4 - 1];
+        }
+        words[i] = words[i - 4] ^ temp;
+    }
+    std::memcpy(schedule.encrypt.data(), words.data(), sizeof(words));
+
+    // The decryption rounds use the equivalent inverse cipher, in reverse order.
+    schedule.decrypt[0] = schedule.encrypt[10];
+    for (std::size_t i = 1; i < 10; i++) {
+        Store(schedule.decrypt[i].data(), vaesimcq_u8(Load(schedule.encrypt[10 - i].data())));
+    }
+    schedule.decrypt[10] = schedule.encrypt[0];
+}
+
+#endif
+
+#if defined(AES_ACCEL_X86_64) || defined(AES_ACCEL_ARM64)
+
+// The blocks are processed through index sequences, so that they are kept in registers.
+template <std::size_t N>
+AES_TARGET void EncryptBlocks(const std::array<Block, 11>& round_keys, Vector* blocks) {
+    EncryptBlocks(round_keys, blocks, std::make_index_sequence<N>{});
+}
+
+template <std::size_t N>
+AES_TARGET void DecryptBlocks(const std::array<Block, 11>& round_keys, Vector* blocks) {
+    DecryptBlocks(round_keys, blocks, std::make_index_sequence<N>{});
+}
+
+template <std::size_t N>
+AES_TARGET void CtrTranscodeBlocks(const KeySchedule& schedule, Counter& counter, const u8* src,
+                                   u8* dest) {
+    Vector blocks[N];
+    for (std::size_t i = 0; i < N; i++) {
+        blocks[i] = MakeCounterBlock(counter);
+        counter.hi += ++counter.lo == 0 ? 1 : 0;
+    }
+    EncryptBlocks<N>(schedule.encrypt, blocks);
+    for (std::size_t i = 0; i < N; i++) {
+        Store(dest + i * BlockSize, Xor(blocks[i], Load(src + i * BlockSize)));
+    }
+}
+
+template <std::size_t N>
+AES_TARGET void XtsTranscodeBlocks(const KeySchedule& data_key, Vector& tweak, const u8* src,
+                                   u8* dest, bool encrypt) {
+    Vector tweaks[N];
+    Vector blocks[N];
+    for (std::size_t i = 0; i < N; i++) {
+        tweaks[i] = tweak;
+        tweak = MultiplyTweak(tweak);
+        blocks[i] = Xor(Load(src + i * BlockSize), tweaks[i]);
+    }
+    if (encrypt) {
+        EncryptBlocks<N>(data_key.encrypt, blocks);
+    } else {
+        DecryptBlocks<N>(data_key.decrypt, blocks);
+    }
+    for (std::size_t i = 0; i < N; i++) {
+        Store(dest + i * BlockSize, Xor(blocks[i], tweaks[i]));
+    }
+}
+
+AES_TARGET void CtrTranscodeImpl(const KeySchedule& schedule, Block& counter_block,
+                                 const u8* src, std::size_t size, u8* dest) {
+    Counter counter = LoadCounter(counter_block);
+    SCOPE_EXIT {
+        StoreCounter(counter_block, counter);
+    };
+
+    std::size_t offset = 0;
+    for (; size - offset >= Parallelism * BlockSize; offset += Parallelism * BlockSize) {
+        CtrTranscodeBlocks<Parallelism>(schedule, counter, src + offset, dest + offset);
+    }
+    for (; size - offset >= BlockSize; offset += BlockSize) {
+        CtrTranscodeBlocks<1>(schedule, counter, src + offset, dest + offset);
+    }
+
+    // Transcode a trailing partial block through a temporary block.
+    if (offset < size) {
+        Block block{};
+        std::memcpy(block.data(), src + offset, size - offset);
+        CtrTranscodeBlocks<1>(schedule, counter, block.data(), block.data());
+        std::memcpy(dest + offset, block.data(), size - offset);
+    }
+}
+
+AES_TARGET void XtsTranscodeImpl(const KeySchedule& data_key, const KeySchedule& tweak_key,
+                                 const Block& iv, const u8* src, std::size_t size, u8* dest,
+                                 bool encrypt) {
+    Vector tweak = Load(iv.data());
+    EncryptBlocks<1>(tweak_key.encrypt, &tweak);
+
+    std::size_t offset = 0;
+    for (; size - offset >= Parallelism * BlockSize; offset += Parallelism * BlockSize) {
+        XtsTranscodeBlocks<Parallelism>(data_key, tweak, src + offset, dest + offset, encrypt);
+    }
+    for (; offset < size; offset += BlockSize) {
+        XtsTranscodeBlocks<1>(data_key, tweak, src + offset, dest + offset, encrypt);
+    }
+}
+
+#endif
+
+} // Anonymous namespace
+
+bool IsSupported() {
+#if defined(AES_ACCEL_X86_64)
+    return Common::GetCPUCaps().aes;
+#elif defined(AES_ACCEL_ARM64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ExpandKey(KeySchedule& schedule, const u8* key) {
+#if defined(AES_ACCEL_X86_64) || defined(AES_ACCEL_ARM64)
+    ExpandKeyImpl(schedule, key);
+#else
+    UNREACHABLE();
+#endif
+}
+
+void CtrTranscode(const KeySchedule& schedule, Block& counter, const u8* src, std::size_t size,
+                  u8* dest) {
+#if defined(AES_ACCEL_X86_64) || defined(AES_ACCEL_ARM64)
+    CtrTranscodeImpl(schedule, counter, src, size, dest);
+#else
+    UNREACHABLE();
+#endif
+}
+
+void XtsTranscode(const KeySchedule& data_key, const KeySchedule& tweak_key, const Block& iv,
+                  const u8* src, std::size_t size, u8* dest, bool encrypt) {
+    ASSERT_MSG(size % BlockSize == 0, "XTS size must be a multiple of the block size.");
+#if defined(AES_ACCEL_X86_64) || defined(AES_ACCEL_ARM64)
+    XtsTranscodeImpl(data_key, tweak_key, iv, src, size, dest, encrypt);
+#else
+    UNREACHABLE();
+#endif
+}
+
+} // namespace Core::Crypto::AesAccel
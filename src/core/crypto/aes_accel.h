@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/common_types.h"
+
+namespace Core::Crypto::AesAccel {
+
+using Block = std::array<u8, 0x10>;
+
+/// Expanded AES-128 round keys for the hardware accelerated backend.
+struct KeySchedule {
+    alignas(16) std::array<Block, 11> encrypt;
+    alignas(16) std::array<Block, 11> decrypt;
+};
+
+/// Returns whether or not the host supports the hardware accelerated backend.
+bool IsSupported();
+
+/// Expands an AES-128 key into its encryption and decryption round keys.
+void ExpandKey(KeySchedule& schedule, const u8* key);
+
+/**
+ * Transcodes data with AES-128-CTR, processing several blocks at once.
+ * The big-endian counter is advanced by every block consumed, including a trailing partial one.
+ */
+void CtrTranscode(const KeySchedule& schedule, Block& counter, const u8* src, std::size_t size,
+                  u8* dest);
+
+/**
+ * Transcodes one XTS data unit with AES-128-XTS, processing several blocks at once.
+ * The size must be a multiple of the block size.
+ */
+void XtsTranscode(const KeySchedule& data_key, const KeySchedule& tweak_key, const Block& iv,
+                  const u8* src, std::size_t size, u8* dest, bool encrypt);
+
+} // namespace Core::Crypto::AesAccel
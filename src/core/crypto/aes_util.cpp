@@ -5,6 +5,7 @@
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/crypto/aes_accel.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
@@ -36,6 +37,12 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+    // AES-128 CTR and XTS use the hardware accelerated backend when the host supports it.
+    bool use_accel{};
+    AesAccel::KeySchedule data_key{};
+    AesAccel::KeySchedule tweak_key{};
+    AesAccel::Block iv{};
 };
 
 template <typename Key, std::size_t KeySize>
@@ -57,6 +64,20 @@ Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     ASSERT(
         !mbedtls_cipher_setkey(&ctx->decryption_context, key.data(), KeySize * 8, MBEDTLS_DECRYPT));
     //"Failed to set key on mbedtls ciphers.");
+
+    // Expand the round keys once here, rather than on every transcode.
+    if constexpr (KeySize == 0x10) {
+        if (mode == Mode::CTR && AesAccel::IsSupported()) {
+            ctx->use_accel = true;
+            AesAccel::ExpandKey(ctx->data_key, key.data());
+        }
+    } else {
+        if (mode == Mode::XTS && AesAccel::IsSupported()) {
+            ctx->use_accel = true;
+            AesAccel::ExpandKey(ctx->data_key, key.data());
+            AesAccel::ExpandKey(ctx->tweak_key, key.data() + 0x10);
+        }
+    }
 }
 
 template <typename Key, std::size_t KeySize>
@@ -68,11 +89,26 @@ AESCipher<Key, KeySize>::~AESCipher() {
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
+    const auto cipher_mode = mbedtls_cipher_get_cipher_mode(context);
+
+    if (ctx->use_accel) {
+        if (cipher_mode == MBEDTLS_MODE_CTR) {
+            AesAccel::CtrTranscode(ctx->data_key, ctx->iv, src, size, dest);
+            return;
+        }
+        // Partial blocks need ciphertext stealing, which is left to mbedtls.
+        if (size % sizeof(AesAccel::Block) == 0) {
+            AesAccel::XtsTranscode(ctx->data_key, ctx->tweak_key, ctx->iv, src, size, dest,
+                                   op == Op::Encrypt);
+            return;
+        }
+    }
 
     mbedtls_cipher_reset(context);
 
     std::size_t written = 0;
-    if (mbedtls_cipher_get_cipher_mode(context) == MBEDTLS_MODE_XTS) {
+    if (cipher_mode == MBEDTLS_MODE_XTS || cipher_mode == MBEDTLS_MODE_CTR) {
+        // XTS transcodes a whole data unit at once, and CTR is a stream cipher.
         mbedtls_cipher_update(context, src, size, dest, &written);
         if (written != size) {
             LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
@@ -111,6 +147,15 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
                                            std::size_t sector_id, std::size_t sector_size, Op op) {
     ASSERT_MSG(size % sector_size == 0, "XTS decryption size must be a multiple of sector size.");
 
+    if (ctx->use_accel && sector_size % sizeof(AesAccel::Block) == 0) {
+        for (std::size_t i = 0; i < size; i += sector_size) {
+            ctx->iv = CalculateNintendoTweak(sector_id++);
+            AesAccel::XtsTranscode(ctx->data_key, ctx->tweak_key, ctx->iv, src + i, sector_size,
+                                   dest + i, op == Op::Encrypt);
+        }
+        return;
+    }
+
     for (std::size_t i = 0; i < size; i += sector_size) {
         SetIV(CalculateNintendoTweak(sector_id++));
         Transcode(src + i, sector_size, dest + i, op);
@@ -119,6 +164,9 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
+    if (data.size() == ctx->iv.size()) {
+        std::memcpy(ctx->iv.data(), data.data(), ctx->iv.size());
+    }
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
@@ -808,36 +808,43 @@ bool KeyManager::BaseDeriveNecessary() const {
 }
 
 bool KeyManager::HasKey(S128KeyType id, u64 field1, u64 field2) const {
+    std::shared_lock lk{key_mutex};
     return s128_keys.find({id, field1, field2}) != s128_keys.end();
 }
 
 bool KeyManager::HasKey(S256KeyType id, u64 field1, u64 field2) const {
+    std::shared_lock lk{key_mutex};
     return s256_keys.find({id, field1, field2}) != s256_keys.end();
 }
 
 Key128 KeyManager::GetKey(S128KeyType id, u64 field1, u64 field2) const {
-    if (!HasKey(id, field1, field2)) {
+    std::shared_lock lk{key_mutex};
+    const auto iter = s128_keys.find({id, field1, field2});
+    if (iter == s128_keys.end()) {
         return {};
     }
-    return s128_keys.at({id, field1, field2});
+    return iter->second;
 }
 
 Key256 KeyManager::GetKey(S256KeyType id, u64 field1, u64 field2) const {
-    if (!HasKey(id, field1, field2)) {
+    std::shared_lock lk{key_mutex};
+    const auto iter = s256_keys.find({id, field1, field2});
+    if (iter == s256_keys.end()) {
         return {};
     }
-    return s256_keys.at({id, field1, field2});
+    return iter->second;
 }
 
 Key256 KeyManager::GetBISKey(u8 partition_id) const {
     Key256 out{};
 
+    std::shared_lock lk{key_mutex};
     for (const auto& bis_type : {BISKeyType::Crypto, BISKeyType::Tweak}) {
-        if (HasKey(S128KeyType::BIS, partition_id, static_cast<u64>(bis_type))) {
-            std::memcpy(
-                out.data() + sizeof(Key128) * static_cast<u64>(bis_type),
-                s128_keys.at({S128KeyType::BIS, partition_id, static_cast<u64>(bis_type)}).data(),
-                sizeof(Key128));
+        const auto iter =
+            s128_keys.find({S128KeyType::BIS, partition_id, static_cast<u64>(bis_type)});
+        if (iter != s128_keys.end()) {
+            std::memcpy(out.data() + sizeof(Key128) * static_cast<u64>(bis_type),
+                        iter->second.data(), sizeof(Key128));
         }
     }
 
@@ -879,6 +886,7 @@ void KeyManager::WriteKeyToFile(KeyCategory category, std::string_view keyname,
 }
 
 void KeyManager::SetKey(S128KeyType id, Key128 key, u64 field1, u64 field2) {
+    std::unique_lock lk{key_mutex};
     if (s128_keys.find({id, field1, field2}) != s128_keys.end() || key == Key128{}) {
         return;
     }
@@ -932,6 +940,7 @@ void KeyManager::SetKey(S128KeyType id, Key128 key, u64 field1, u64 field2) {
 }
 
 void KeyManager::SetKey(S256KeyType id, Key256 key, u64 field1, u64 field2) {
+    std::unique_lock lk{key_mutex};
     if (s256_keys.find({id, field1, field2}) != s256_keys.end() || key == Key256{}) {
         return;
     }
@@ -1339,11 +1348,13 @@ void KeyManager::PopulateFromPartitionData(PartitionDataManager& data) {
     DeriveBase();
 }
 
-const std::map<u128, Ticket>& KeyManager::GetCommonTickets() const {
+std::map<u128, Ticket> KeyManager::GetCommonTickets() const {
+    std::shared_lock lk{key_mutex};
     return common_tickets;
 }
 
-const std::map<u128, Ticket>& KeyManager::GetPersonalizedTickets() const {
+std::map<u128, Ticket> KeyManager::GetPersonalizedTickets() const {
+    std::shared_lock lk{key_mutex};
     return personal_tickets;
 }
 
@@ -1356,10 +1367,13 @@ bool KeyManager::AddTicket(const Ticket& ticket) {
     const auto& rid = ticket.GetData().rights_id;
     u128 rights_id;
     std::memcpy(rights_id.data(), rid.data(), rid.size());
-    if (ticket.GetData().type == Core::Crypto::TitleKeyType::Common) {
-        common_tickets[rights_id] = ticket;
-    } else {
-        personal_tickets[rights_id] = ticket;
+    {
+        std::unique_lock lk{key_mutex};
+        if (ticket.GetData().type == Core::Crypto::TitleKeyType::Common) {
+            common_tickets[rights_id] = ticket;
+        } else {
+            personal_tickets[rights_id] = ticket;
+        }
     }
 
     if (HasKey(S128KeyType::Titlekey, rights_id[1], rights_id[0])) {
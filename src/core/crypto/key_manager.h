@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <map>
 #include <optional>
+#include <shared_mutex>
 #include <span>
 #include <string>
 
@@ -287,8 +288,9 @@ public:
 
     void PopulateFromPartitionData(PartitionDataManager& data);
 
-    const std::map<u128, Ticket>& GetCommonTickets() const;
-    const std::map<u128, Ticket>& GetPersonalizedTickets() const;
+    // Returns copies, as tickets may be added by other threads.
+    std::map<u128, Ticket> GetCommonTickets() const;
+    std::map<u128, Ticket> GetPersonalizedTickets() const;
 
     bool AddTicket(const Ticket& ticket);
 
@@ -298,6 +300,9 @@ public:
 private:
     KeyManager();
 
+    // Guards the keys and tickets, as NCAs and packages may be parsed on several threads at once.
+    mutable std::shared_mutex key_mutex;
+
     std::map<KeyIndex<S128KeyType>, Key128> s128_keys;
     std::map<KeyIndex<S256KeyType>, Key256> s256_keys;
 
@@ -1,4 +1,274 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-namespace Crypto {} // namespace Crypto
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <mbedtls/sha256.h>
+
+#include "common/assert.h"
+#include "common/swap.h"
+#include "core/crypto/sha_util.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#define SHA_ACCEL_X86_64
+#elif defined(ARCHITECTURE_arm64) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#define SHA_ACCEL_ARM64
+#endif
+
+namespace Core::Crypto {
+namespace {
+
+constexpr std::size_t BlockSize = 0x40;
+
+using State = std::array<u32, 8>;
+
+constexpr State InitialState{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+[[maybe_unused]] alignas(16) constexpr std::array<u32, 64> RoundConstants{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#if defined(SHA_ACCEL_X86_64)
+
+#ifdef _MSC_VER
+#define SHA_TARGET
+#else
+#define SHA_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+
+// Performs four rounds. The message schedule is kept in a ring of four vectors, and the vectors
+// for rounds 16 and above are derived from the previous sixteen words.
+template <std::size_t Group>
+SHA_TARGET inline void Rounds(__m128i (&msg)[4], __m128i& abef, __m128i& cdgh) {
+    constexpr std::size_t Index = Group % 4;
+    if constexpr (Group >= 4) {
+        const __m128i w0 = msg[Index];
+        const __m128i w4 = msg[(Group + 1) % 4];
+        const __m128i w8 = msg[(Group + 2) % 4];
+        const __m128i w12 = msg[(Group + 3) % 4];
+        const __m128i tmp = _mm_add_epi32(_mm_sha256msg1_epu32(w0, w4), _mm_alignr_epi8(w12, w8, 4));
+        msg[Index] = _mm_sha256msg2_epu32(tmp, w12);
+    }
+
+    __m128i wk = _mm_add_epi32(
+        msg[Index], _mm_load_si128(reinterpret_cast<const __m128i*>(&RoundConstants[Group * 4])));
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+    wk = _mm_shuffle_epi32(wk, 0x0E);
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, wk);
+}
+
+template <std::size_t... Groups>
+SHA_TARGET inline void AllRounds(__m128i (&msg)[4], __m128i& abef, __m128i& cdgh,
+                                 std::index_sequence<Groups...>) {
+    (Rounds<Groups>(msg, abef, cdgh), ...);
+}
+
+SHA_TARGET void CompressBlocksAccel(State& state, const u8* data, std::size_t num_blocks) {
+    const __m128i byteswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The SHA instructions operate on the state as {A, B, E, F} and {C, D, G, H}.
+    const __m128i dcba = _mm_shuffle_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+    const __m128i efgh = _mm_shuffle_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+    __m128i abef = _mm_alignr_epi8(dcba, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, dcba, 0xF0);
+
+    for (; num_blocks > 0; num_blocks--, data += BlockSize) {
+        const __m128i abef_save = abef;
+        const __m128i cdgh_save = cdgh;
+
+        __m128i msg[4];
+        for (std::size_t i = 0; i < 4; i++) {
+            msg[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 0x10)), byteswap);
+        }
+        AllRounds(msg, abef, cdgh, std::make_index_sequence<16>{});
+
+        abef = _mm_add_epi32(abef, abef_save);
+        cdgh = _mm_add_epi32(cdgh, cdgh_save);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#elif defined(SHA_ACCEL_ARM64)
+
+template <std::size_t Group>
+inline void Rounds(uint32x4_t (&msg)[4], uint32x4_t& abcd, uint32x4_t& efgh) {
+    constexpr std::size_t Index = Group % 4;
+    if constexpr (Group >= 4) {
+        msg[Index] = vsha256su1q_u32(vsha256su0q_u32(msg[Index], msg[(Group + 1) % 4]),
+                                     msg[(Group + 2) % 4], msg[(Group + 3) % 4]);
+    }
+
+    const uint32x4_t wk = vaddq_u32(msg[Index], vld1q_u32(&RoundConstants[Group * 4]));
+    const uint32x4_t abcd_prev = abcd;
+    abcd = vsha256hq_u32(abcd, efgh, wk);
+    efgh = vsha256h2q_u32(efgh, abcd_prev, wk);
+}
+
+template <std::size_t... Groups>
+inline void AllRounds(uint32x4_t (&msg)[4], uint32x4_t& abcd, uint32x4_t& efgh,
+                      std::index_sequence<Groups...>) {
+    (Rounds<Groups>(msg, abcd, efgh), ...);
+}
+
+void CompressBlocksAccel(State& state, const u8* data, std::size_t num_blocks) {
+    uint32x4_t abcd = vld1q_u32(&state[0]);
+    uint32x4_t efgh = vld1q_u32(&state[4]);
+
+    for (; num_blocks > 0; num_blocks--, data += BlockSize) {
+        const uint32x4_t abcd_save = abcd;
+        const uint32x4_t efgh_save = efgh;
+
+        uint32x4_t msg[4];
+        for (std::size_t i = 0; i < 4; i++) {
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 0x10)));
+        }
+        AllRounds(msg, abcd, efgh, std::make_index_sequence<16>{});
+
+        abcd = vaddq_u32(abcd, abcd_save);
+        efgh = vaddq_u32(efgh, efgh_save);
+    }
+
+    vst1q_u32(&state[0], abcd);
+    vst1q_u32(&state[4], efgh);
+}
+
+#else
+
+void CompressBlocksAccel(State&, const u8*, std::size_t) {
+    UNREACHABLE();
+}
+
+#endif
+
+} // Anonymous namespace
+
+struct SHA256Context {
+    bool use_accel;
+
+    // Hardware accelerated state.
+    State state;
+    std::array<u8, BlockSize> buffer;
+    std::size_t buffer_size;
+    u64 total_size;
+
+    // Software fallback state.
+    mbedtls_sha256_context mbedtls;
+};
+
+SHA256Hasher::SHA256Hasher() : ctx(std::make_unique<SHA256Context>()) {
+    ctx->use_accel = IsSHA256Accelerated();
+    if (ctx->use_accel) {
+        ctx->state = InitialState;
+        ctx->buffer_size = 0;
+        ctx->total_size = 0;
+    } else {
+        mbedtls_sha256_init(&ctx->mbedtls);
+        mbedtls_sha256_starts_ret(&ctx->mbedtls, 0);
+    }
+}
+
+SHA256Hasher::~SHA256Hasher() {
+    if (!ctx->use_accel) {
+        mbedtls_sha256_free(&ctx->mbedtls);
+    }
+}
+
+void SHA256Hasher::Update(const u8* data, std::size_t size) {
+    if (!ctx->use_accel) {
+        mbedtls_sha256_update_ret(&ctx->mbedtls, data, size);
+        return;
+    }
+
+    ctx->total_size += size;
+
+    // Complete a partially filled block first.
+    if (ctx->buffer_size > 0) {
+        const std::size_t to_copy = std::min(size, BlockSize - ctx->buffer_size);
+        std::memcpy(ctx->buffer.data() + ctx->buffer_size, data, to_copy);
+        ctx->buffer_size += to_copy;
+        data += to_copy;
+        size -= to_copy;
+
+        if (ctx->buffer_size < BlockSize) {
+            return;
+        }
+        CompressBlocksAccel(ctx->state, ctx->buffer.data(), 1);
+        ctx->buffer_size = 0;
+    }
+
+    // Hash the whole blocks directly from the input.
+    const std::size_t num_blocks = size / BlockSize;
+    if (num_blocks > 0) {
+        CompressBlocksAccel(ctx->state, data, num_blocks);
+        data += num_blocks * BlockSize;
+        size -= num_blocks * BlockSize;
+    }
+
+    std::memcpy(ctx->buffer.data(), data, size);
+    ctx->buffer_size = size;
+}
+
+std::array<u8, 0x20> SHA256Hasher::Finish() {
+    std::array<u8, 0x20> out{};
+    if (!ctx->use_accel) {
+        mbedtls_sha256_finish_ret(&ctx->mbedtls, out.data());
+        return out;
+    }
+
+    // Pad with a single set bit, then zeroes up to the big-endian bit length in the last 8 bytes.
+    const u64 bit_length = Common::swap64(ctx->total_size * 8);
+    std::array<u8, BlockSize * 2> padding{};
+    std::memcpy(padding.data(), ctx->buffer.data(), ctx->buffer_size);
+    padding[ctx->buffer_size] = 0x80;
+
+    const std::size_t num_blocks = ctx->buffer_size + 1 + sizeof(u64) > BlockSize ? 2 : 1;
+    std::memcpy(padding.data() + num_blocks * BlockSize - sizeof(u64), &bit_length, sizeof(u64));
+    CompressBlocksAccel(ctx->state, padding.data(), num_blocks);
+
+    for (std::size_t i = 0; i < ctx->state.size(); i++) {
+        const u32 word = Common::swap32(ctx->state[i]);
+        std::memcpy(out.data() + i * sizeof(u32), &word, sizeof(u32));
+    }
+    return out;
+}
+
+bool IsSHA256Accelerated() {
+#if defined(SHA_ACCEL_X86_64)
+    const auto& caps = Common::GetCPUCaps();
+    return caps.sha && caps.sse4_1 && caps.ssse3;
+#elif defined(SHA_ACCEL_ARM64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::array<u8, 0x20> SHA256(const u8* data, std::size_t size) {
+    SHA256Hasher hasher;
+    hasher.Update(data, size);
+    return hasher.Finish();
+}
+
+} // namespace Core::Crypto
@@ -3,17 +3,42 @@
 
 #pragma once
 
-#include "common/assert.h"
-#include "core/file_sys/vfs.h"
-#include "key_manager.h"
-#include "mbedtls/cipher.h"
+#include <array>
+#include <cstddef>
+#include <memory>
 
-namespace Crypto {
-typedef std::array<u8, 0x20> SHA256Hash;
+#include "common/common_types.h"
 
-inline SHA256Hash operator"" _HASH(const char* data, size_t len) {
-    if (len != 0x40)
-        return {};
-}
+namespace Core::Crypto {
 
-} // namespace Crypto
+struct SHA256Context;
+
+/**
+ * Incremental SHA-256 hasher. Uses the SHA extensions of the host CPU when they are available,
+ * falling back to mbedtls otherwise.
+ */
+class SHA256Hasher {
+public:
+    SHA256Hasher();
+    ~SHA256Hasher();
+
+    SHA256Hasher(const SHA256Hasher&) = delete;
+    SHA256Hasher& operator=(const SHA256Hasher&) = delete;
+
+    /// Hashes the given data, continuing from the data hashed by previous calls.
+    void Update(const u8* data, std::size_t size);
+
+    /// Finishes hashing and returns the digest. The hasher must not be updated afterwards.
+    std::array<u8, 0x20> Finish();
+
+private:
+    std::unique_ptr<SHA256Context> ctx;
+};
+
+/// Returns whether or not SHA-256 is hardware accelerated on the host.
+bool IsSHA256Accelerated();
+
+/// Computes the SHA-256 digest of the given data.
+std::array<u8, 0x20> SHA256(const u8* data, std::size_t size);
+
+} // namespace Core::Crypto
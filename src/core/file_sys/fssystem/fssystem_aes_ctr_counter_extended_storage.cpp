@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <optional>
+
+#include "core/crypto/aes_util.h"
 #include "core/file_sys/fssystem/fssystem_aes_ctr_counter_extended_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
 #include "core/file_sys/fssystem/fssystem_nca_header.h"
@@ -242,10 +245,20 @@ size_t AesCtrCounterExtendedStorage::Read(u8* buffer, size_t size, size_t offset
 void SoftwareDecryptor::Decrypt(u8* buf, size_t buf_size,
                                 const std::array<u8, AesCtrCounterExtendedStorage::KeySize>& key,
                                 const std::array<u8, AesCtrCounterExtendedStorage::IvSize>& iv) {
-    Core::Crypto::AESCipher<Core::Crypto::Key128, AesCtrCounterExtendedStorage::KeySize> cipher(
-        key, Core::Crypto::Mode::CTR);
-    cipher.SetIV(iv);
-    cipher.Transcode(buf, buf_size, buf, Core::Crypto::Op::Decrypt);
+    using Cipher =
+        Core::Crypto::AESCipher<Core::Crypto::Key128, AesCtrCounterExtendedStorage::KeySize>;
+
+    // The key rarely changes between calls, so keep its cipher to avoid rebuilding the context.
+    // Each thread keeps its own, so that storages read in parallel don't contend on it.
+    thread_local std::array<u8, AesCtrCounterExtendedStorage::KeySize> cached_key{};
+    thread_local std::optional<Cipher> cipher;
+    if (!cipher || cached_key != key) {
+        cached_key = key;
+        cipher.emplace(key, Core::Crypto::Mode::CTR);
+    }
+
+    cipher->SetIV(iv);
+    cipher->Transcode(buf, buf_size, buf, Core::Crypto::Op::Decrypt);
 }
 
 } // namespace FileSys
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "common/assert.h"
+#include "core/file_sys/fssystem/fssystem_block_cache.h"
+
+namespace FileSys {
+
+BlockCache::BlockCache(size_t capacity, size_t shard_count)
+    : m_shards(std::make_unique<Shard[]>(shard_count)), m_shard_count(shard_count),
+      m_shard_capacity(capacity / shard_count) {
+    ASSERT(shard_count > 0);
+}
+
+BlockCache::~BlockCache() = default;
+
+BlockCache& BlockCache::GetInstance() {
+    static BlockCache instance{DefaultCapacity};
+    return instance;
+}
+
+u64 BlockCache::AllocateOwner() {
+    return m_next_owner++;
+}
+
+bool BlockCache::Read(u64 owner, s64 offset, void* dst, size_t skip_size, size_t size) {
+    const Key key{owner, offset};
+    auto& shard = this->GetShard(key);
+
+    std::scoped_lock lk{shard.mutex};
+    const auto it = shard.blocks.find(key);
+    if (it == shard.blocks.end() || skip_size + size > it->second->data.size()) {
+        ++m_misses;
+        return false;
+    }
+
+    // Move the block to the front, as the most recently used.
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    std::memcpy(dst, it->second->data.data() + skip_size, size);
+
+    ++m_hits;
+    return true;
+}
+
+void BlockCache::Insert(u64 owner, s64 offset, const void* src, size_t size) {
+    // Blocks that would evict a whole shard are not worth caching.
+    if (size > m_shard_capacity) {
+        return;
+    }
+
+    const Key key{owner, offset};
+    auto& shard = this->GetShard(key);
+
+    std::scoped_lock lk{shard.mutex};
+    if (const auto it = shard.blocks.find(key); it != shard.blocks.end()) {
+        shard.used_size -= it->second->data.size();
+        shard.lru.erase(it->second);
+        shard.blocks.erase(it);
+    }
+
+    this->EvictLocked(shard, size);
+
+    const auto* const data = static_cast<const u8*>(src);
+    shard.lru.push_front({key, std::vector<u8>(data, data + size)});
+    shard.blocks.emplace(key, shard.lru.begin());
+    shard.used_size += size;
+}
+
+void BlockCache::Invalidate(u64 owner) {
+    for (size_t i = 0; i < m_shard_count; ++i) {
+        auto& shard = m_shards[i];
+
+        std::scoped_lock lk{shard.mutex};
+        for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+            if (it->key.owner == owner) {
+                shard.used_size -= it->data.size();
+                shard.blocks.erase(it->key);
+                it = shard.lru.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+BlockCache::Statistics BlockCache::GetStatistics() const {
+    size_t used_size = 0;
+    for (size_t i = 0; i < m_shard_count; ++i) {
+        std::scoped_lock lk{m_shards[i].mutex};
+        used_size += m_shards[i].used_size;
+    }
+
+    return {
+        .hits = m_hits.load(),
+        .misses = m_misses.load(),
+        .used_size = used_size,
+    };
+}
+
+void BlockCache::EvictLocked(Shard& shard, size_t required_size) {
+    while (!shard.lru.empty() && shard.used_size + required_size > m_shard_capacity) {
+        const auto& block = shard.lru.back();
+        shard.used_size -= block.data.size();
+        shard.blocks.erase(block.key);
+        shard.lru.pop_back();
+    }
+}
+
+} // namespace FileSys
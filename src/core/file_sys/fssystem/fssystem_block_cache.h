@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/literals.h"
+
+namespace FileSys {
+
+using namespace Common::Literals;
+
+// Caches decoded blocks of storages, such as decompressed blocks and bucket tree node sets, in
+// a sharded LRU bounded by a total memory budget. Each storage using the cache allocates an owner
+// id, which keys its blocks together with their offset.
+class BlockCache {
+    YUZU_NON_COPYABLE(BlockCache);
+    YUZU_NON_MOVEABLE(BlockCache);
+
+public:
+    static constexpr size_t DefaultCapacity = 64_MiB;
+    static constexpr size_t DefaultShardCount = 16;
+
+    struct Statistics {
+        u64 hits;
+        u64 misses;
+        size_t used_size;
+    };
+
+public:
+    explicit BlockCache(size_t capacity, size_t shard_count = DefaultShardCount);
+    ~BlockCache();
+
+    // Gets the cache shared by the storages of the running title.
+    static BlockCache& GetInstance();
+
+    u64 AllocateOwner();
+
+    // Copies size bytes at skip_size into the cached block, returning false on a miss.
+    bool Read(u64 owner, s64 offset, void* dst, size_t skip_size, size_t size);
+    void Insert(u64 owner, s64 offset, const void* src, size_t size);
+    void Invalidate(u64 owner);
+
+    Statistics GetStatistics() const;
+
+private:
+    struct Key {
+        u64 owner;
+        s64 offset;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return static_cast<size_t>((key.owner * 0x9E3779B97F4A7C15ULL) ^
+                                       static_cast<u64>(key.offset));
+        }
+    };
+
+    struct Block {
+        Key key;
+        std::vector<u8> data;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<Block> lru;
+        std::unordered_map<Key, std::list<Block>::iterator, KeyHash> blocks;
+        size_t used_size{};
+    };
+
+    Shard& GetShard(const Key& key) {
+        return m_shards[KeyHash{}(key) % m_shard_count];
+    }
+
+    void EvictLocked(Shard& shard, size_t required_size);
+
+private:
+    std::unique_ptr<Shard[]> m_shards;
+    size_t m_shard_count;
+    size_t m_shard_capacity;
+    std::atomic<u64> m_next_owner{1};
+    std::atomic<u64> m_hits{};
+    std::atomic<u64> m_misses{};
+};
+
+} // namespace FileSys
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "core/file_sys/errors.h"
+#include "core/file_sys/fssystem/fssystem_block_cache.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree_utils.h"
 #include "core/file_sys/fssystem/fssystem_pooled_buffer.h"
@@ -245,6 +246,10 @@ void BucketTree::Initialize(size_t node_size, s64 end_offset) {
 
 void BucketTree::Finalize() {
     if (this->IsInitialized()) {
+        this->InvalidateBlockCache();
+        m_node_cache_owner = 0;
+        m_entry_cache_owner = 0;
+
         m_node_storage = VirtualFile();
         m_entry_storage = VirtualFile();
         m_node_l1.Free(m_node_size);
@@ -279,9 +284,46 @@ Result BucketTree::InvalidateCache() {
     // Reset our offsets.
     m_offset_cache.is_initialized = false;
 
+    // Drop any node sets we cached.
+    this->InvalidateBlockCache();
+
     R_SUCCEED();
 }
 
+void BucketTree::EnableBlockCache() {
+    ASSERT(this->IsInitialized());
+
+    if (m_node_cache_owner == 0) {
+        auto& cache = BlockCache::GetInstance();
+        m_node_cache_owner = cache.AllocateOwner();
+        m_entry_cache_owner = cache.AllocateOwner();
+    }
+}
+
+void BucketTree::ReadNodeSet(const VirtualFile& storage, u64 cache_owner, char* buffer,
+                             size_t size, s64 offset) const {
+    // Read the node set directly, if we aren't caching.
+    if (cache_owner == 0) {
+        storage->Read(reinterpret_cast<u8*>(buffer), size, offset);
+        return;
+    }
+
+    // Otherwise, read it through the cache.
+    auto& cache = BlockCache::GetInstance();
+    if (!cache.Read(cache_owner, offset, buffer, 0, size)) {
+        storage->Read(reinterpret_cast<u8*>(buffer), size, offset);
+        cache.Insert(cache_owner, offset, buffer, size);
+    }
+}
+
+void BucketTree::InvalidateBlockCache() {
+    if (m_node_cache_owner != 0) {
+        auto& cache = BlockCache::GetInstance();
+        cache.Invalidate(m_node_cache_owner);
+        cache.Invalidate(m_entry_cache_owner);
+    }
+}
+
 Result BucketTree::EnsureOffsetCache() {
     // If we already have an offset cache, we're good.
     R_SUCCEED_IF(m_offset_cache.is_initialized);
@@ -481,7 +523,7 @@ Result BucketTree::Visitor::FindEntrySetWithBuffer(s32* out_index, s64 virtual_a
     VirtualFile storage = m_tree->m_node_storage;
 
     // Read the node.
-    storage->Read(reinterpret_cast<u8*>(buffer), node_size, node_offset);
+    m_tree->ReadNodeSet(storage, m_tree->m_node_cache_owner, buffer, node_size, node_offset);
 
     // Validate the header.
     NodeHeader header;
@@ -541,7 +583,8 @@ Result BucketTree::Visitor::FindEntryWithBuffer(s64 virtual_address, s32 entry_s
     VirtualFile storage = m_tree->m_entry_storage;
 
     // Read the entry set.
-    storage->Read(reinterpret_cast<u8*>(buffer), entry_set_size, entry_set_offset);
+    m_tree->ReadNodeSet(storage, m_tree->m_entry_cache_owner, buffer, entry_set_size,
+                        entry_set_offset);
 
     // Validate the entry_set.
     EntrySetHeader entry_set;
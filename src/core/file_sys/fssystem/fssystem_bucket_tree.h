@@ -221,7 +221,8 @@ private:
 public:
     BucketTree()
         : m_node_storage(), m_entry_storage(), m_node_l1(), m_node_size(), m_entry_size(),
-          m_entry_count(), m_offset_count(), m_entry_set_count(), m_offset_cache() {}
+          m_entry_count(), m_offset_count(), m_entry_set_count(), m_offset_cache(),
+          m_node_cache_owner(), m_entry_cache_owner() {}
     ~BucketTree() {
         this->Finalize();
     }
@@ -241,6 +242,10 @@ public:
     Result Find(Visitor* visitor, s64 virtual_address);
     Result InvalidateCache();
 
+    // Keeps the node and entry sets read by lookups in the shared block cache. Only worthwhile
+    // when the node and entry storages are not already held in memory.
+    void EnableBlockCache();
+
     s32 GetEntryCount() const {
         return m_entry_count;
     }
@@ -317,6 +322,10 @@ private:
 
     Result EnsureOffsetCache();
 
+    void ReadNodeSet(const VirtualFile& storage, u64 cache_owner, char* buffer, size_t size,
+                     s64 offset) const;
+    void InvalidateBlockCache();
+
 private:
     mutable VirtualFile m_node_storage;
     mutable VirtualFile m_entry_storage;
@@ -327,6 +336,8 @@ private:
     s32 m_offset_count;
     s32 m_entry_set_count;
     OffsetCache m_offset_cache;
+    u64 m_node_cache_owner;
+    u64 m_entry_cache_owner;
 };
 
 class BucketTree::Visitor {
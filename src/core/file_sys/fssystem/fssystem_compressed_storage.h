@@ -7,6 +7,7 @@
 
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fssystem/fs_i_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_cache.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree.h"
 #include "core/file_sys/fssystem/fssystem_compression_common.h"
 #include "core/file_sys/fssystem/fssystem_pooled_buffer.h"
@@ -71,6 +72,9 @@ private:
             R_TRY(m_table.Initialize(node_storage, entry_storage, NodeSize, sizeof(Entry),
                                      bktr_entry_count));
 
+            // Our table is read from the data storage rather than memory, so cache its nodes.
+            m_table.EnableBlockCache();
+
             // Set our other fields.
             m_block_size_max = block_size_max;
             m_continuous_reading_size_max = continuous_reading_size_max;
@@ -693,12 +697,25 @@ private:
     public:
         CacheManager() = default;
 
+        ~CacheManager() {
+            // Drop the blocks we cached.
+            if (m_cache_owner != 0) {
+                BlockCache::GetInstance().Invalidate(m_cache_owner);
+            }
+        }
+
     public:
         Result Initialize(s64 storage_size, size_t cache_size_0, size_t cache_size_1,
                           size_t max_cache_entries) {
             // Set our fields.
             m_storage_size = storage_size;
 
+            // Decompressed blocks are kept in the cache shared by all storages, rather than in
+            // caches sized per storage.
+            if (m_cache_owner == 0) {
+                m_cache_owner = BlockCache::GetInstance().AllocateOwner();
+            }
+
             R_SUCCEED();
         }
 
@@ -782,10 +799,10 @@ private:
             char* cur_dst = static_cast<char*>(buffer);
 
             // Determine our alignment.
-            const bool head_unaligned = head_range.is_block_alignment_required &&
-                                        (cur_offset != head_range.virtual_offset ||
-                                         static_cast<s64>(cur_size) < head_range.virtual_size);
-            const bool tail_unaligned = [&]() -> bool {
+            bool head_unaligned = head_range.is_block_alignment_required &&
+                                  (cur_offset != head_range.virtual_offset ||
+                                   static_cast<s64>(cur_size) < head_range.virtual_size);
+            bool tail_unaligned = [&]() -> bool {
                 if (tail_range.is_block_alignment_required) {
                     if (static_cast<s64>(cur_size + cur_offset) ==
                         tail_range.GetEndVirtualOffset()) {
@@ -801,10 +818,47 @@ private:
                 }
             }();
 
+            // Serve the unaligned head from the cache, if we have it.
+            auto& cache = BlockCache::GetInstance();
+            bool is_head_cached = false;
+            if (head_unaligned) {
+                const size_t skip_size = cur_offset - head_range.virtual_offset;
+                const size_t copy_size =
+                    std::min<size_t>(cur_size, head_range.GetEndVirtualOffset() - cur_offset);
+                if (cache.Read(m_cache_owner, head_range.virtual_offset, cur_dst, skip_size,
+                               copy_size)) {
+                    // Advance.
+                    cur_dst += copy_size;
+                    cur_offset += copy_size;
+                    cur_size -= copy_size;
+
+                    // The remaining data begins at a block boundary.
+                    head_unaligned = false;
+                    is_head_cached = true;
+                    R_SUCCEED_IF(cur_size == 0);
+                }
+            }
+
+            // Serve the unaligned tail from the cache, if we have it.
+            bool is_tail_cached = false;
+            if (tail_unaligned && cur_offset <= tail_range.virtual_offset) {
+                const size_t skip_size = tail_range.virtual_offset - cur_offset;
+                const size_t copy_size = cur_size - skip_size;
+                if (cache.Read(m_cache_owner, tail_range.virtual_offset, cur_dst + skip_size, 0,
+                               copy_size)) {
+                    // The remaining data ends at a block boundary.
+                    cur_size -= copy_size;
+                    tail_unaligned = false;
+                    is_tail_cached = true;
+                    R_SUCCEED_IF(cur_size == 0);
+                }
+            }
+
             // Determine start/end offsets.
-            const s64 start_offset =
-                head_range.is_block_alignment_required ? head_range.virtual_offset : cur_offset;
-            const s64 end_offset = tail_range.is_block_alignment_required
+            const s64 start_offset = head_range.is_block_alignment_required && !is_head_cached
+                                         ? head_range.virtual_offset
+                                         : cur_offset;
+            const s64 end_offset = tail_range.is_block_alignment_required && !is_tail_cached
                                        ? tail_range.GetEndVirtualOffset()
                                        : cur_offset + cur_size;
 
@@ -872,6 +926,10 @@ private:
                             R_THROW(rc);
                         }
 
+                        // Cache the decompressed block, as partial reads tend to be repeated.
+                        cache.Insert(m_cache_owner, unaligned_range->virtual_offset,
+                                     pooled_buffer.GetBuffer(), size_buffer_required);
+
                         // Copy the data we read to the destination.
                         const size_t skip_size = cur_offset - unaligned_range->virtual_offset;
                         const size_t copy_size = std::min<size_t>(
@@ -893,6 +951,7 @@ private:
 
     private:
         s64 m_storage_size = 0;
+        u64 m_cache_owner = 0;
     };
 
 public:
@@ -44,12 +44,11 @@ PartitionFilesystem::PartitionFilesystem(VirtualFile file) {
     std::size_t metadata_size =
         sizeof(Header) + (pfs_header.num_entries * entry_size) + pfs_header.strtab_size;
 
-    // Actually read in now...
-    std::vector<u8> file_data = file->ReadBytes(metadata_size);
-    const std::size_t total_size = file_data.size();
-    file_data.push_back(0);
+    // Actually read in now, directly from the file's memory when it is memory backed...
+    std::vector<u8> buffer;
+    const std::span<const u8> file_data = file->ReadSpan(buffer, metadata_size);
 
-    if (total_size != metadata_size) {
+    if (file_data.size() != metadata_size) {
         status = Loader::ResultStatus::ErrorIncorrectPFSFileSize;
         return;
     }
@@ -57,12 +56,17 @@ PartitionFilesystem::PartitionFilesystem(VirtualFile file) {
     std::size_t entries_offset = sizeof(Header);
     std::size_t strtab_offset = entries_offset + (pfs_header.num_entries * entry_size);
     content_offset = strtab_offset + pfs_header.strtab_size;
+    const auto strtab = file_data.subspan(strtab_offset, pfs_header.strtab_size);
     for (u16 i = 0; i < pfs_header.num_entries; i++) {
         FSEntry entry;
 
         memcpy(&entry, &file_data[entries_offset + (i * entry_size)], sizeof(FSEntry));
-        std::string name(
-            reinterpret_cast<const char*>(&file_data[strtab_offset + entry.strtab_offset]));
+
+        // The string table is not necessarily terminated, so names are bounded by its end.
+        const auto name_data =
+            strtab.subspan(std::min<std::size_t>(entry.strtab_offset, strtab.size()));
+        std::string name(reinterpret_cast<const char*>(name_data.data()),
+                         std::find(name_data.begin(), name_data.end(), u8{0}) - name_data.begin());
 
         offsets.insert_or_assign(name, content_offset + entry.offset);
         sizes.insert_or_assign(name, entry.size);
@@ -17,11 +17,14 @@
 #include "core/file_sys/common_funcs.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/control_metadata.h"
+#include "core/file_sys/fsmitm_romfsbuild.h"
 #include "core/file_sys/ips_layer.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/romfs.h"
+#include "core/file_sys/romfs_build_cache.h"
 #include "core/file_sys/vfs/vfs_cached.h"
+#include "core/file_sys/vfs/vfs_concat.h"
 #include "core/file_sys/vfs/vfs_layered.h"
 #include "core/file_sys/vfs/vfs_vector.h"
 #include "core/hle/service/filesystem/filesystem.h"
@@ -377,16 +380,16 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 
         auto romfs_dir = FindSubdirectoryCaseless(subdir, "romfs");
         if (romfs_dir != nullptr)
-            layers.emplace_back(std::make_shared<CachedVfsDirectory>(std::move(romfs_dir)));
+            layers.emplace_back(std::move(romfs_dir));
 
         auto ext_dir = FindSubdirectoryCaseless(subdir, "romfs_ext");
         if (ext_dir != nullptr)
-            layers_ext.emplace_back(std::make_shared<CachedVfsDirectory>(std::move(ext_dir)));
+            layers_ext.emplace_back(std::move(ext_dir));
 
         if (type == ContentRecordType::HtmlDocument) {
             auto manual_dir = FindSubdirectoryCaseless(subdir, "manual_html");
             if (manual_dir != nullptr)
-                layers.emplace_back(std::make_shared<CachedVfsDirectory>(std::move(manual_dir)));
+                layers.emplace_back(std::move(manual_dir));
         }
     }
 
@@ -395,6 +398,21 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
         return;
     }
 
+    // Reuse the RomFS built on a previous boot if neither the base RomFS nor the mods changed
+    const RomFSBuildCache cache{title_id, type, romfs, {load_dir, sdmc_load_dir}, layers,
+                                layers_ext};
+    if (auto cached = cache.Load()) {
+        LOG_INFO(Loader, "    RomFS: LayeredFS patches applied from cache");
+        romfs = std::move(cached);
+        return;
+    }
+
+    const auto make_cached = [](VirtualDir& dir) {
+        dir = std::make_shared<CachedVfsDirectory>(std::move(dir));
+    };
+    std::for_each(layers.begin(), layers.end(), make_cached);
+    std::for_each(layers_ext.begin(), layers_ext.end(), make_cached);
+
     auto extracted = ExtractRomFS(romfs);
     if (extracted == nullptr) {
         return;
@@ -409,7 +427,12 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 
     auto layered_ext = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers_ext));
 
-    auto packed = CreateRomFS(std::move(layered), std::move(layered_ext));
+    RomFSBuildContext ctx{layered, std::move(layered_ext)};
+    auto entries = ctx.Build();
+    cache.Save(layered->GetName(), entries);
+
+    auto packed =
+        ConcatenatedVfsFile::MakeConcatenatedFile(0, layered->GetName(), std::move(entries));
     if (packed == nullptr) {
         return;
     }
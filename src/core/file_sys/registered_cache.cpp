@@ -2,8 +2,11 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <random>
 #include <regex>
+#include <thread>
 #include <mbedtls/sha256.h>
 #include "common/assert.h"
 #include "common/fs/path_util.h"
@@ -614,6 +617,7 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
     }
 
     // Install all the other NCAs
+    std::vector<std::pair<std::shared_ptr<NCA>, NcaID>> ncas_to_install;
     for (const auto& record : cnmt.GetContentRecords()) {
         // Ignore DeltaFragments, they are not useful to us
         if (record.type == ContentRecordType::DeltaFragment) {
@@ -633,10 +637,12 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
             }
             continue;
         }
-        const auto nca_result = RawInstallNCA(*nca, copy, overwrite_if_exists, record.nca_id);
-        if (nca_result != InstallResult::Success) {
-            return nca_result;
-        }
+        ncas_to_install.emplace_back(nca, record.nca_id);
+    }
+
+    const auto nca_result = RawInstallNCAs(ncas_to_install, copy, overwrite_if_exists);
+    if (nca_result != InstallResult::Success) {
+        return nca_result;
     }
 
     Refresh();
@@ -802,6 +808,54 @@ InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFuncti
                                                   : InstallResult::ErrorCopyFailed;
 }
 
+InstallResult RegisteredCache::RawInstallNCAs(
+    const std::vector<std::pair<std::shared_ptr<NCA>, NcaID>>& ncas, const VfsCopyFunction& copy,
+    bool overwrite_if_exists) {
+    // Copying a few NCAs at once keeps the disks busy while each copy waits on its reads.
+    constexpr size_t MaxInstallThreads = 4;
+
+    std::atomic<size_t> next_nca{};
+    std::atomic_bool failed{};
+    InstallResult first_failure = InstallResult::Success;
+
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto Worker = [&] {
+        for (size_t i = next_nca++; i < ncas.size() && !failed; i = next_nca++) {
+            const auto& [nca, id] = ncas[i];
+            const auto result = RawInstallNCA(*nca, copy, overwrite_if_exists, id);
+
+            // Stop the other workers on the first failure, keeping its result.
+            if (result != InstallResult::Success && !failed.exchange(true)) {
+                first_failure = result;
+            }
+        }
+    };
+
+    {
+        const size_t num_threads = std::min(ncas.size(), MaxInstallThreads);
+        std::vector<std::jthread> threads;
+        threads.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; i++) {
+            threads.emplace_back(Worker);
+        }
+    }
+
+    if (failed) {
+        return first_failure;
+    }
+
+    size_t total_size = 0;
+    for (const auto& [nca, id] : ncas) {
+        total_size += nca->GetBaseFile()->GetSize();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+    LOG_INFO(Loader, "Installed {} NCAs ({} MiB) in {:.2f}s, {:.1f} MiB/s", ncas.size(),
+             total_size >> 20, elapsed.count(),
+             static_cast<double>(total_size >> 20) / std::max(elapsed.count(), 0.001));
+
+    return InstallResult::Success;
+}
+
 bool RegisteredCache::RawInstallYuzuMeta(const CNMT& cnmt) {
     // Reasoning behind this method can be found in the comment for InstallEntry, NCA overload.
     const auto meta_dir = dir->CreateDirectoryRelative("yuzu_meta");
@@ -157,7 +157,8 @@ public:
         std::optional<u64> title_id = {}) const override;
 
     // Raw copies all the ncas from the xci/nsp to the csache. Does some quick checks to make sure
-    // there is a meta NCA and all of them are accessible.
+    // there is a meta NCA and all of them are accessible. The ncas are copied concurrently, so the
+    // copy function may be called from several threads at once.
     InstallResult InstallEntry(const XCI& xci, bool overwrite_if_exists = false,
                                const VfsCopyFunction& copy = &VfsRawCopy);
     InstallResult InstallEntry(const NSP& nsp, bool overwrite_if_exists = false,
@@ -190,6 +191,8 @@ private:
     VirtualFile OpenFileOrDirectoryConcat(const VirtualDir& open_dir, std::string_view path) const;
     InstallResult RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
                                 bool overwrite_if_exists, std::optional<NcaID> override_id = {});
+    InstallResult RawInstallNCAs(const std::vector<std::pair<std::shared_ptr<NCA>, NcaID>>& ncas,
+                                 const VfsCopyFunction& copy, bool overwrite_if_exists);
     bool RawInstallYuzuMeta(const CNMT& cnmt);
 
     VirtualDir dir;
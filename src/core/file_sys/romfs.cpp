@@ -58,14 +58,17 @@ static_assert(sizeof(FileEntry) == 0x20, "FileEntry has incorrect size.");
 struct RomFSTraversalContext {
     RomFSHeader header;
     VirtualFile file;
-    std::vector<u8> directory_meta;
-    std::vector<u8> file_meta;
+    // Views of the metadata tables, pointing into the buffers if the file is not memory backed.
+    std::vector<u8> directory_meta_buffer;
+    std::vector<u8> file_meta_buffer;
+    std::span<const u8> directory_meta;
+    std::span<const u8> file_meta;
 };
 
 template <typename EntryType, auto Member>
 std::pair<EntryType, std::string> GetEntry(const RomFSTraversalContext& ctx, size_t offset) {
     const size_t entry_end = offset + sizeof(EntryType);
-    const std::vector<u8>& vec = ctx.*Member;
+    const std::span<const u8> vec = ctx.*Member;
     const size_t size = vec.size();
     const u8* data = vec.data();
     EntryType entry{};
@@ -143,8 +146,10 @@ VirtualDir ExtractRomFS(VirtualFile file) {
 
     ctx.file = file;
     ctx.directory_meta =
-        file->ReadBytes(ctx.header.directory_meta.size, ctx.header.directory_meta.offset);
-    ctx.file_meta = file->ReadBytes(ctx.header.file_meta.size, ctx.header.file_meta.offset);
+        file->ReadSpan(ctx.directory_meta_buffer, ctx.header.directory_meta.size,
+                       ctx.header.directory_meta.offset);
+    ctx.file_meta = file->ReadSpan(ctx.file_meta_buffer, ctx.header.file_meta.size,
+                                   ctx.header.file_meta.offset);
 
     ProcessDirectory(ctx, 0, root_container);
 
@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "core/file_sys/romfs_build_cache.h"
+#include "core/file_sys/vfs/vfs_concat.h"
+#include "core/file_sys/vfs/vfs_offset.h"
+#include "core/file_sys/vfs/vfs_real.h"
+
+namespace FileSys {
+namespace {
+
+using namespace Common::Literals;
+
+constexpr u32 CacheMagic = Common::MakeMagic('Y', 'R', 'F', 'C');
+constexpr u32 CacheVersion = 1;
+
+// Files which are neither part of the base RomFS nor of a mod are stored in the cache, up to this
+// total size. Larger results are not cached.
+constexpr std::size_t MaxStoredDataSize = 256_MiB;
+
+struct TableLocation {
+    u64 offset;
+    u64 size;
+};
+
+struct RomFSHeader {
+    u64 header_size;
+    std::array<TableLocation, 4> tables;
+    u64 data_offset;
+};
+static_assert(sizeof(RomFSHeader) == 0x50, "RomFSHeader has incorrect size.");
+
+struct CacheHeader {
+    u32 magic;
+    u32 version;
+    u64 title_id;
+    u64 base_hash;
+    u64 layers_hash;
+    u64 num_entries;
+    u64 name_size;
+    u64 strings_size;
+    u64 data_offset;
+};
+static_assert(sizeof(CacheHeader) == 0x40, "CacheHeader has incorrect size.");
+
+enum class EntrySource : u8 {
+    BaseRomFS, // source_offset is the offset of the file within the base RomFS.
+    ModFile,   // source_offset is the offset of the path of the file within the string table.
+    CacheFile, // source_offset is the offset of the file within the stored data.
+};
+
+struct CacheEntry {
+    u64 offset;
+    u64 size;
+    u64 source_offset;
+    u32 path_size;
+    EntrySource source;
+    u8 root_index;
+    INSERT_PADDING_BYTES(2);
+};
+static_assert(sizeof(CacheEntry) == 0x20, "CacheEntry has incorrect size.");
+
+std::filesystem::path GetCachePath(u64 title_id, ContentRecordType type) {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "romfs" /
+           fmt::format("{:016X}_{:02X}.bin", title_id, static_cast<u8>(type));
+}
+
+RealVfsFilesystem& GetCacheFilesystem() {
+    static RealVfsFilesystem filesystem;
+    return filesystem;
+}
+
+// Hashes the header and tables of a RomFS, which identify its files along with their sizes and
+// offsets, without reading the data of the files.
+std::optional<u64> HashRomFSMetadata(const VirtualFile& romfs) {
+    RomFSHeader header{};
+    if (romfs->ReadObject(&header) != sizeof(RomFSHeader) ||
+        header.header_size != sizeof(RomFSHeader)) {
+        return std::nullopt;
+    }
+
+    u64 hash = Common::CityHash64(reinterpret_cast<const char*>(&header), sizeof(RomFSHeader));
+    std::vector<u8> buffer;
+    for (const auto& table : header.tables) {
+        const auto data = romfs->ReadSpan(buffer, table.size, table.offset);
+        if (data.size() != table.size) {
+            return std::nullopt;
+        }
+        hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(data.data()), data.size(),
+                                          hash);
+    }
+    return hash;
+}
+
+} // Anonymous namespace
+
+RomFSBuildCache::RomFSBuildCache(u64 title_id_, ContentRecordType type_, VirtualFile base_romfs_,
+                                 std::vector<VirtualDir> roots_,
+                                 const std::vector<VirtualDir>& layers,
+                                 const std::vector<VirtualDir>& ext_layers)
+    : title_id{title_id_}, type{type_}, base_romfs{std::move(base_romfs_)},
+      roots{std::move(roots_)} {
+    for (const auto& root : roots) {
+        root_paths.push_back(root != nullptr ? root->GetFullPath() : std::string{});
+    }
+
+    const auto metadata_hash = HashRomFSMetadata(base_romfs);
+    if (!metadata_hash) {
+        return;
+    }
+    base_hash = *metadata_hash;
+
+    is_valid = FingerprintLayers(layers, 'L') && FingerprintLayers(ext_layers, 'E');
+}
+
+RomFSBuildCache::~RomFSBuildCache() = default;
+
+bool RomFSBuildCache::FingerprintLayers(const std::vector<VirtualDir>& layers, char tag) {
+    for (const auto& layer : layers) {
+        // Only mods on the host filesystem can be fingerprinted.
+        const auto host_path = layer->GetFullPath();
+        if (!Common::FS::IsDir(host_path)) {
+            return false;
+        }
+
+        // Any file or directory which is added, removed, resized or modified changes the hash.
+        // Entries are sorted, as the order of iteration is not guaranteed to be stable.
+        std::vector<std::string> records;
+        Common::FS::IterateDirEntriesRecursively(
+            host_path, [&records](const std::filesystem::directory_entry& entry) {
+                std::error_code ec;
+                const bool is_directory = entry.is_directory(ec);
+                const u64 size = is_directory ? 0 : entry.file_size(ec);
+                const auto write_time = entry.last_write_time(ec).time_since_epoch().count();
+                records.push_back(fmt::format("{}|{}|{}|{}",
+                                              Common::FS::PathToUTF8String(entry.path()),
+                                              is_directory, size, write_time));
+                return true;
+            });
+        std::sort(records.begin(), records.end());
+
+        records.insert(records.begin(), fmt::format("{}{}", tag, host_path));
+        for (const auto& record : records) {
+            layers_hash = Common::CityHash64WithSeed(record.data(), record.size(), layers_hash);
+        }
+    }
+
+    return true;
+}
+
+VirtualFile RomFSBuildCache::Load() const {
+    if (!is_valid) {
+        return nullptr;
+    }
+
+    const auto file = GetCacheFilesystem().OpenFile(
+        Common::FS::PathToUTF8String(GetCachePath(title_id, type)), OpenMode::Read);
+    if (file == nullptr) {
+        return nullptr;
+    }
+
+    CacheHeader header{};
+    if (file->ReadObject(&header) != sizeof(CacheHeader) || header.magic != CacheMagic ||
+        header.version != CacheVersion || header.title_id != title_id ||
+        header.base_hash != base_hash || header.layers_hash != layers_hash) {
+        return nullptr;
+    }
+
+    const u64 file_size = file->GetSize();
+    const u64 entries_size = header.num_entries * sizeof(CacheEntry);
+    if (header.num_entries > file_size / sizeof(CacheEntry) ||
+        entries_size + header.strings_size > file_size) {
+        return nullptr;
+    }
+
+    std::vector<u8> buffer;
+    const auto tables =
+        file->ReadSpan(buffer, entries_size + header.strings_size, sizeof(CacheHeader));
+    if (tables.size() != entries_size + header.strings_size) {
+        return nullptr;
+    }
+
+    const auto strings = tables.subspan(entries_size);
+    const auto get_string = [&strings](u64 offset, u64 size) -> std::optional<std::string> {
+        if (offset > strings.size() || size > strings.size() - offset) {
+            return std::nullopt;
+        }
+        return std::string(reinterpret_cast<const char*>(strings.data() + offset), size);
+    };
+
+    std::vector<std::pair<u64, VirtualFile>> entries;
+    entries.reserve(header.num_entries);
+    for (u64 i = 0; i < header.num_entries; i++) {
+        CacheEntry entry{};
+        std::memcpy(&entry, tables.data() + i * sizeof(CacheEntry), sizeof(CacheEntry));
+
+        VirtualFile source;
+        switch (entry.source) {
+        case EntrySource::BaseRomFS:
+            source = std::make_shared<OffsetVfsFile>(base_romfs, entry.size, entry.source_offset);
+            break;
+        case EntrySource::ModFile: {
+            const auto path = get_string(entry.source_offset, entry.path_size);
+            if (!path || entry.root_index >= roots.size() || roots[entry.root_index] == nullptr) {
+                return nullptr;
+            }
+            source = roots[entry.root_index]->GetFileRelative(*path);
+            break;
+        }
+        case EntrySource::CacheFile:
+            if (header.data_offset + entry.source_offset + entry.size > file_size) {
+                return nullptr;
+            }
+            source = std::make_shared<OffsetVfsFile>(file, entry.size,
+                                                     header.data_offset + entry.source_offset);
+            break;
+        }
+
+        if (source == nullptr) {
+            return nullptr;
+        }
+        entries.emplace_back(entry.offset, std::move(source));
+    }
+
+    auto name = get_string(0, header.name_size);
+    if (!name) {
+        return nullptr;
+    }
+
+    return ConcatenatedVfsFile::MakeConcatenatedFile(0, std::move(*name), std::move(entries));
+}
+
+void RomFSBuildCache::Save(const std::string& name,
+                           const std::vector<std::pair<u64, VirtualFile>>& entries) const {
+    if (!is_valid) {
+        return;
+    }
+
+    std::vector<CacheEntry> cache_entries;
+    cache_entries.reserve(entries.size());
+    std::string strings = name;
+    std::vector<u8> data;
+
+    for (const auto& [offset, file] : entries) {
+        CacheEntry entry{
+            .offset = offset,
+            .size = file->GetSize(),
+        };
+
+        const auto* const offset_file = dynamic_cast<const OffsetVfsFile*>(file.get());
+        if (offset_file != nullptr && offset_file->GetBaseFile() == base_romfs) {
+            entry.source = EntrySource::BaseRomFS;
+            entry.source_offset = offset_file->GetOffset();
+        } else if (dynamic_cast<const RealVfsFile*>(file.get()) != nullptr) {
+            const auto path = file->GetFullPath();
+            const auto root = std::find_if(
+                root_paths.begin(), root_paths.end(), [&path](const std::string& root_path) {
+                    return !root_path.empty() && path.starts_with(root_path + '/');
+                });
+            if (root == root_paths.end()) {
+                LOG_WARNING(Loader, "Not caching RomFS, {} is outside of the mod roots", path);
+                return;
+            }
+
+            const auto relative_path = path.substr(root->size() + 1);
+            entry.source = EntrySource::ModFile;
+            entry.root_index = static_cast<u8>(std::distance(root_paths.begin(), root));
+            entry.source_offset = strings.size();
+            entry.path_size = static_cast<u32>(relative_path.size());
+            strings += relative_path;
+        } else {
+            if (data.size() + entry.size > MaxStoredDataSize) {
+                LOG_INFO(Loader, "Not caching RomFS, the generated data is too large");
+                return;
+            }
+
+            const auto bytes = file->ReadAllBytes();
+            if (bytes.size() != entry.size) {
+                return;
+            }
+            entry.source = EntrySource::CacheFile;
+            entry.source_offset = data.size();
+            data.insert(data.end(), bytes.begin(), bytes.end());
+        }
+
+        cache_entries.push_back(entry);
+    }
+
+    const auto path = GetCachePath(title_id, type);
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Loader, "Failed to create RomFS cache directory");
+        return;
+    }
+
+    // The cache is written to a temporary file and moved into place, as a previous version of it
+    // may still be mapped by a RomFS loaded earlier.
+    auto temp_path = path;
+    temp_path += ".tmp";
+
+    const CacheHeader header{
+        .magic = CacheMagic,
+        .version = CacheVersion,
+        .title_id = title_id,
+        .base_hash = base_hash,
+        .layers_hash = layers_hash,
+        .num_entries = cache_entries.size(),
+        .name_size = name.size(),
+        .strings_size = strings.size(),
+        .data_offset = sizeof(CacheHeader) + cache_entries.size() * sizeof(CacheEntry) +
+                       strings.size(),
+    };
+
+    {
+        Common::FS::IOFile file{temp_path, Common::FS::FileAccessMode::Write,
+                                Common::FS::FileType::BinaryFile};
+        const bool success = file.IsOpen() && file.WriteObject(header) &&
+                             file.WriteSpan<CacheEntry>(cache_entries) == cache_entries.size() &&
+                             file.WriteSpan<char>(strings) == strings.size() &&
+                             file.WriteSpan<u8>(data) == data.size();
+        if (!success) {
+            LOG_ERROR(Loader, "Failed to write RomFS cache {}",
+                      Common::FS::PathToUTF8String(temp_path));
+            return;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        LOG_ERROR(Loader, "Failed to replace RomFS cache {}, ec_message={}",
+                  Common::FS::PathToUTF8String(path), ec.message());
+        return;
+    }
+
+    LOG_INFO(Loader, "Saved RomFS layout with {} files to cache", cache_entries.size());
+}
+
+} // namespace FileSys
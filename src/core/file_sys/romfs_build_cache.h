@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+enum class ContentRecordType : u8;
+
+// Persists the layout of a RomFS built from LayeredFS mods, so that later boots with the same base
+// RomFS and unchanged mod directories can skip walking the mods and rebuilding the RomFS.
+//
+// Files of the result are recorded as ranges of the base RomFS or as paths relative to one of the
+// mod load roots. The generated header and tables, and any IPS patched files, are stored in the
+// cache file itself and read from there.
+class RomFSBuildCache {
+public:
+    // Fingerprints the base RomFS and the host directories of the given layers, ordered by
+    // priority. Files of the layers must reside within one of the roots.
+    explicit RomFSBuildCache(u64 title_id, ContentRecordType type, VirtualFile base_romfs,
+                             std::vector<VirtualDir> roots, const std::vector<VirtualDir>& layers,
+                             const std::vector<VirtualDir>& ext_layers);
+    ~RomFSBuildCache();
+
+    // Returns the RomFS recorded by a previous boot, or nullptr if there is none or it is stale.
+    VirtualFile Load() const;
+
+    // Records the entries of a RomFS built from the layers on top of the base RomFS.
+    void Save(const std::string& name,
+              const std::vector<std::pair<u64, VirtualFile>>& entries) const;
+
+private:
+    bool FingerprintLayers(const std::vector<VirtualDir>& layers, char tag);
+
+    u64 title_id;
+    ContentRecordType type;
+    VirtualFile base_romfs;
+    std::vector<VirtualDir> roots;
+    std::vector<std::string> root_paths;
+    u64 base_hash{};
+    u64 layers_hash{};
+    bool is_valid{};
+};
+
+} // namespace FileSys
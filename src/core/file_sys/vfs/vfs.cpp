@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <array>
+#include <future>
 #include <numeric>
 #include <string>
 #include "common/fs/path_util.h"
@@ -183,6 +185,25 @@ std::vector<u8> VfsFile::ReadAllBytes() const {
     return ReadBytes(GetSize());
 }
 
+std::span<const u8> VfsFile::GetSpan(std::size_t size, std::size_t offset) const {
+    return {};
+}
+
+std::span<const u8> VfsFile::ReadSpan(std::vector<u8>& buffer, std::size_t size,
+                                      std::size_t offset) const {
+    if (const auto span = GetSpan(size, offset); span.size() == size) {
+        return span;
+    }
+
+    buffer = ReadBytes(size, offset);
+    return buffer;
+}
+
+std::size_t VfsFile::CopyRangeFrom(const VirtualFile& src, std::size_t length,
+                                   std::size_t src_offset, std::size_t offset) {
+    return 0;
+}
+
 bool VfsFile::WriteByte(u8 data, std::size_t offset) {
     return Write(&data, 1, offset) == 1;
 }
@@ -191,6 +212,10 @@ std::size_t VfsFile::WriteBytes(const std::vector<u8>& data, std::size_t offset)
     return Write(data.data(), data.size(), offset);
 }
 
+bool VfsFile::Replace(std::span<const u8> data) {
+    return Resize(data.size()) && Write(data.data(), data.size(), 0) == data.size();
+}
+
 std::string VfsFile::GetFullPath() const {
     if (GetContainingDirectory() == nullptr)
         return '/' + GetName();
@@ -507,6 +532,10 @@ bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t blo
     if (!dest->Resize(src->GetSize()))
         return false;
 
+    // Let the OS copy the data directly when possible.
+    if (dest->CopyRangeFrom(src, src->GetSize(), 0, 0) == src->GetSize())
+        return true;
+
     std::vector<u8> temp(std::min(block_size, src->GetSize()));
     for (std::size_t i = 0; i < src->GetSize(); i += block_size) {
         const auto read = std::min(block_size, src->GetSize() - i);
@@ -523,6 +552,80 @@ bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t blo
     return true;
 }
 
+bool VfsStreamCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size,
+                   const std::function<bool(std::size_t)>& progress) {
+    if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable()) {
+        return false;
+    }
+
+    const std::size_t size = src->GetSize();
+    if (!dest->Resize(size)) {
+        return false;
+    }
+
+    const auto cancel = [&](std::size_t offset) {
+        if (progress && progress(offset)) {
+            dest->Resize(0);
+            return true;
+        }
+        return false;
+    };
+
+    // Let the OS copy the data directly when possible. If the first block can not be copied this
+    // way, none of the others can.
+    std::size_t offset = 0;
+    while (offset < size) {
+        const std::size_t length = std::min(block_size, size - offset);
+        const std::size_t copied = dest->CopyRangeFrom(src, length, offset, offset);
+        offset += copied;
+        if (copied != length) {
+            break;
+        }
+        if (offset < size && cancel(offset)) {
+            return false;
+        }
+    }
+
+    // Copy the rest through memory, reading the next block in the background while the current
+    // one is written.
+    std::array<std::vector<u8>, 2> buffers{std::vector<u8>(block_size),
+                                           std::vector<u8>(block_size)};
+    const auto read_block = [&](std::size_t index, std::size_t block_offset) {
+        return std::async(std::launch::async, [&src, &buffer = buffers[index], block_offset, size] {
+            return src->Read(buffer.data(), std::min(buffer.size(), size - block_offset),
+                             block_offset);
+        });
+    };
+
+    std::future<std::size_t> pending_read;
+    if (offset < size) {
+        pending_read = read_block(0, offset);
+    }
+    for (std::size_t index = 0; offset < size; index ^= 1) {
+        const std::size_t length = std::min(block_size, size - offset);
+        if (pending_read.get() != length) {
+            return false;
+        }
+
+        const std::size_t next_offset = offset + length;
+        if (next_offset < size) {
+            pending_read = read_block(index ^ 1, next_offset);
+        }
+
+        const bool cancelled = cancel(offset);
+        if (cancelled || dest->Write(buffers[index].data(), length, offset) != length) {
+            // The pending read uses the buffers, so it must finish first.
+            if (pending_read.valid()) {
+                pending_read.wait();
+            }
+            return false;
+        }
+        offset = next_offset;
+    }
+
+    return true;
+}
+
 bool VfsRawCopyD(const VirtualDir& src, const VirtualDir& dest, std::size_t block_size) {
     if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable())
         return false;
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -118,6 +119,21 @@ public:
     // 0)'
     virtual std::vector<u8> ReadAllBytes() const;
 
+    // Returns a view of size bytes starting at offset directly into the backing memory of the
+    // file, or an empty span if the file is not memory backed or the range is out of bounds. The
+    // view stays valid for as long as the file is alive and is not written to or resized.
+    virtual std::span<const u8> GetSpan(std::size_t size, std::size_t offset = 0) const;
+    // Returns a view of size bytes starting at offset, without copying if the file is memory
+    // backed. Otherwise the bytes are read into buffer, which then backs the returned view.
+    std::span<const u8> ReadSpan(std::vector<u8>& buffer, std::size_t size,
+                                 std::size_t offset = 0) const;
+
+    // Copies length bytes starting at src_offset in src to offset in this file without reading
+    // them into memory, if both files support it. Returns the number of bytes copied, which is 0
+    // if such a copy is not supported between the files.
+    virtual std::size_t CopyRangeFrom(const VirtualFile& src, std::size_t length,
+                                      std::size_t src_offset, std::size_t offset);
+
     // Reads an array of type T, size number_elements starting at offset.
     // Returns the number of bytes (sizeof(T)*number_elements) read successfully.
     template <typename T>
@@ -149,6 +165,10 @@ public:
     // Writes a vector of bytes to offset in file and returns the number of bytes successfully
     // written.
     virtual std::size_t WriteBytes(const std::vector<u8>& data, std::size_t offset = 0);
+    // Replaces the contents of the file with data and returns whether or not it was successful.
+    // Implementations may do so atomically, so that either the old or the new contents are kept
+    // if the operation is interrupted.
+    virtual bool Replace(std::span<const u8> data);
 
     // Writes an array of type T, size number_elements to offset in file.
     // Returns the number of bytes (sizeof(T)*number_elements) written successfully.
@@ -314,6 +334,12 @@ bool DeepEquals(const VirtualFile& file1, const VirtualFile& file2,
 // directory of src/dest.
 bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size = 0x1000);
 
+// A method that copies src to dest like VfsRawCopy above, but reads each block while the previous
+// one is being written. progress is called with the number of bytes copied before each block, and
+// returning true from it cancels the copy. Meant for large files, with a large block_size.
+bool VfsStreamCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size,
+                   const std::function<bool(std::size_t)>& progress = {});
+
 // A method that performs a similar function to VfsRawCopy above, but instead copies entire
 // directories. It suffers the same performance penalties as above and an implementation-specific
 // Copy should always be preferred.
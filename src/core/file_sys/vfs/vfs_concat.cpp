@@ -181,6 +181,28 @@ std::size_t ConcatenatedVfsFile::Read(u8* data, std::size_t length, std::size_t
     return cur_offset - offset;
 }
 
+std::span<const u8> ConcatenatedVfsFile::GetSpan(std::size_t length, std::size_t offset) const {
+    const ConcatenationEntry key{
+        .offset = offset,
+        .file = nullptr,
+    };
+
+    if (concatenation_map.empty()) {
+        return {};
+    }
+
+    // Views can only be given for ranges that lie entirely within a single file.
+    const auto it =
+        std::prev(std::upper_bound(concatenation_map.begin(), concatenation_map.end(), key));
+    const u64 file_seek = offset - it->offset;
+    const u64 file_size = it->file->GetSize();
+    if (file_seek > file_size || length > file_size - file_seek) {
+        return {};
+    }
+
+    return it->file->GetSpan(length, file_seek);
+}
+
 std::size_t ConcatenatedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
     return 0;
 }
@@ -72,6 +72,14 @@ std::vector<u8> OffsetVfsFile::ReadAllBytes() const {
     return file->ReadBytes(size, offset);
 }
 
+std::span<const u8> OffsetVfsFile::GetSpan(std::size_t r_size, std::size_t r_offset) const {
+    if (r_offset > size || r_size > size - r_offset) {
+        return {};
+    }
+
+    return file->GetSpan(r_size, offset + r_offset);
+}
+
 bool OffsetVfsFile::WriteByte(u8 data, std::size_t r_offset) {
     if (r_offset < size)
         return file->WriteByte(data, offset + r_offset);
@@ -91,6 +99,10 @@ std::size_t OffsetVfsFile::GetOffset() const {
     return offset;
 }
 
+VirtualFile OffsetVfsFile::GetBaseFile() const {
+    return file;
+}
+
 std::size_t OffsetVfsFile::TrimToFit(std::size_t r_size, std::size_t r_offset) const {
     return std::clamp(r_size, std::size_t{0}, size - r_offset);
 }
@@ -30,12 +30,14 @@ public:
     std::optional<u8> ReadByte(std::size_t offset) const override;
     std::vector<u8> ReadBytes(std::size_t size, std::size_t offset) const override;
     std::vector<u8> ReadAllBytes() const override;
+    std::span<const u8> GetSpan(std::size_t size, std::size_t offset) const override;
     bool WriteByte(u8 data, std::size_t offset) override;
     std::size_t WriteBytes(const std::vector<u8>& data, std::size_t offset) override;
 
     bool Rename(std::string_view new_name) override;
 
     std::size_t GetOffset() const;
+    VirtualFile GetBaseFile() const;
 
 private:
     std::size_t TrimToFit(std::size_t r_size, std::size_t r_offset) const;
@@ -9,8 +9,11 @@
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/literals.h"
 #include "common/logging/log.h"
+#include "common/thread_worker.h"
 #include "core/file_sys/vfs/vfs.h"
+#include "core/file_sys/vfs/vfs_offset.h"
 #include "core/file_sys/vfs/vfs_real.h"
 
 // For FileTimeStampRaw
@@ -30,8 +33,16 @@ namespace FS = Common::FS;
 
 namespace {
 
+using namespace Common::Literals;
+
 constexpr size_t MaxOpenFiles = 512;
 
+// Number of consecutive sequential reads after which a file is read ahead.
+constexpr u32 SequentialReadThreshold = 2;
+
+// Amount of data read ahead of sequential reads.
+constexpr u64 ReadAheadSize = 2_MiB;
+
 constexpr FS::FileAccessMode ModeFlagsToFileAccessMode(OpenMode mode) {
     switch (mode) {
     case OpenMode::Read:
@@ -46,6 +57,14 @@ constexpr FS::FileAccessMode ModeFlagsToFileAccessMode(OpenMode mode) {
     }
 }
 
+// Reads ahead on platforms where the OS cannot be asked to. Reading the data brings it into the
+// OS cache, so the actual read that follows does not wait on the disk.
+Common::StatefulThreadWorker<std::vector<u8>>& GetReadAheadWorker() {
+    static Common::StatefulThreadWorker<std::vector<u8>> worker{
+        2, "VfsReadAhead", [] { return std::vector<u8>(ReadAheadSize); }};
+    return worker;
+}
+
 } // Anonymous namespace
 
 RealVfsFilesystem::RealVfsFilesystem() : VfsFilesystem(nullptr) {}
@@ -219,6 +238,14 @@ std::unique_lock<std::mutex> RealVfsFilesystem::RefreshReference(const std::stri
     return lk;
 }
 
+std::shared_ptr<FS::IOFile> RealVfsFilesystem::AcquireFile(const std::string& path,
+                                                          OpenMode perms,
+                                                          FileReference& reference) {
+    // The returned file stays open even if the reference is evicted while it is in use.
+    auto lk = this->RefreshReference(path, perms, reference);
+    return reference.file;
+}
+
 void RealVfsFilesystem::DropReference(std::unique_ptr<FileReference>&& reference) {
     std::scoped_lock lk{list_lock};
 
@@ -232,6 +259,18 @@ void RealVfsFilesystem::DropReference(std::unique_ptr<FileReference>&& reference
     }
 }
 
+void RealVfsFilesystem::CloseReference(FileReference& reference) {
+    std::scoped_lock lk{list_lock};
+
+    // Move to the closed list, so that the file is reopened on its next use.
+    this->RemoveReferenceFromListLocked(reference);
+    if (reference.file) {
+        reference.file.reset();
+        num_open_files--;
+    }
+    this->InsertReferenceIntoListLocked(reference);
+}
+
 void RealVfsFilesystem::EvictSingleReferenceLocked() {
     if (num_open_files < MaxOpenFiles || open_references.empty()) {
         return;
@@ -290,14 +329,16 @@ std::size_t RealVfsFile::GetSize() const {
     if (size) {
         return *size;
     }
-    auto lk = base.RefreshReference(path, perms, *reference);
-    return reference->file ? reference->file->GetSize() : 0;
+    std::scoped_lock lk{io_mutex};
+    const auto file = base.AcquireFile(path, perms, *reference);
+    return file ? file->GetSize() : 0;
 }
 
 bool RealVfsFile::Resize(std::size_t new_size) {
     size.reset();
-    auto lk = base.RefreshReference(path, perms, *reference);
-    return reference->file ? reference->file->SetSize(new_size) : false;
+    std::scoped_lock lk{io_mutex};
+    const auto file = base.AcquireFile(path, perms, *reference);
+    return file ? file->SetSize(new_size) : false;
 }
 
 VirtualDir RealVfsFile::GetContainingDirectory() const {
@@ -313,20 +354,165 @@ bool RealVfsFile::IsReadable() const {
 }
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
-    auto lk = base.RefreshReference(path, perms, *reference);
-    if (!reference->file || !reference->file->Seek(static_cast<s64>(offset))) {
+    // Files which are not written through us can be read positionally, so the lock is only
+    // needed to acquire the file, rather than for the duration of the read.
+    if (!IsWritable()) {
+        const auto file = base.AcquireFile(path, perms, *reference);
+        if (!file) {
+            return 0;
+        }
+
+        this->ReadAhead(file, offset, length);
+        return file->ReadAt(std::span{data, length}, offset);
+    }
+
+    std::scoped_lock lk{io_mutex};
+    const auto file = base.AcquireFile(path, perms, *reference);
+    if (!file || !file->Seek(static_cast<s64>(offset))) {
         return 0;
     }
-    return reference->file->ReadSpan(std::span{data, length});
+    return file->ReadSpan(std::span{data, length});
+}
+
+std::span<const u8> RealVfsFile::GetSpan(std::size_t length, std::size_t offset) const {
+    // Files which are written through us may change underneath the view, so they are not mapped.
+    if (IsWritable()) {
+        return {};
+    }
+
+    std::call_once(mapping_flag, [this] {
+        if (const auto file = base.AcquireFile(path, perms, *reference)) {
+            mapping = std::make_unique<FS::FileMapping>(*file);
+        }
+    });
+
+    if (!mapping || !mapping->IsMapped()) {
+        return {};
+    }
+
+    const auto contents = mapping->GetSpan();
+    if (offset > contents.size() || length > contents.size() - offset) {
+        return {};
+    }
+    return contents.subspan(offset, length);
 }
 
 std::size_t RealVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
     size.reset();
-    auto lk = base.RefreshReference(path, perms, *reference);
-    if (!reference->file || !reference->file->Seek(static_cast<s64>(offset))) {
+    std::scoped_lock lk{io_mutex};
+    const auto file = base.AcquireFile(path, perms, *reference);
+    if (!file || !file->Seek(static_cast<s64>(offset))) {
         return 0;
     }
-    return reference->file->WriteSpan(std::span{data, length});
+    return file->WriteSpan(std::span{data, length});
+}
+
+std::size_t RealVfsFile::CopyRangeFrom(const VirtualFile& src, std::size_t length,
+                                       std::size_t src_offset, std::size_t offset) {
+    // Look through the offset files that containers are made of, to the host file backing them.
+    VirtualFile source = src;
+    while (const auto* const offset_file = dynamic_cast<const OffsetVfsFile*>(source.get())) {
+        if (src_offset > offset_file->GetSize() || length > offset_file->GetSize() - src_offset) {
+            return 0;
+        }
+        src_offset += offset_file->GetOffset();
+        source = offset_file->GetBaseFile();
+    }
+
+    const auto* const real_source = dynamic_cast<const RealVfsFile*>(source.get());
+    if (real_source == nullptr || real_source == this || !IsWritable()) {
+        return 0;
+    }
+
+    const auto src_file =
+        real_source->base.AcquireFile(real_source->path, real_source->perms,
+                                      *real_source->reference);
+    if (!src_file) {
+        return 0;
+    }
+
+    size.reset();
+    std::scoped_lock lk{io_mutex};
+    const auto file = base.AcquireFile(path, perms, *reference);
+    return file ? file->CopyRangeFrom(*src_file, src_offset, offset, length) : 0;
+}
+
+void RealVfsFile::ReadAhead(const std::shared_ptr<FS::IOFile>& file, u64 offset,
+                            u64 length) const {
+    u64 prefetch_offset{};
+    u64 prefetch_size{};
+    {
+        std::scoped_lock lk{read_ahead_mutex};
+
+        const u64 end = offset + length;
+        if (offset == sequential_end) {
+            sequential_count = std::min(sequential_count + 1, SequentialReadThreshold);
+        } else {
+            sequential_count = 0;
+            read_ahead_end = 0;
+        }
+        sequential_end = end;
+
+        // Keep a full window read ahead, topping it up once half of it has been consumed.
+        if (sequential_count < SequentialReadThreshold ||
+            read_ahead_end > end + ReadAheadSize / 2) {
+            return;
+        }
+
+        prefetch_offset = std::max(read_ahead_end, end);
+        read_ahead_end = end + ReadAheadSize;
+        prefetch_size = read_ahead_end - prefetch_offset;
+    }
+
+    if (file->Prefetch(prefetch_offset, prefetch_size)) {
+        return;
+    }
+
+    GetReadAheadWorker().QueueWork(
+        [file, prefetch_offset, prefetch_size](std::vector<u8>* scratch) {
+            [[maybe_unused]] const auto read_size = file->ReadAt(
+                std::span{scratch->data(), static_cast<size_t>(prefetch_size)}, prefetch_offset);
+        });
+}
+
+bool RealVfsFile::Replace(std::span<const u8> data) {
+    if (!IsWritable()) {
+        return false;
+    }
+
+    // The new contents are written and synced to a temporary file first, which then takes the
+    // place of the file, so that a crash leaves either the old or the new contents behind.
+    const auto temp_path = path + ".tmp";
+    {
+        FS::IOFile temp{temp_path, FS::FileAccessMode::Write, FS::FileType::BinaryFile};
+        const bool success =
+            temp.IsOpen() && temp.WriteSpan(data) == data.size() && temp.Commit();
+        if (!success) {
+            temp.Close();
+            FS::RemoveFile(temp_path);
+            LOG_WARNING(Common_Filesystem, "Failed to write {}, replacing in place", temp_path);
+            return VfsFile::Replace(data);
+        }
+    }
+
+    size.reset();
+    std::error_code ec;
+    {
+        std::scoped_lock lk{io_mutex};
+
+        // Files cannot be replaced while open on some platforms, and an open handle would
+        // otherwise keep reading the old contents.
+        base.CloseReference(*reference);
+        std::filesystem::rename(FS::ToU8String(temp_path), FS::ToU8String(path), ec);
+    }
+    if (ec) {
+        // On Windows, the file may still be open elsewhere, such as by another process.
+        LOG_WARNING(Common_Filesystem, "Failed to replace {}, replacing in place, ec_message={}",
+                    path, ec.message());
+        FS::RemoveFile(temp_path);
+        return VfsFile::Replace(data);
+    }
+    return true;
 }
 
 bool RealVfsFile::Rename(std::string_view name) {
@@ -12,8 +12,9 @@
 #include "core/file_sys/vfs/vfs.h"
 
 namespace Common::FS {
+class FileMapping;
 class IOFile;
-}
+} // namespace Common::FS
 
 namespace FileSys {
 
@@ -57,7 +58,10 @@ private:
     friend class RealVfsFile;
     std::unique_lock<std::mutex> RefreshReference(const std::string& path, OpenMode perms,
                                                   FileReference& reference);
+    std::shared_ptr<Common::FS::IOFile> AcquireFile(const std::string& path, OpenMode perms,
+                                                    FileReference& reference);
     void DropReference(std::unique_ptr<FileReference>&& reference);
+    void CloseReference(FileReference& reference);
 
 private:
     friend class RealVfsDirectory;
@@ -85,7 +89,11 @@ public:
     bool IsWritable() const override;
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::span<const u8> GetSpan(std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::size_t CopyRangeFrom(const VirtualFile& src, std::size_t length, std::size_t src_offset,
+                              std::size_t offset) override;
+    bool Replace(std::span<const u8> data) override;
     bool Rename(std::string_view name) override;
 
 private:
@@ -93,6 +101,9 @@ private:
                 const std::string& path, OpenMode perms = OpenMode::Read,
                 std::optional<u64> size = {});
 
+    void ReadAhead(const std::shared_ptr<Common::FS::IOFile>& file, u64 offset,
+                   u64 length) const;
+
     RealVfsFilesystem& base;
     std::unique_ptr<FileReference> reference;
     std::string path;
@@ -100,6 +111,20 @@ private:
     std::vector<std::string> path_components;
     std::optional<u64> size;
     OpenMode perms;
+
+    // Serializes accesses through the file position of writable files, which no longer hold the
+    // lock of the filesystem while reading or writing.
+    mutable std::mutex io_mutex;
+
+    // Tracks sequential reads, so the data following them can be read ahead.
+    mutable std::mutex read_ahead_mutex;
+    mutable u64 sequential_end{};
+    mutable u32 sequential_count{};
+    mutable u64 read_ahead_end{};
+
+    // Read-only files are mapped into memory on the first request for a view of their contents.
+    mutable std::once_flag mapping_flag;
+    mutable std::unique_ptr<Common::FS::FileMapping> mapping;
 };
 
 // An implementation of VfsDirectory that represents a directory on the user's computer.
@@ -0,0 +1,632 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
+
+namespace FileSys {
+
+namespace {
+
+// Returns whether path is within the directory at prefix.
+bool IsWithin(std::string_view path, std::string_view prefix) {
+    return path.size() > prefix.size() && path.starts_with(prefix) &&
+           (path[prefix.size()] == '/' || path[prefix.size()] == '\\');
+}
+
+} // Anonymous namespace
+
+WriteBackCache::WriteBackCache(VirtualDir root_) : root{std::move(root_)} {
+    flush_thread = std::jthread([this](std::stop_token stop_token) { FlushThread(stop_token); });
+}
+
+WriteBackCache::~WriteBackCache() {
+    flush_thread.request_stop();
+    flush_thread.join();
+    Commit();
+
+    if (bytes_written > 0) {
+        LOG_INFO(Service_FS,
+                 "{}: {} bytes written, {} bytes committed in {} files, {} failed commits",
+                 root->GetFullPath(), bytes_written.load(), bytes_committed.load(),
+                 files_committed.load(), failed_commits.load());
+    }
+}
+
+std::shared_ptr<WriteBackCache> WriteBackCache::Open(VirtualDir root) {
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<WriteBackCache>, std::less<>> registry;
+
+    std::scoped_lock lk{registry_mutex};
+    std::erase_if(registry, [](const auto& item) { return item.second.expired(); });
+
+    auto& cache = registry[root->GetFullPath()];
+    if (auto existing = cache.lock()) {
+        return existing;
+    }
+
+    auto created = std::make_shared<WriteBackCache>(std::move(root));
+    cache = created;
+    return created;
+}
+
+VirtualDir WriteBackCache::GetRoot() {
+    return std::make_shared<WriteBackVfsDirectory>(shared_from_this(), root);
+}
+
+bool WriteBackCache::Commit() {
+    std::map<std::string, std::shared_ptr<Entry>, std::less<>> committed_entries;
+    {
+        std::scoped_lock lk{mutex};
+        committed_entries.swap(dirty_entries);
+    }
+
+    if (committed_entries.empty()) {
+        return true;
+    }
+
+    bool success = true;
+    for (const auto& [path, entry] : committed_entries) {
+        std::unique_lock lk{entry->mutex};
+        if (CommitEntry(*entry)) {
+            continue;
+        }
+
+        // Files which failed to commit stay buffered, to be retried on the next commit.
+        success = false;
+        ++failed_commits;
+        lk.unlock();
+        std::scoped_lock cache_lk{mutex};
+        dirty_entries.emplace(path, entry);
+    }
+
+    {
+        std::scoped_lock lk{mutex};
+        if (success) {
+            retry_delay = {};
+        } else {
+            const auto now = std::chrono::steady_clock::now();
+            retry_delay = std::clamp<std::chrono::steady_clock::duration>(
+                retry_delay * 2, MaxDirtyTime, MaxRetryDelay);
+            retry_time = now + retry_delay;
+            first_dirty_time = now;
+        }
+    }
+
+    LOG_DEBUG(Service_FS, "Committed {} files", committed_entries.size());
+    return success;
+}
+
+WriteBackCache::Statistics WriteBackCache::GetStatistics() const {
+    return {
+        .bytes_written = bytes_written.load(),
+        .bytes_committed = bytes_committed.load(),
+        .files_committed = files_committed.load(),
+        .failed_commits = failed_commits.load(),
+    };
+}
+
+std::shared_ptr<WriteBackCache::Entry> WriteBackCache::GetEntry(VirtualFile base) {
+    auto path = base->GetFullPath();
+
+    std::scoped_lock lk{mutex};
+    auto& weak_entry = entries[path];
+    if (auto entry = weak_entry.lock()) {
+        return entry;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->base = std::move(base);
+    entry->path = std::move(path);
+    weak_entry = entry;
+    return entry;
+}
+
+void WriteBackCache::OnWrite(const std::shared_ptr<Entry>& entry, size_t old_buffered_size,
+                             size_t new_buffered_size) {
+    bool should_commit = false;
+    {
+        std::scoped_lock lk{mutex};
+        if (dirty_entries.empty()) {
+            first_dirty_time = std::chrono::steady_clock::now();
+            dirty_cv.notify_one();
+        }
+        dirty_entries.emplace(entry->path, entry);
+
+        // Only the bytes actually buffered count against the budget.
+        dirty_size = dirty_size - old_buffered_size + new_buffered_size;
+        should_commit =
+            dirty_size > MaxDirtySize && std::chrono::steady_clock::now() >= retry_time;
+    }
+
+    if (should_commit) {
+        Commit();
+    }
+}
+
+bool WriteBackCache::CommitEntry(Entry& entry) {
+    if (!entry.size) {
+        return true;
+    }
+
+    std::vector<u8> contents(*entry.size);
+    const size_t base_size = std::min(entry.base_size, contents.size());
+    if (base_size > 0 && entry.base->Read(contents.data(), base_size, 0) != base_size) {
+        LOG_ERROR(Service_FS, "Failed to read {} to commit it", entry.path);
+        return false;
+    }
+    for (const auto& [offset, range] : entry.ranges) {
+        std::memcpy(contents.data() + offset, range.data(), range.size());
+    }
+
+    if (!entry.base->Replace(contents)) {
+        LOG_ERROR(Service_FS, "Failed to commit {}", entry.path);
+        return false;
+    }
+
+    bytes_committed += contents.size();
+    ++files_committed;
+
+    // Later reads are served by the file itself again.
+    DropBuffers(entry);
+    return true;
+}
+
+void WriteBackCache::DropBuffers(Entry& entry) {
+    {
+        std::scoped_lock lk{mutex};
+        dirty_size -= entry.buffered_size;
+    }
+    entry.size.reset();
+    entry.base_size = 0;
+    entry.ranges.clear();
+    entry.buffered_size = 0;
+}
+
+void WriteBackCache::Discard(std::string_view path, bool is_directory) {
+    const auto should_discard = [path, is_directory](const auto& item) {
+        return is_directory ? IsWithin(item.first, path) : item.first == path;
+    };
+
+    std::vector<std::shared_ptr<Entry>> discarded;
+    {
+        std::scoped_lock lk{mutex};
+        for (const auto& item : entries) {
+            if (!should_discard(item)) {
+                continue;
+            }
+            if (auto entry = item.second.lock()) {
+                discarded.push_back(std::move(entry));
+            }
+        }
+        std::erase_if(entries, should_discard);
+        std::erase_if(dirty_entries, should_discard);
+    }
+
+    // Handles still open on the deleted files must not write them back.
+    for (const auto& entry : discarded) {
+        std::scoped_lock lk{entry->mutex};
+        DropBuffers(*entry);
+        entry->is_deleted = true;
+    }
+}
+
+void WriteBackCache::Recreate(const VirtualFile& file) {
+    std::shared_ptr<Entry> entry;
+    {
+        std::scoped_lock lk{mutex};
+        const auto path = file->GetFullPath();
+        if (const auto it = entries.find(path); it != entries.end()) {
+            entry = it->second.lock();
+        }
+        dirty_entries.erase(path);
+    }
+    if (entry == nullptr) {
+        return;
+    }
+
+    // Handles still open on the file see the new, empty file.
+    std::scoped_lock lk{entry->mutex};
+    DropBuffers(*entry);
+    entry->base = file;
+    entry->is_deleted = false;
+}
+
+void WriteBackCache::Rename(const std::shared_ptr<Entry>& entry, std::string_view old_path) {
+    std::scoped_lock lk{mutex};
+    if (const auto it = entries.find(old_path); it != entries.end()) {
+        entries.erase(it);
+    }
+    entries[entry->path] = entry;
+}
+
+void WriteBackCache::FlushThread(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("FSWriteBack");
+
+    while (!stop_token.stop_requested()) {
+        std::chrono::steady_clock::time_point deadline;
+        {
+            std::unique_lock lk{mutex};
+            Common::CondvarWait(dirty_cv, lk, stop_token,
+                                [this] { return !dirty_entries.empty(); });
+            if (stop_token.stop_requested()) {
+                return;
+            }
+            deadline = std::max(first_dirty_time + MaxDirtyTime, retry_time);
+        }
+
+        if (!Common::StoppableTimedWait(stop_token, deadline - std::chrono::steady_clock::now())) {
+            return;
+        }
+
+        // The title may have committed in the meantime, and written again since.
+        bool should_commit = false;
+        {
+            std::scoped_lock lk{mutex};
+            should_commit =
+                !dirty_entries.empty() &&
+                std::chrono::steady_clock::now() >= std::max(first_dirty_time + MaxDirtyTime,
+                                                              retry_time);
+        }
+        if (should_commit) {
+            Commit();
+        }
+    }
+}
+
+WriteBackVfsFile::WriteBackVfsFile(std::shared_ptr<WriteBackCache> cache_,
+                                   std::shared_ptr<WriteBackCache::Entry> entry_)
+    : cache{std::move(cache_)}, entry{std::move(entry_)} {}
+
+WriteBackVfsFile::~WriteBackVfsFile() = default;
+
+std::string WriteBackVfsFile::GetName() const {
+    std::scoped_lock lk{entry->mutex};
+    return entry->base->GetName();
+}
+
+std::size_t WriteBackVfsFile::GetSize() const {
+    std::scoped_lock lk{entry->mutex};
+    if (entry->is_deleted) {
+        return 0;
+    }
+    return entry->size ? *entry->size : entry->base->GetSize();
+}
+
+bool WriteBackVfsFile::Resize(std::size_t new_size) {
+    size_t old_buffered_size{};
+    size_t new_buffered_size{};
+    {
+        std::scoped_lock lk{entry->mutex};
+        if (entry->is_deleted || !entry->base->IsWritable()) {
+            return false;
+        }
+
+        // Files larger than the budget are not buffered.
+        if (new_size > WriteBackCache::MaxDirtySize) {
+            return cache->CommitEntry(*entry) && entry->base->Resize(new_size);
+        }
+
+        if (!entry->size) {
+            entry->size = entry->base->GetSize();
+            entry->base_size = *entry->size;
+        }
+        entry->size = new_size;
+        entry->base_size = std::min(entry->base_size, new_size);
+
+        // Drop the written bytes past the new end of the file.
+        old_buffered_size = entry->buffered_size;
+        auto it = entry->ranges.lower_bound(new_size);
+        if (it != entry->ranges.begin()) {
+            auto& [offset, range] = *std::prev(it);
+            if (offset + range.size() > new_size) {
+                entry->buffered_size -= range.size() - (new_size - offset);
+                range.resize(new_size - offset);
+            }
+        }
+        for (; it != entry->ranges.end(); it = entry->ranges.erase(it)) {
+            entry->buffered_size -= it->second.size();
+        }
+        new_buffered_size = entry->buffered_size;
+    }
+
+    cache->OnWrite(entry, old_buffered_size, new_buffered_size);
+    return true;
+}
+
+VirtualDir WriteBackVfsFile::GetContainingDirectory() const {
+    std::scoped_lock lk{entry->mutex};
+    auto dir = entry->base->GetContainingDirectory();
+    if (dir == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(cache, std::move(dir));
+}
+
+bool WriteBackVfsFile::IsWritable() const {
+    std::scoped_lock lk{entry->mutex};
+    return entry->base->IsWritable();
+}
+
+bool WriteBackVfsFile::IsReadable() const {
+    std::scoped_lock lk{entry->mutex};
+    return entry->base->IsReadable();
+}
+
+std::size_t WriteBackVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    std::scoped_lock lk{entry->mutex};
+    if (entry->is_deleted) {
+        return 0;
+    }
+    if (!entry->size) {
+        return entry->base->Read(data, length, offset);
+    }
+
+    if (offset >= *entry->size) {
+        return 0;
+    }
+    const size_t read_size = std::min(length, *entry->size - offset);
+
+    // Read what is left of the file itself, with zeroes past its end, then the written ranges.
+    size_t base_read = 0;
+    if (offset < entry->base_size) {
+        base_read = entry->base->Read(data, std::min(read_size, entry->base_size - offset), offset);
+    }
+    std::memset(data + base_read, 0, read_size - base_read);
+
+    const size_t read_end = offset + read_size;
+    auto it = entry->ranges.upper_bound(offset);
+    if (it != entry->ranges.begin()) {
+        --it;
+    }
+    for (; it != entry->ranges.end() && it->first < read_end; ++it) {
+        const auto& [range_offset, range] = *it;
+        const size_t begin = std::max(offset, range_offset);
+        const size_t end = std::min(read_end, range_offset + range.size());
+        if (begin < end) {
+            std::memcpy(data + (begin - offset), range.data() + (begin - range_offset),
+                        end - begin);
+        }
+    }
+    return read_size;
+}
+
+std::size_t WriteBackVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    size_t old_buffered_size{};
+    size_t new_buffered_size{};
+    {
+        std::scoped_lock lk{entry->mutex};
+        if (entry->is_deleted || !entry->base->IsWritable()) {
+            return 0;
+        }
+
+        // Files larger than the budget are not buffered.
+        const size_t file_size = entry->size ? *entry->size : entry->base->GetSize();
+        const size_t end = offset + length;
+        if (std::max(file_size, end) > WriteBackCache::MaxDirtySize) {
+            if (!cache->CommitEntry(*entry)) {
+                return 0;
+            }
+            const size_t written = entry->base->Write(data, length, offset);
+            cache->bytes_written += written;
+            return written;
+        }
+
+        if (!entry->size) {
+            entry->size = file_size;
+            entry->base_size = file_size;
+        }
+        entry->size = std::max(*entry->size, end);
+
+        // Merge the written bytes with the ranges they overlap or touch.
+        auto& ranges = entry->ranges;
+        auto first = ranges.upper_bound(offset);
+        if (first != ranges.begin()) {
+            const auto prev = std::prev(first);
+            if (prev->first + prev->second.size() >= offset) {
+                first = prev;
+            }
+        }
+        auto last = first;
+        size_t merged_begin = offset;
+        size_t merged_end = end;
+        size_t replaced_size = 0;
+        for (; last != ranges.end() && last->first <= end; ++last) {
+            merged_begin = std::min(merged_begin, last->first);
+            merged_end = std::max(merged_end, last->first + last->second.size());
+            replaced_size += last->second.size();
+        }
+
+        std::vector<u8> merged(merged_end - merged_begin);
+        for (auto it = first; it != last; ++it) {
+            std::memcpy(merged.data() + (it->first - merged_begin), it->second.data(),
+                        it->second.size());
+        }
+        std::memcpy(merged.data() + (offset - merged_begin), data, length);
+        ranges.erase(first, last);
+        ranges.emplace(merged_begin, std::move(merged));
+
+        old_buffered_size = entry->buffered_size;
+        entry->buffered_size = entry->buffered_size - replaced_size + (merged_end - merged_begin);
+        new_buffered_size = entry->buffered_size;
+    }
+
+    cache->bytes_written += length;
+    cache->OnWrite(entry, old_buffered_size, new_buffered_size);
+    return length;
+}
+
+bool WriteBackVfsFile::Rename(std::string_view name) {
+    std::scoped_lock lk{entry->mutex};
+    if (entry->is_deleted) {
+        return false;
+    }
+
+    // The file is committed first, so that its buffered contents follow it to the new name.
+    if (!cache->CommitEntry(*entry)) {
+        return false;
+    }
+
+    const auto dir = entry->base->GetContainingDirectory();
+    if (dir == nullptr || !entry->base->Rename(name)) {
+        return false;
+    }
+
+    auto renamed = dir->GetFile(name);
+    if (renamed == nullptr) {
+        return false;
+    }
+
+    const auto old_path = std::move(entry->path);
+    entry->base = std::move(renamed);
+    entry->path = entry->base->GetFullPath();
+    cache->Rename(entry, old_path);
+    return true;
+}
+
+std::string WriteBackVfsFile::GetFullPath() const {
+    std::scoped_lock lk{entry->mutex};
+    return entry->path;
+}
+
+WriteBackVfsDirectory::WriteBackVfsDirectory(std::shared_ptr<WriteBackCache> cache_,
+                                             VirtualDir base_)
+    : cache{std::move(cache_)}, base{std::move(base_)} {}
+
+WriteBackVfsDirectory::~WriteBackVfsDirectory() = default;
+
+VirtualFile WriteBackVfsDirectory::GetFileRelative(std::string_view path) const {
+    return WrapFile(base->GetFileRelative(path));
+}
+
+VirtualDir WriteBackVfsDirectory::GetDirectoryRelative(std::string_view path) const {
+    return WrapDirectory(base->GetDirectoryRelative(path));
+}
+
+VirtualFile WriteBackVfsDirectory::GetFile(std::string_view name) const {
+    return WrapFile(base->GetFile(name));
+}
+
+VirtualDir WriteBackVfsDirectory::GetSubdirectory(std::string_view name) const {
+    return WrapDirectory(base->GetSubdirectory(name));
+}
+
+VirtualFile WriteBackVfsDirectory::CreateFileRelative(std::string_view path) {
+    // Creating a file truncates it, so anything buffered for it is stale.
+    auto file = base->CreateFileRelative(path);
+    if (file != nullptr) {
+        cache->Recreate(file);
+    }
+    return WrapFile(std::move(file));
+}
+
+VirtualDir WriteBackVfsDirectory::CreateDirectoryRelative(std::string_view path) {
+    return WrapDirectory(base->CreateDirectoryRelative(path));
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectoryRecursive(std::string_view name) {
+    if (const auto dir = base->GetSubdirectory(name)) {
+        cache->Discard(dir->GetFullPath(), true);
+    }
+    return base->DeleteSubdirectoryRecursive(name);
+}
+
+bool WriteBackVfsDirectory::CleanSubdirectoryRecursive(std::string_view name) {
+    if (const auto dir = base->GetSubdirectory(name)) {
+        cache->Discard(dir->GetFullPath(), true);
+    }
+    return base->CleanSubdirectoryRecursive(name);
+}
+
+std::vector<VirtualFile> WriteBackVfsDirectory::GetFiles() const {
+    auto files = base->GetFiles();
+    for (auto& file : files) {
+        file = WrapFile(std::move(file));
+    }
+    return files;
+}
+
+FileTimeStampRaw WriteBackVfsDirectory::GetFileTimeStamp(std::string_view path) const {
+    return base->GetFileTimeStamp(path);
+}
+
+std::vector<VirtualDir> WriteBackVfsDirectory::GetSubdirectories() const {
+    auto dirs = base->GetSubdirectories();
+    for (auto& dir : dirs) {
+        dir = WrapDirectory(std::move(dir));
+    }
+    return dirs;
+}
+
+bool WriteBackVfsDirectory::IsWritable() const {
+    return base->IsWritable();
+}
+
+bool WriteBackVfsDirectory::IsReadable() const {
+    return base->IsReadable();
+}
+
+std::string WriteBackVfsDirectory::GetName() const {
+    return base->GetName();
+}
+
+VirtualDir WriteBackVfsDirectory::GetParentDirectory() const {
+    return WrapDirectory(base->GetParentDirectory());
+}
+
+VirtualDir WriteBackVfsDirectory::CreateSubdirectory(std::string_view name) {
+    return WrapDirectory(base->CreateSubdirectory(name));
+}
+
+VirtualFile WriteBackVfsDirectory::CreateFile(std::string_view name) {
+    auto file = base->CreateFile(name);
+    if (file != nullptr) {
+        cache->Recreate(file);
+    }
+    return WrapFile(std::move(file));
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectory(std::string_view name) {
+    if (const auto dir = base->GetSubdirectory(name)) {
+        cache->Discard(dir->GetFullPath(), true);
+    }
+    return base->DeleteSubdirectory(name);
+}
+
+bool WriteBackVfsDirectory::DeleteFile(std::string_view name) {
+    if (const auto file = base->GetFile(name)) {
+        cache->Discard(file->GetFullPath(), false);
+    }
+    return base->DeleteFile(name);
+}
+
+bool WriteBackVfsDirectory::Rename(std::string_view name) {
+    // Buffered files are committed first, as their paths change with the directory.
+    cache->Commit();
+    return base->Rename(name);
+}
+
+std::string WriteBackVfsDirectory::GetFullPath() const {
+    return base->GetFullPath();
+}
+
+VirtualFile WriteBackVfsDirectory::WrapFile(VirtualFile file) const {
+    if (file == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsFile>(cache, cache->GetEntry(std::move(file)));
+}
+
+VirtualDir WriteBackVfsDirectory::WrapDirectory(VirtualDir dir) const {
+    if (dir == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(cache, std::move(dir));
+}
+
+} // namespace FileSys
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/polyfill_thread.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+class WriteBackVfsDirectory;
+class WriteBackVfsFile;
+
+// Buffers the writes to the files of a directory tree in memory until they are committed, so that
+// titles rewriting small parts of their save data many times do not write to the host each time.
+// Only the written byte ranges are kept, and each file is committed by replacing it as a whole, so
+// a crash never leaves a file half written.
+//
+// Uncommitted writes are committed when the title commits, when they are older than a few seconds
+// or exceed a memory budget, and when the last user of the cache goes away. Files larger than the
+// budget are written through directly.
+class WriteBackCache : public std::enable_shared_from_this<WriteBackCache> {
+public:
+    static constexpr std::chrono::seconds MaxDirtyTime{10};
+    static constexpr size_t MaxDirtySize = 64ULL * 1024 * 1024;
+    static constexpr std::chrono::minutes MaxRetryDelay{5};
+
+    struct Statistics {
+        // Bytes written by the title.
+        u64 bytes_written;
+        // Bytes written to the host. Each file is written as a whole when committed.
+        u64 bytes_committed;
+        // Files written to the host, each of which is synced once.
+        u64 files_committed;
+        // Files which could not be written to the host.
+        u64 failed_commits;
+    };
+
+    explicit WriteBackCache(VirtualDir root_);
+    ~WriteBackCache();
+
+    // Returns the cache of a directory, shared by everyone opening it at the same time.
+    static std::shared_ptr<WriteBackCache> Open(VirtualDir root);
+
+    // Returns the directory through which the files are accessed.
+    VirtualDir GetRoot();
+
+    // Writes all buffered files to the underlying directory.
+    bool Commit();
+
+    Statistics GetStatistics() const;
+
+private:
+    friend class WriteBackVfsDirectory;
+    friend class WriteBackVfsFile;
+
+    struct Entry {
+        std::mutex mutex;
+        VirtualFile base;
+        std::string path;
+        // Size of the file, once it has been written or resized.
+        std::optional<size_t> size;
+        // Bytes of the file at and past this offset no longer come from base, once it has been
+        // truncated.
+        size_t base_size{};
+        // Written byte ranges, keyed by their offset. Ranges never overlap or touch.
+        std::map<size_t, std::vector<u8>> ranges;
+        size_t buffered_size{};
+        // Set once the file is deleted, after which its handles fail.
+        bool is_deleted{};
+    };
+
+    std::shared_ptr<Entry> GetEntry(VirtualFile base);
+    void OnWrite(const std::shared_ptr<Entry>& entry, size_t old_buffered_size,
+                 size_t new_buffered_size);
+    bool CommitEntry(Entry& entry);
+    void DropBuffers(Entry& entry);
+    void Discard(std::string_view path, bool is_directory);
+    void Recreate(const VirtualFile& file);
+    void Rename(const std::shared_ptr<Entry>& entry, std::string_view old_path);
+    void FlushThread(std::stop_token stop_token);
+
+    VirtualDir root;
+
+    mutable std::mutex mutex;
+    std::condition_variable_any dirty_cv;
+    std::map<std::string, std::weak_ptr<Entry>, std::less<>> entries;
+    std::map<std::string, std::shared_ptr<Entry>, std::less<>> dirty_entries;
+    std::chrono::steady_clock::time_point first_dirty_time{};
+    size_t dirty_size{};
+    // Once a commit fails, files are not committed again before retry_time, unless the title
+    // commits. The delay doubles with every failure, so that files which can't be written are
+    // not rewritten continuously.
+    std::chrono::steady_clock::duration retry_delay{};
+    std::chrono::steady_clock::time_point retry_time{};
+
+    std::atomic<u64> bytes_written{};
+    std::atomic<u64> bytes_committed{};
+    std::atomic<u64> files_committed{};
+    std::atomic<u64> failed_commits{};
+
+    // Commits writes which are older than MaxDirtyTime.
+    std::jthread flush_thread;
+};
+
+class WriteBackVfsFile : public VfsFile {
+public:
+    WriteBackVfsFile(std::shared_ptr<WriteBackCache> cache_,
+                     std::shared_ptr<WriteBackCache::Entry> entry_);
+    ~WriteBackVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    std::shared_ptr<WriteBackCache> cache;
+    std::shared_ptr<WriteBackCache::Entry> entry;
+};
+
+class WriteBackVfsDirectory : public VfsDirectory {
+public:
+    WriteBackVfsDirectory(std::shared_ptr<WriteBackCache> cache_, VirtualDir base_);
+    ~WriteBackVfsDirectory() override;
+
+    VirtualFile GetFileRelative(std::string_view path) const override;
+    VirtualDir GetDirectoryRelative(std::string_view path) const override;
+    VirtualFile GetFile(std::string_view name) const override;
+    VirtualDir GetSubdirectory(std::string_view name) const override;
+    VirtualFile CreateFileRelative(std::string_view path) override;
+    VirtualDir CreateDirectoryRelative(std::string_view path) override;
+    bool DeleteSubdirectoryRecursive(std::string_view name) override;
+    bool CleanSubdirectoryRecursive(std::string_view name) override;
+    std::vector<VirtualFile> GetFiles() const override;
+    FileTimeStampRaw GetFileTimeStamp(std::string_view path) const override;
+    std::vector<VirtualDir> GetSubdirectories() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::string GetName() const override;
+    VirtualDir GetParentDirectory() const override;
+    VirtualDir CreateSubdirectory(std::string_view name) override;
+    VirtualFile CreateFile(std::string_view name) override;
+    bool DeleteSubdirectory(std::string_view name) override;
+    bool DeleteFile(std::string_view name) override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    VirtualFile WrapFile(VirtualFile file) const;
+    VirtualDir WrapDirectory(VirtualDir dir) const;
+
+    std::shared_ptr<WriteBackCache> cache;
+    VirtualDir base;
+};
+
+} // namespace FileSys
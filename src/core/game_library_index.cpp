@@ -0,0 +1,620 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/string_util.h"
+#include "core/core.h"
+#include "core/file_sys/card_image.h"
+#include "core/file_sys/content_archive.h"
+#include "core/file_sys/nca_metadata.h"
+#include "core/file_sys/registered_cache.h"
+#include "core/file_sys/submission_package.h"
+#include "core/file_sys/vfs/vfs.h"
+#include "core/file_sys/vfs/vfs_offset.h"
+#include "core/game_library_index.h"
+#include "core/loader/loader.h"
+
+namespace Core {
+namespace {
+
+constexpr u32 IndexMagic = Common::MakeMagic('Y', 'G', 'L', 'I');
+constexpr u32 IndexVersion = 2;
+
+// Parsing is mostly bound by the latency of reads, so more threads than cores can be used.
+constexpr u32 MaxThreads = 8;
+
+// Sanity limits of the records read from the index.
+constexpr u32 MaxStringSize = 0x1000;
+constexpr u32 MaxIconSize = 0x400000;
+constexpr u32 MaxContents = 0x400;
+constexpr u32 MaxPrograms = 0x100;
+
+// Key files supplied by the user. The *_autogenerated files next to them are left out, as scanning
+// a title with a ticket writes its title key to them.
+constexpr std::array UserKeyFiles{"prod.keys", "dev.keys", "title.keys", "console.keys"};
+
+struct IndexHeader {
+    u32 magic;
+    u32 version;
+    u32 num_files;
+    u32 reserved;
+};
+static_assert(sizeof(IndexHeader) == 0x10, "IndexHeader has incorrect size.");
+
+struct FileRecord {
+    u64 size;
+    s64 write_time;
+    u64 keys_fingerprint;
+    u64 content_fingerprint;
+    u32 path_size;
+    u32 file_type;
+    u32 num_contents;
+    u32 num_programs;
+    u8 has_programs;
+    INSERT_PADDING_BYTES(7);
+};
+static_assert(sizeof(FileRecord) == 0x38, "FileRecord has incorrect size.");
+
+struct ContentRecord {
+    u64 title_id;
+    u64 offset;
+    u64 size;
+    FileSys::TitleType title_type;
+    FileSys::ContentRecordType record_type;
+    INSERT_PADDING_BYTES(6);
+};
+static_assert(sizeof(ContentRecord) == 0x20, "ContentRecord has incorrect size.");
+
+struct ProgramRecord {
+    u64 program_id;
+    u64 update_offset;
+    u64 update_size;
+    u32 title_size;
+    u32 icon_size;
+    u8 romfs_updatable;
+    INSERT_PADDING_BYTES(7);
+};
+static_assert(sizeof(ProgramRecord) == 0x28, "ProgramRecord has incorrect size.");
+
+std::filesystem::path GetIndexPath() {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "game_list" / "index.bin";
+}
+
+// Fingerprints the key files, as whether a file can be parsed depends on the keys available.
+u64 GetKeysFingerprint() {
+    const auto keys_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::KeysDir);
+
+    u64 fingerprint = 0;
+    for (const std::string_view name : UserKeyFiles) {
+        std::error_code ec;
+        const std::filesystem::directory_entry dir_entry{keys_dir / name, ec};
+        if (ec || !dir_entry.is_regular_file(ec)) {
+            continue;
+        }
+        const std::array<u64, 2> record{
+            dir_entry.file_size(ec),
+            static_cast<u64>(dir_entry.last_write_time(ec).time_since_epoch().count())};
+        fingerprint = Common::CityHash64WithSeed(name.data(), name.size(), fingerprint);
+        fingerprint = Common::CityHash64WithSeed(reinterpret_cast<const char*>(record.data()),
+                                                 sizeof(record), fingerprint);
+    }
+    return fingerprint;
+}
+
+// Calls func on each of the files from a pool of threads, until all are done or stop is requested.
+template <typename Func>
+void ParallelForEach(std::span<GameLibraryIndex::FileEntry* const> files,
+                     const std::atomic_bool& stop_requested, Func&& func) {
+    std::atomic<size_t> next_index{};
+    const auto worker = [&] {
+        while (!stop_requested) {
+            const size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+            if (index >= files.size()) {
+                break;
+            }
+            func(*files[index]);
+        }
+    };
+
+    const size_t num_threads = std::min<size_t>(
+        files.size(), std::clamp(std::thread::hardware_concurrency(), 1U, MaxThreads));
+    if (num_threads <= 1) {
+        worker();
+        return;
+    }
+
+    std::vector<std::jthread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back(worker);
+    }
+}
+
+// Resolves a file nested within outer through offset files into the range of outer it covers.
+std::optional<std::pair<u64, u64>> GetRangeWithin(FileSys::VirtualFile inner,
+                                                  const FileSys::VirtualFile& outer) {
+    const u64 size = inner->GetSize();
+    u64 offset = 0;
+    while (inner != outer) {
+        const auto offset_file = std::dynamic_pointer_cast<FileSys::OffsetVfsFile>(inner);
+        if (offset_file == nullptr) {
+            return std::nullopt;
+        }
+        offset += offset_file->GetOffset();
+        inner = offset_file->GetBaseFile();
+    }
+    return std::make_pair(offset, size);
+}
+
+GameLibraryIndex::ProgramEntry ReadProgram(Loader::AppLoader& loader, u64 program_id,
+                                           const FileSys::VirtualFile& file) {
+    GameLibraryIndex::ProgramEntry program{
+        .program_id = program_id,
+        .title = " ",
+        .icon = {},
+        .romfs_updatable = loader.IsRomFSUpdatable(),
+        .update_offset = 0,
+        .update_size = 0,
+    };
+
+    [[maybe_unused]] const auto icon_result = loader.ReadIcon(program.icon);
+    [[maybe_unused]] const auto title_result = loader.ReadTitle(program.title);
+
+    FileSys::VirtualFile update_raw;
+    if (loader.ReadUpdateRaw(update_raw) == Loader::ResultStatus::Success &&
+        update_raw != nullptr) {
+        if (const auto range = GetRangeWithin(update_raw, file)) {
+            std::tie(program.update_offset, program.update_size) = *range;
+        }
+    }
+
+    return program;
+}
+
+bool ReadString(Common::FS::IOFile& file, std::string& out, u32 size) {
+    out.resize(size);
+    return file.ReadSpan<char>(out) == out.size();
+}
+
+} // Anonymous namespace
+
+GameLibraryIndex::GameLibraryIndex(System& system_, FileSys::VirtualFilesystem vfs_)
+    : system{system_}, vfs{std::move(vfs_)} {}
+
+GameLibraryIndex::~GameLibraryIndex() = default;
+
+bool GameLibraryIndex::IsSupportedFile(std::string_view path) {
+    const auto name = path.substr(path.find_last_of("/\\") + 1);
+    if (name == "main") {
+        return true;
+    }
+
+    const auto dot = name.find_last_of('.');
+    if (dot == std::string_view::npos) {
+        return false;
+    }
+    const auto extension = Common::ToLower(std::string{name.substr(dot + 1)});
+    return std::ranges::find(SupportedExtensions, extension) != SupportedExtensions.end();
+}
+
+void GameLibraryIndex::Load() {
+    auto files = ReadIndex(GetIndexPath());
+
+    std::scoped_lock lk{mutex};
+    for (auto& entry : files) {
+        auto key = entry->path;
+        entries.insert_or_assign(std::move(key), std::move(entry));
+    }
+
+    LOG_INFO(Loader, "Loaded {} files from the game library index", entries.size());
+}
+
+void GameLibraryIndex::Save() {
+    const auto path = GetIndexPath();
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Loader, "Failed to create game library index directory");
+        return;
+    }
+
+    // The index is written to a temporary file and moved into place, so that an interrupted write
+    // does not leave a truncated index behind.
+    auto temp_path = path;
+    temp_path += ".tmp";
+
+    std::scoped_lock lk{mutex};
+
+    // Files which could not be opened are tried again on the next scan.
+    std::vector<const FileEntry*> saved_entries;
+    for (const auto& [_, entry] : scanned_entries) {
+        if (entry->file_type != Loader::FileType::Error) {
+            saved_entries.push_back(entry.get());
+        }
+    }
+
+    if (!WriteIndex(temp_path, saved_entries)) {
+        LOG_ERROR(Loader, "Failed to write game library index {}",
+                  Common::FS::PathToUTF8String(temp_path));
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        LOG_ERROR(Loader, "Failed to replace game library index {}, ec_message={}",
+                  Common::FS::PathToUTF8String(path), ec.message());
+        return;
+    }
+
+    LOG_INFO(Loader, "Saved {} files to the game library index", saved_entries.size());
+}
+
+std::vector<GameLibraryIndex::FileEntryPtr> GameLibraryIndex::ReadIndex(
+    const std::filesystem::path& path) {
+    std::vector<FileEntryPtr> files;
+    if (!Common::FS::Exists(path)) {
+        return files;
+    }
+
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return files;
+    }
+
+    IndexHeader header{};
+    if (!file.ReadObject(header) || header.magic != IndexMagic ||
+        header.version != IndexVersion) {
+        LOG_WARNING(Loader, "Ignoring invalid game library index {}",
+                    Common::FS::PathToUTF8String(path));
+        return files;
+    }
+
+    for (u32 i = 0; i < header.num_files; i++) {
+        FileRecord record{};
+        if (!file.ReadObject(record) || record.path_size > MaxStringSize ||
+            record.num_contents > MaxContents || record.num_programs > MaxPrograms) {
+            break;
+        }
+
+        auto entry = std::make_shared<FileEntry>();
+        entry->size = record.size;
+        entry->write_time = record.write_time;
+        entry->file_type = static_cast<Loader::FileType>(record.file_type);
+        entry->keys_fingerprint = record.keys_fingerprint;
+        entry->has_programs = record.has_programs != 0;
+        entry->content_fingerprint = record.content_fingerprint;
+
+        std::vector<ContentRecord> contents(record.num_contents);
+        if (!ReadString(file, entry->path, record.path_size) ||
+            file.ReadSpan<ContentRecord>(contents) != contents.size()) {
+            break;
+        }
+        for (const auto& content : contents) {
+            entry->contents.push_back({
+                .title_type = content.title_type,
+                .record_type = content.record_type,
+                .title_id = content.title_id,
+                .offset = content.offset,
+                .size = content.size,
+            });
+        }
+
+        bool is_valid = true;
+        for (u32 j = 0; j < record.num_programs && is_valid; j++) {
+            ProgramRecord program_record{};
+            is_valid = file.ReadObject(program_record) &&
+                       program_record.title_size <= MaxStringSize &&
+                       program_record.icon_size <= MaxIconSize;
+            if (!is_valid) {
+                break;
+            }
+
+            ProgramEntry program{
+                .program_id = program_record.program_id,
+                .title = {},
+                .icon = std::vector<u8>(program_record.icon_size),
+                .romfs_updatable = program_record.romfs_updatable != 0,
+                .update_offset = program_record.update_offset,
+                .update_size = program_record.update_size,
+            };
+            is_valid = ReadString(file, program.title, program_record.title_size) &&
+                       file.ReadSpan<u8>(program.icon) == program.icon.size();
+            entry->programs.push_back(std::move(program));
+        }
+        if (!is_valid) {
+            break;
+        }
+
+        files.push_back(std::move(entry));
+    }
+    return files;
+}
+
+bool GameLibraryIndex::WriteIndex(const std::filesystem::path& path,
+                                  std::span<const FileEntry* const> files) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    const IndexHeader header{
+        .magic = IndexMagic,
+        .version = IndexVersion,
+        .num_files = static_cast<u32>(files.size()),
+        .reserved = 0,
+    };
+    bool success = file.IsOpen() && file.WriteObject(header);
+
+    for (const auto* entry : files) {
+        if (!success) {
+            break;
+        }
+
+        const FileRecord record{
+            .size = entry->size,
+            .write_time = entry->write_time,
+            .keys_fingerprint = entry->keys_fingerprint,
+            .content_fingerprint = entry->content_fingerprint,
+            .path_size = static_cast<u32>(entry->path.size()),
+            .file_type = static_cast<u32>(entry->file_type),
+            .num_contents = static_cast<u32>(entry->contents.size()),
+            .num_programs = static_cast<u32>(entry->programs.size()),
+            .has_programs = entry->has_programs,
+        };
+        std::vector<ContentRecord> contents;
+        for (const auto& content : entry->contents) {
+            contents.push_back({
+                .title_id = content.title_id,
+                .offset = content.offset,
+                .size = content.size,
+                .title_type = content.title_type,
+                .record_type = content.record_type,
+            });
+        }
+        success = file.WriteObject(record) &&
+                  file.WriteSpan<char>(entry->path) == entry->path.size() &&
+                  file.WriteSpan<ContentRecord>(contents) == contents.size();
+
+        for (const auto& program : entry->programs) {
+            const ProgramRecord program_record{
+                .program_id = program.program_id,
+                .update_offset = program.update_offset,
+                .update_size = program.update_size,
+                .title_size = static_cast<u32>(program.title.size()),
+                .icon_size = static_cast<u32>(program.icon.size()),
+                .romfs_updatable = program.romfs_updatable,
+            };
+            success = success && file.WriteObject(program_record) &&
+                      file.WriteSpan<char>(program.title) == program.title.size() &&
+                      file.WriteSpan<u8>(program.icon) == program.icon.size();
+        }
+    }
+    return success;
+}
+
+std::vector<GameLibraryIndex::FileEntryPtr> GameLibraryIndex::ScanContents(
+    const std::string& dir_path, bool deep_scan, const std::atomic_bool& stop_requested,
+    const std::function<void(const std::string&)>& dir_callback) {
+    std::vector<FileEntryPtr> files;
+    std::vector<FileEntry*> changed_files;
+    const u64 keys_fingerprint = GetKeysFingerprint();
+
+    const auto callback = [&](const std::filesystem::directory_entry& dir_entry) -> bool {
+        if (stop_requested) {
+            // Breaks the callback loop.
+            return false;
+        }
+
+        std::error_code ec;
+        auto physical_name = Common::FS::PathToUTF8String(dir_entry.path());
+        if (dir_entry.is_directory(ec)) {
+            if (dir_callback) {
+                dir_callback(physical_name);
+            }
+            return true;
+        }
+        if (!IsSupportedFile(physical_name)) {
+            return true;
+        }
+
+        const u64 size = dir_entry.file_size(ec);
+        const s64 write_time = dir_entry.last_write_time(ec).time_since_epoch().count();
+
+        std::scoped_lock lk{mutex};
+        auto& entry = scanned_entries[physical_name];
+        if (entry == nullptr) {
+            const auto it = entries.find(physical_name);
+            if (it != entries.end() && it->second->size == size &&
+                it->second->write_time == write_time &&
+                it->second->keys_fingerprint == keys_fingerprint) {
+                entry = it->second;
+            } else {
+                entry = std::make_shared<FileEntry>(FileEntry{
+                    .path = std::move(physical_name),
+                    .size = size,
+                    .write_time = write_time,
+                    .file_type = Loader::FileType::Unknown,
+                    .keys_fingerprint = keys_fingerprint,
+                    .contents = {},
+                    .has_programs = false,
+                    .content_fingerprint = 0,
+                    .programs = {},
+                });
+                changed_files.push_back(entry.get());
+            }
+        }
+        files.push_back(entry);
+        return true;
+    };
+
+    if (deep_scan) {
+        Common::FS::IterateDirEntriesRecursively(dir_path, callback,
+                                                 Common::FS::DirEntryFilter::All);
+    } else {
+        Common::FS::IterateDirEntries(dir_path, callback, Common::FS::DirEntryFilter::File);
+    }
+
+    if (!changed_files.empty()) {
+        LOG_INFO(Loader, "Indexing {} new or changed files of {}", changed_files.size(),
+                 dir_path);
+    }
+    ParallelForEach(changed_files, stop_requested,
+                    [this](FileEntry& entry) { ParseContents(entry); });
+
+    // Files which are not of a known format are not listed, but stay indexed so that they are
+    // not opened again until they change.
+    std::erase_if(files, [](const FileEntryPtr& entry) {
+        return entry->file_type == Loader::FileType::Unknown ||
+               entry->file_type == Loader::FileType::Error;
+    });
+    return files;
+}
+
+void GameLibraryIndex::ReadPrograms(std::span<const FileEntryPtr> files,
+                                    const std::atomic_bool& stop_requested) {
+    const u64 content_fingerprint = GetContentFingerprint();
+
+    std::vector<FileEntry*> stale_files;
+    for (const auto& entry : files) {
+        if (!entry->has_programs || entry->content_fingerprint != content_fingerprint) {
+            stale_files.push_back(entry.get());
+        }
+    }
+
+    ParallelForEach(stale_files, stop_requested, [this, content_fingerprint](FileEntry& entry) {
+        ParsePrograms(entry);
+        entry.content_fingerprint = content_fingerprint;
+    });
+}
+
+FileSys::VirtualFile GameLibraryIndex::OpenRange(const FileEntry& entry, u64 offset,
+                                                 u64 size) const {
+    auto file = vfs->OpenFile(entry.path, FileSys::OpenMode::Read);
+    if (file == nullptr || offset + size > file->GetSize()) {
+        return nullptr;
+    }
+    if (offset == 0 && size == file->GetSize()) {
+        return file;
+    }
+    return std::make_shared<FileSys::OffsetVfsFile>(std::move(file), size, offset);
+}
+
+void GameLibraryIndex::ParseContents(FileEntry& entry) const {
+    const auto file = vfs->OpenFile(entry.path, FileSys::OpenMode::Read);
+    if (file == nullptr) {
+        entry.file_type = Loader::FileType::Error;
+        return;
+    }
+
+    const auto loader = Loader::GetLoader(system, file);
+    if (!loader) {
+        return;
+    }
+
+    entry.file_type = loader->GetFileType();
+    if (entry.file_type == Loader::FileType::Unknown ||
+        entry.file_type == Loader::FileType::Error) {
+        return;
+    }
+
+    u64 program_id = 0;
+    if (loader->ReadProgramId(program_id) != Loader::ResultStatus::Success) {
+        return;
+    }
+
+    if (entry.file_type == Loader::FileType::NCA) {
+        entry.contents.push_back({
+            .title_type = FileSys::TitleType::Application,
+            .record_type = FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
+            .title_id = program_id,
+            .offset = 0,
+            .size = file->GetSize(),
+        });
+    } else if (entry.file_type == Loader::FileType::XCI ||
+               entry.file_type == Loader::FileType::NSP) {
+        const auto nsp = entry.file_type == Loader::FileType::NSP
+                             ? std::make_shared<FileSys::NSP>(file)
+                             : FileSys::XCI{file}.GetSecurePartitionNSP();
+        for (const auto& [title_id, ncas] : nsp->GetNCAs()) {
+            for (const auto& [type, nca] : ncas) {
+                const auto range = GetRangeWithin(nca->GetBaseFile(), file);
+                if (!range) {
+                    LOG_WARNING(Loader, "Skipping NCA of {:016X} not stored contiguously in {}",
+                                title_id, entry.path);
+                    continue;
+                }
+                entry.contents.push_back({
+                    .title_type = type.first,
+                    .record_type = type.second,
+                    .title_id = title_id,
+                    .offset = range->first,
+                    .size = range->second,
+                });
+            }
+        }
+    }
+}
+
+void GameLibraryIndex::ParsePrograms(FileEntry& entry) const {
+    entry.programs.clear();
+    entry.has_programs = true;
+
+    const auto file = vfs->OpenFile(entry.path, FileSys::OpenMode::Read);
+    if (file == nullptr) {
+        return;
+    }
+
+    const auto loader = Loader::GetLoader(system, file);
+    if (!loader) {
+        return;
+    }
+
+    u64 program_id = 0;
+    const auto result = loader->ReadProgramId(program_id);
+
+    std::vector<u64> program_ids;
+    loader->ReadProgramIds(program_ids);
+
+    const bool is_package =
+        entry.file_type == Loader::FileType::XCI || entry.file_type == Loader::FileType::NSP;
+    if (result != Loader::ResultStatus::Success || program_ids.size() <= 1 || !is_package) {
+        entry.programs.push_back(ReadProgram(*loader, program_id, file));
+        return;
+    }
+
+    for (const auto id : program_ids) {
+        const auto program_loader = Loader::GetLoader(system, file, id);
+        if (program_loader) {
+            entry.programs.push_back(ReadProgram(*program_loader, id, file));
+        }
+    }
+}
+
+u64 GameLibraryIndex::GetContentFingerprint() const {
+    const auto& provider = system.GetContentProvider();
+
+    auto content = provider.ListEntries();
+    std::ranges::sort(content, [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.title_id, lhs.type) < std::tie(rhs.title_id, rhs.type);
+    });
+
+    // Titles and icons are only readable with the keys to decrypt them.
+    u64 fingerprint = GetKeysFingerprint();
+    for (const auto& item : content) {
+        const std::array<u64, 3> record{item.title_id, static_cast<u64>(item.type),
+                                        provider.GetEntryVersion(item.title_id).value_or(0)};
+        fingerprint = Common::CityHash64WithSeed(reinterpret_cast<const char*>(record.data()),
+                                                 sizeof(record), fingerprint);
+    }
+    return fingerprint;
+}
+
+} // namespace Core
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs/vfs_types.h"
+
+namespace FileSys {
+enum class ContentRecordType : u8;
+enum class TitleType : u8;
+} // namespace FileSys
+
+namespace Loader {
+enum class FileType;
+} // namespace Loader
+
+namespace Core {
+
+class System;
+
+// Index of the games found in the directories of a game library, persisted across runs so that
+// files which did not change since they were indexed are not opened and parsed again. Files are
+// recognised by their path, size and modification time, and new or changed files are parsed on
+// several threads at once.
+class GameLibraryIndex {
+public:
+    // An NCA stored within an indexed file, as a range of it.
+    struct ContentEntry {
+        FileSys::TitleType title_type;
+        FileSys::ContentRecordType record_type;
+        u64 title_id;
+        u64 offset;
+        u64 size;
+    };
+
+    struct ProgramEntry {
+        u64 program_id;
+        std::string title;
+        std::vector<u8> icon;
+        bool romfs_updatable;
+        // Range of the update packed alongside the program, with a size of zero if there is none.
+        u64 update_offset;
+        u64 update_size;
+    };
+
+    struct FileEntry {
+        std::string path;
+        u64 size;
+        s64 write_time;
+        Loader::FileType file_type;
+        // Files which could not be decrypted are parsed again once the keys change.
+        u64 keys_fingerprint;
+        std::vector<ContentEntry> contents;
+
+        // The metadata of programs may come from updates found elsewhere, so it is read after the
+        // contents of the library are known and tagged with the content available at the time.
+        bool has_programs;
+        u64 content_fingerprint;
+        std::vector<ProgramEntry> programs;
+    };
+
+    using FileEntryPtr = std::shared_ptr<FileEntry>;
+
+    // Extensions of the file formats which can be loaded, also offered by the frontend's dialogs.
+    static constexpr std::array<std::string_view, 6> SupportedExtensions{
+        "nso", "nro", "nca", "xci", "nsp", "kip",
+    };
+
+    explicit GameLibraryIndex(System& system_, FileSys::VirtualFilesystem vfs_);
+    ~GameLibraryIndex();
+
+    // Returns whether the file has an extension of a supported format or is an extracted NCA.
+    static bool IsSupportedFile(std::string_view path);
+
+    void Load();
+    // Saves the files found by scans since the index was loaded, dropping those no longer found.
+    void Save();
+
+    // Reads the files recorded in an index, stopping at the first invalid record.
+    static std::vector<FileEntryPtr> ReadIndex(const std::filesystem::path& path);
+    // Writes the files to an index, returning whether all of them were written.
+    static bool WriteIndex(const std::filesystem::path& path,
+                           std::span<const FileEntry* const> files);
+
+    // Lists the supported files of dir_path, parsing the contents of files added or changed since
+    // they were indexed. Subdirectories visited by a deep scan are passed to dir_callback.
+    std::vector<FileEntryPtr> ScanContents(
+        const std::string& dir_path, bool deep_scan, const std::atomic_bool& stop_requested,
+        const std::function<void(const std::string&)>& dir_callback = {});
+
+    // Reads the programs of the files, against the content currently known to the system.
+    void ReadPrograms(std::span<const FileEntryPtr> files, const std::atomic_bool& stop_requested);
+
+    // Opens the range of an indexed file, such as one of its contents or a packed update.
+    FileSys::VirtualFile OpenRange(const FileEntry& file, u64 offset, u64 size) const;
+
+private:
+    void ParseContents(FileEntry& entry) const;
+    void ParsePrograms(FileEntry& entry) const;
+    u64 GetContentFingerprint() const;
+
+    System& system;
+    FileSys::VirtualFilesystem vfs;
+
+    std::mutex mutex;
+    // Entries loaded from the index, and those found by scans, which are the ones saved back.
+    std::map<std::string, FileEntryPtr, std::less<>> entries;
+    std::map<std::string, FileEntryPtr, std::less<>> scanned_entries;
+};
+
+} // namespace Core
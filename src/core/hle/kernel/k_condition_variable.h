@@ -5,6 +5,7 @@
 
 #include "common/assert.h"
 
+#include "core/hle/kernel/k_hashed_thread_tree.h"
 #include "core/hle/kernel/k_scheduler.h"
 #include "core/hle/kernel/k_thread.h"
 #include "core/hle/kernel/k_typed_address.h"
@@ -20,6 +21,7 @@ namespace Kernel {
 class KConditionVariable {
 public:
     using ThreadTree = typename KThread::ConditionVariableThreadTreeType;
+    using HashedThreadTree = KHashedThreadTree<ThreadTree>;
 
     explicit KConditionVariable(Core::System& system);
     ~KConditionVariable();
@@ -39,7 +41,7 @@ private:
 private:
     Core::System& m_system;
     KernelCore& m_kernel;
-    ThreadTree m_tree{};
+    HashedThreadTree m_trees{};
 };
 
 inline void BeforeUpdatePriority(KernelCore& kernel, KConditionVariable::ThreadTree* tree,
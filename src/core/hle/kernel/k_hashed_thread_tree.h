@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <bit>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+namespace Kernel {
+
+/**
+ * A set of waiter trees, hashed by the guest address (condition variable or arbiter key) that the
+ * waiting threads are keyed by.
+ *
+ * Every waiter for a given key always lands in the same bucket, so each bucket can be searched
+ * exactly like a single tree would be. Spreading unrelated keys over many small trees keeps the
+ * per-signal walk short when a process has a large number of waiting threads.
+ */
+template <typename Tree, size_t NumBuckets = 256>
+class KHashedThreadTree {
+    YUZU_NON_COPYABLE(KHashedThreadTree);
+    YUZU_NON_MOVEABLE(KHashedThreadTree);
+
+    static_assert(std::has_single_bit(NumBuckets));
+
+public:
+    using TreeType = Tree;
+
+    static constexpr size_t BucketCount = NumBuckets;
+
+public:
+    constexpr KHashedThreadTree() = default;
+
+    static constexpr size_t GetBucketIndex(u64 key) {
+        // Guest keys are at least 4-byte aligned, so discard the low bits and use a Fibonacci
+        // hash to spread neighbouring addresses across buckets.
+        constexpr u64 Multiplier = 0x9E3779B97F4A7C15ULL;
+        constexpr int Shift = 64 - std::countr_zero(NumBuckets);
+        if constexpr (NumBuckets == 1) {
+            return 0;
+        } else {
+            return static_cast<size_t>(((key >> 2) * Multiplier) >> Shift);
+        }
+    }
+
+    Tree& GetTree(u64 key) {
+        return m_buckets[GetBucketIndex(key)];
+    }
+
+    const Tree& GetTree(u64 key) const {
+        return m_buckets[GetBucketIndex(key)];
+    }
+
+    bool empty() const {
+        for (const auto& tree : m_buckets) {
+            if (!tree.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::array<Tree, NumBuckets> m_buckets{};
+};
+
+} // namespace Kernel
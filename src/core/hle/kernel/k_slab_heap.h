@@ -3,20 +3,39 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <mutex>
+#include <new>
 
 #include "common/assert.h"
 #include "common/atomic_ops.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/spin_lock.h"
+#include "core/hardware_properties.h"
 
 namespace Kernel {
 
 class KernelCore;
 
+/// Allocation statistics for a single slab heap, aggregated over all per-core caches.
+struct KSlabHeapStatistics {
+    u64 num_allocations{};
+    u64 num_frees{};
+    u64 num_failed_allocations{};
+    u64 num_cache_hits{};
+    u64 num_refills{};
+    u64 num_flushes{};
+    u64 num_drains{};
+};
+
 namespace impl {
 
+/// Gets the index of the per-core slab cache that should be used by the calling host thread.
+size_t GetSlabHeapCacheIndex(KernelCore& kernel);
+
 class KSlabHeapImpl {
     YUZU_NON_COPYABLE(KSlabHeapImpl);
     YUZU_NON_MOVEABLE(KSlabHeapImpl);
@@ -63,11 +82,178 @@ public:
         m_lock.unlock();
     }
 
+    size_t AllocateBatch(void** objs, size_t count) {
+        // KScopedInterruptDisable di;
+
+        m_lock.lock();
+
+        size_t num_allocated = 0;
+        Node* cur = m_head;
+        while (num_allocated < count && cur != nullptr) {
+            objs[num_allocated++] = cur;
+            cur = cur->next;
+        }
+        m_head = cur;
+
+        m_lock.unlock();
+        return num_allocated;
+    }
+
+    void FreeBatch(void* const* objs, size_t count) {
+        if (count == 0) {
+            return;
+        }
+
+        // Link the objects together before taking the lock, so that the critical section is
+        // only a single splice.
+        for (size_t i = 0; i < count - 1; i++) {
+            static_cast<Node*>(objs[i])->next = static_cast<Node*>(objs[i + 1]);
+        }
+        Node* first = static_cast<Node*>(objs[0]);
+        Node* last = static_cast<Node*>(objs[count - 1]);
+
+        // KScopedInterruptDisable di;
+
+        m_lock.lock();
+
+        last->next = m_head;
+        m_head = first;
+
+        m_lock.unlock();
+    }
+
 private:
     std::atomic<Node*> m_head{};
     Common::SpinLock m_lock;
 };
 
+/**
+ * Per-core magazine caches placed in front of a KSlabHeapImpl.
+ *
+ * Each emulated core owns a small magazine of free objects, so that allocation and free on
+ * different cores do not contend on the shared freelist. Empty magazines are refilled and full
+ * magazines are flushed in batches, which amortizes the cost of taking the shared lock.
+ * Host threads which are not emulated cores share the last core's magazine, so each magazine
+ * keeps its own (normally uncontended) lock.
+ */
+class KSlabHeapMagazineCache {
+    YUZU_NON_COPYABLE(KSlabHeapMagazineCache);
+    YUZU_NON_MOVEABLE(KSlabHeapMagazineCache);
+
+public:
+    static constexpr size_t MagazineCapacity = 16;
+    static constexpr size_t BatchSize = MagazineCapacity / 2;
+    static constexpr size_t NumMagazines = Core::Hardware::NUM_CPU_CORES;
+
+public:
+    constexpr KSlabHeapMagazineCache() = default;
+
+    void* Allocate(KSlabHeapImpl& heap, size_t index) {
+        Magazine& magazine = m_magazines[index];
+        {
+            std::scoped_lock lk{magazine.lock};
+            if (void* obj = this->AllocateLocked(heap, magazine); obj != nullptr) [[likely]] {
+                return obj;
+            }
+        }
+
+        // The shared freelist is exhausted. Objects may still be held by the other magazines, so
+        // reclaim them before reporting failure. Our own magazine is unlocked while doing so, as
+        // another core may be draining at the same time.
+        this->DrainOthers(heap, index);
+
+        std::scoped_lock lk{magazine.lock};
+        ++magazine.stats.num_drains;
+        void* obj = this->AllocateLocked(heap, magazine);
+        if (obj == nullptr) {
+            ++magazine.stats.num_failed_allocations;
+        }
+        return obj;
+    }
+
+    void Free(KSlabHeapImpl& heap, size_t index, void* obj) {
+        Magazine& magazine = m_magazines[index];
+        std::scoped_lock lk{magazine.lock};
+
+        if (magazine.count == MagazineCapacity) [[unlikely]] {
+            // Flush the older half of the magazine back to the shared freelist.
+            heap.FreeBatch(magazine.objects.data(), BatchSize);
+            std::copy(magazine.objects.begin() + BatchSize, magazine.objects.end(),
+                      magazine.objects.begin());
+            magazine.count -= BatchSize;
+            ++magazine.stats.num_flushes;
+        }
+
+        ++magazine.stats.num_frees;
+        magazine.objects[magazine.count++] = obj;
+    }
+
+    KSlabHeapStatistics GetStatistics() const {
+        KSlabHeapStatistics total{};
+        for (const auto& magazine : m_magazines) {
+            std::scoped_lock lk{magazine.lock};
+            total.num_allocations += magazine.stats.num_allocations;
+            total.num_frees += magazine.stats.num_frees;
+            total.num_failed_allocations += magazine.stats.num_failed_allocations;
+            total.num_cache_hits += magazine.stats.num_cache_hits;
+            total.num_refills += magazine.stats.num_refills;
+            total.num_flushes += magazine.stats.num_flushes;
+            total.num_drains += magazine.stats.num_drains;
+        }
+        return total;
+    }
+
+private:
+    struct Magazine;
+
+    void* AllocateLocked(KSlabHeapImpl& heap, Magazine& magazine) {
+        if (magazine.count == 0) [[unlikely]] {
+            // Refill the magazine from the shared freelist.
+            magazine.count = heap.AllocateBatch(magazine.objects.data(), BatchSize);
+            if (magazine.count == 0) [[unlikely]] {
+                return nullptr;
+            }
+            ++magazine.stats.num_refills;
+        } else {
+            ++magazine.stats.num_cache_hits;
+        }
+
+        ++magazine.stats.num_allocations;
+        return magazine.objects[--magazine.count];
+    }
+
+    void DrainOthers(KSlabHeapImpl& heap, size_t index) {
+        // Only one magazine lock is held at a time, so concurrent drains can't deadlock.
+        for (size_t i = 0; i < NumMagazines; i++) {
+            if (i == index) {
+                continue;
+            }
+
+            Magazine& other = m_magazines[i];
+            std::scoped_lock lk{other.lock};
+            heap.FreeBatch(other.objects.data(), other.count);
+            other.count = 0;
+        }
+    }
+
+private:
+    // Keep each magazine on its own cache line to avoid false sharing between cores.
+#ifdef __cpp_lib_hardware_interference_size
+    static constexpr size_t MagazineAlignment = std::hardware_destructive_interference_size;
+#else
+    static constexpr size_t MagazineAlignment = 128;
+#endif
+
+    struct alignas(MagazineAlignment) Magazine {
+        mutable Common::SpinLock lock;
+        size_t count{};
+        std::array<void*, MagazineCapacity> objects{};
+        KSlabHeapStatistics stats{};
+    };
+
+    std::array<Magazine, NumMagazines> m_magazines{};
+};
+
 } // namespace impl
 
 template <bool SupportDynamicExpansion>
@@ -80,6 +266,7 @@ private:
     uintptr_t m_peak{};
     uintptr_t m_start{};
     uintptr_t m_end{};
+    impl::KSlabHeapMagazineCache m_cache{};
 
 private:
     void UpdatePeakImpl(uintptr_t obj) {
@@ -139,6 +326,12 @@ public:
         return obj;
     }
 
+    void* Allocate(size_t cache_index) {
+        void* obj = m_cache.Allocate(*this, cache_index);
+
+        return obj;
+    }
+
     void Free(void* obj) {
         // Don't allow freeing an object that wasn't allocated from this heap.
         const bool contained = this->Contains(reinterpret_cast<uintptr_t>(obj));
@@ -146,6 +339,17 @@ public:
         KSlabHeapImpl::Free(obj);
     }
 
+    void Free(size_t cache_index, void* obj) {
+        // Don't allow freeing an object that wasn't allocated from this heap.
+        const bool contained = this->Contains(reinterpret_cast<uintptr_t>(obj));
+        ASSERT(contained);
+        m_cache.Free(*this, cache_index, obj);
+    }
+
+    KSlabHeapStatistics GetStatistics() const {
+        return m_cache.GetStatistics();
+    }
+
     size_t GetObjectIndex(const void* obj) const {
         if constexpr (SupportDynamicExpansion) {
             if (!this->Contains(reinterpret_cast<uintptr_t>(obj))) {
@@ -192,7 +396,7 @@ public:
     }
 
     T* Allocate(KernelCore& kernel) {
-        T* obj = static_cast<T*>(BaseHeap::Allocate());
+        T* obj = static_cast<T*>(BaseHeap::Allocate(impl::GetSlabHeapCacheIndex(kernel)));
 
         if (obj != nullptr) [[likely]] {
             std::construct_at(obj, kernel);
@@ -204,6 +408,10 @@ public:
         BaseHeap::Free(obj);
     }
 
+    void Free(KernelCore& kernel, T* obj) {
+        BaseHeap::Free(impl::GetSlabHeapCacheIndex(kernel), obj);
+    }
+
     size_t GetObjectIndex(const T* obj) const {
         return BaseHeap::GetObjectIndex(obj);
     }
@@ -24,20 +24,30 @@
 #include "core/hardware_properties.h"
 #include "core/hle/kernel/init/init_slab_setup.h"
 #include "core/hle/kernel/k_client_port.h"
+#include "core/hle/kernel/k_client_session.h"
+#include "core/hle/kernel/k_code_memory.h"
+#include "core/hle/kernel/k_debug.h"
+#include "core/hle/kernel/k_device_address_space.h"
 #include "core/hle/kernel/k_dynamic_resource_manager.h"
+#include "core/hle/kernel/k_event.h"
 #include "core/hle/kernel/k_handle_table.h"
 #include "core/hle/kernel/k_hardware_timer.h"
+#include "core/hle/kernel/k_light_session.h"
 #include "core/hle/kernel/k_memory_layout.h"
 #include "core/hle/kernel/k_memory_manager.h"
 #include "core/hle/kernel/k_object_name.h"
 #include "core/hle/kernel/k_page_buffer.h"
+#include "core/hle/kernel/k_port.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/kernel/k_resource_limit.h"
 #include "core/hle/kernel/k_scheduler.h"
 #include "core/hle/kernel/k_scoped_resource_reservation.h"
+#include "core/hle/kernel/k_session.h"
+#include "core/hle/kernel/k_session_request.h"
 #include "core/hle/kernel/k_shared_memory.h"
 #include "core/hle/kernel/k_system_resource.h"
 #include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/k_transfer_memory.h"
 #include "core/hle/kernel/k_worker_task_manager.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/physical_core.h"
@@ -862,6 +872,22 @@ void KernelCore::Initialize() {
 
 void KernelCore::Shutdown() {
     impl->Shutdown();
+
+    if (!slab_heap_container) {
+        return;
+    }
+    for (const auto& type : GetSlabHeapStatistics()) {
+        if (type.stats.num_allocations == 0) {
+            continue;
+        }
+        LOG_DEBUG(Kernel,
+                  "{}: peak {} of {} objects, {} allocations ({} cache hits, {} failed), {} frees, "
+                  "{} refills, {} flushes, {} drains",
+                  type.type_name, type.peak_index, type.slab_heap_size, type.stats.num_allocations,
+                  type.stats.num_cache_hits, type.stats.num_failed_allocations,
+                  type.stats.num_frees, type.stats.num_refills, type.stats.num_flushes,
+                  type.stats.num_drains);
+    }
 }
 
 void KernelCore::CloseServices() {
@@ -945,6 +971,10 @@ size_t KernelCore::CurrentPhysicalCoreIndex() const {
     return core_id;
 }
 
+size_t impl::GetSlabHeapCacheIndex(KernelCore& kernel) {
+    return kernel.CurrentPhysicalCoreIndex();
+}
+
 Kernel::PhysicalCore& KernelCore::CurrentPhysicalCore() {
     return *impl->cores[CurrentPhysicalCoreIndex()];
 }
@@ -1415,4 +1445,49 @@ template KSlabHeap<KThread::LockWithPriorityInheritanceInfo>& KernelCore::SlabHe
 template KSlabHeap<KEventInfo>& KernelCore::SlabHeap();
 template KSlabHeap<KDebug>& KernelCore::SlabHeap();
 
+std::vector<KSlabHeapTypeStatistics> KernelCore::GetSlabHeapStatistics() {
+    std::vector<KSlabHeapTypeStatistics> statistics;
+
+    const auto add_statistics = [&]<typename T>(KSlabHeap<T>& heap, const char* type_name,
+                                                ClassTokenType class_token) {
+        statistics.push_back({
+            .type_name = type_name,
+            .class_token = class_token,
+            .slab_heap_size = heap.GetSlabHeapSize(),
+            .peak_index = heap.GetPeakIndex(),
+            .stats = heap.GetStatistics(),
+        });
+    };
+    const auto add_object_statistics = [&]<typename T>(KSlabHeap<T>& heap) {
+        add_statistics(heap, T::GetStaticTypeName(), ClassToken<T>);
+    };
+
+    auto& container = *slab_heap_container;
+    add_object_statistics(container.client_session);
+    add_object_statistics(container.event);
+    add_object_statistics(container.port);
+    add_object_statistics(container.process);
+    add_object_statistics(container.resource_limit);
+    add_object_statistics(container.session);
+    add_object_statistics(container.light_session);
+    add_object_statistics(container.shared_memory);
+    add_object_statistics(container.thread);
+    add_object_statistics(container.transfer_memory);
+    add_object_statistics(container.code_memory);
+    add_object_statistics(container.device_address_space);
+    add_object_statistics(container.session_request);
+    add_object_statistics(container.debug);
+
+    // These are not auto objects, and so have no class token.
+    add_statistics(container.shared_memory_info, "KSharedMemoryInfo", 0);
+    add_statistics(container.page_buffer, "KPageBuffer", 0);
+    add_statistics(container.thread_local_page, "KThreadLocalPage", 0);
+    add_statistics(container.object_name, "KObjectName", 0);
+    add_statistics(container.secure_system_resource, "KSecureSystemResource", 0);
+    add_statistics(container.lock_info, "LockWithPriorityInheritanceInfo", 0);
+    add_statistics(container.event_info, "KEventInfo", 0);
+
+    return statistics;
+}
+
 } // namespace Kernel
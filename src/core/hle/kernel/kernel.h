@@ -80,6 +80,15 @@ struct KSlabResourceCounts;
 template <typename T>
 class KSlabHeap;
 
+/// Slab heap allocation statistics for a single kernel object type.
+struct KSlabHeapTypeStatistics {
+    const char* type_name{};
+    ClassTokenType class_token{};
+    size_t slab_heap_size{};
+    size_t peak_index{};
+    KSlabHeapStatistics stats{};
+};
+
 /// Represents a single instance of the kernel.
 class KernelCore {
 public:
@@ -292,6 +301,9 @@ public:
     /// Gets the current slab resource counts.
     const Init::KSlabResourceCounts& SlabResourceCounts() const;
 
+    /// Gets the allocation statistics of the slab heaps for all kernel object types.
+    std::vector<KSlabHeapTypeStatistics> GetSlabHeapStatistics();
+
     /// Gets the current worker task manager, used for dispatching KThread/KProcess tasks.
     KWorkerTaskManager& WorkerTaskManager();
 
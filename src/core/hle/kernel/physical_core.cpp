@@ -1,8 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <thread>
+
 #include "common/scope_exit.h"
 #include "common/settings.h"
+#include "common/steady_clock.h"
+#include "core/arm/translation_profile.h"
 #include "core/core.h"
 #include "core/debugger/debugger.h"
 #include "core/hle/kernel/k_process.h"
@@ -10,12 +15,32 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/physical_core.h"
 #include "core/hle/kernel/svc.h"
+#include "core/tools/guest_profiler.h"
 
 namespace Kernel {
 
+namespace {
+
+// Number of back-to-back spin-like supervisor calls from one thread before the host yields.
+constexpr u32 SpinYieldThreshold = 32;
+// Number of back-to-back spin-like supervisor calls before the host briefly sleeps instead.
+constexpr u32 SpinSleepThreshold = 1024;
+constexpr auto SpinSleepTime = std::chrono::microseconds(50);
+
+// Number of recorded blocks translated between checks for a pending interrupt.
+constexpr size_t WarmUpBatchSize = 32;
+
+u64 ElapsedNs(Common::SteadyClock::time_point start) {
+    return static_cast<u64>((Common::SteadyClock::Now() - start).count());
+}
+
+} // namespace
+
 PhysicalCore::PhysicalCore(KernelCore& kernel, std::size_t core_index)
     : m_kernel{kernel}, m_core_index{core_index} {
     m_is_single_core = !kernel.IsMulticore();
+    m_adaptive_spin_yield =
+        !m_is_single_core && Settings::values.use_adaptive_spin_yield.GetValue();
 }
 PhysicalCore::~PhysicalCore() = default;
 
@@ -91,7 +116,9 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
                     thread->SetStepState(StepState::StepPerformed);
                 }
             } else {
+                const auto start = Common::SteadyClock::Now();
                 hr = interface->RunThread(thread);
+                m_guest_ns.fetch_add(ElapsedNs(start), std::memory_order_relaxed);
             }
 
             ExitContext();
@@ -103,6 +130,12 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
         const bool breakpoint = True(hr & Core::HaltReason::InstructionBreakpoint);
         const bool data_abort = True(hr & Core::HaltReason::DataAbort);
         const bool interrupt = True(hr & Core::HaltReason::BreakLoop);
+        const bool profile_sample = True(hr & Core::HaltReason::ProfileSample);
+
+        // Record a guest profiler sample if one was requested.
+        if (profile_sample) {
+            system.GetGuestProfiler().RecordSample(process, *interface);
+        }
 
         // Since scheduling may occur here, we cannot use any cached
         // state after returning from calls we make.
@@ -133,8 +166,11 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
 
         // Handle system calls.
         if (supervisor_call) {
+            const u32 svc_num = interface->GetSvcNumber();
+            this->UpdateSpinDetection(*process, thread, svc_num);
+
             // Perform call.
-            Svc::Call(system, interface->GetSvcNumber());
+            Svc::Call(system, svc_num);
             return;
         }
 
@@ -203,7 +239,87 @@ void PhysicalCore::LogBacktrace() {
     }
 }
 
+void PhysicalCore::UpdateSpinDetection(KProcess& process, KThread* thread, u32 svc_num) {
+    if (!m_adaptive_spin_yield) {
+        return;
+    }
+
+    // Yielding and polling the system tick in a tight loop are the supervisor call patterns of
+    // a guest spin-wait. Any other call, or a different thread, ends the current streak.
+    const auto svc_id = static_cast<Svc::SvcId>(svc_num);
+    bool is_spin_candidate = svc_id == Svc::SvcId::GetSystemTick;
+    if (svc_id == Svc::SvcId::SleepThread) {
+        // A sleep with a positive timeout already gives up the core, only the yield variants
+        // (zero and negative timeouts) return straight back to the guest.
+        std::array<uint64_t, 8> args;
+        this->SaveSvcArguments(process, args);
+        const u64 ns = process.Is64Bit() ? args[0] : (args[1] << 32) | (args[0] & 0xFFFFFFFF);
+        is_spin_candidate = static_cast<s64>(ns) <= 0;
+    }
+    if (!is_spin_candidate || thread != m_spin_thread) {
+        m_spin_thread = is_spin_candidate ? thread : nullptr;
+        m_spin_count = is_spin_candidate ? 1 : 0;
+        return;
+    }
+
+    if (++m_spin_count < SpinYieldThreshold) {
+        return;
+    }
+
+    // The guest is busy-waiting, so give our host time to other emulator threads.
+    m_spin_yields.fetch_add(1, std::memory_order_relaxed);
+    if (m_spin_count >= SpinSleepThreshold) {
+        std::this_thread::sleep_for(SpinSleepTime);
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+PhysicalCore::Utilization PhysicalCore::GetUtilization() const {
+    return {
+        .guest_ns = m_guest_ns.load(std::memory_order_relaxed),
+        .idle_ns = m_idle_ns.load(std::memory_order_relaxed),
+        .spin_yields = m_spin_yields.load(std::memory_order_relaxed),
+    };
+}
+
+void PhysicalCore::WarmUpTranslation() {
+    if (m_is_single_core) {
+        return;
+    }
+
+    auto& translation_profile = m_kernel.System().GetTranslationProfile();
+    if (!translation_profile.HasPendingBlocks(m_core_index)) {
+        return;
+    }
+
+    auto* process = m_kernel.ApplicationProcess();
+    auto* interface = process != nullptr ? process->GetArmInterface(m_core_index) : nullptr;
+    if (interface == nullptr) {
+        return;
+    }
+
+    // Translate blocks in small batches, so that an interrupt is not delayed for long.
+    std::array<u64, WarmUpBatchSize> blocks;
+    while (!this->IsInterrupted()) {
+        const size_t count = translation_profile.TakePendingBlocks(m_core_index, blocks);
+        if (count == 0) {
+            break;
+        }
+
+        interface->WarmUpTranslation(std::span(blocks.data(), count));
+    }
+}
+
 void PhysicalCore::Idle() {
+    const auto start = Common::SteadyClock::Now();
+    SCOPE_EXIT {
+        m_idle_ns.fetch_add(ElapsedNs(start), std::memory_order_relaxed);
+    };
+
+    // Use the idle time to translate guest code recorded in a previous session.
+    this->WarmUpTranslation();
+
     std::unique_lock lk{m_guard};
     m_on_interrupt.wait(lk, [this] { return m_is_interrupted; });
 }
@@ -235,6 +351,14 @@ void PhysicalCore::Interrupt() {
     arm_interface->SignalInterrupt(thread);
 }
 
+void PhysicalCore::RequestProfileSample() {
+    std::scoped_lock lk{m_guard};
+
+    if (m_arm_interface != nullptr) {
+        m_arm_interface->SignalProfileSample();
+    }
+}
+
 void PhysicalCore::ClearInterrupt() {
     std::scoped_lock lk{m_guard};
     m_is_interrupted = false;
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
@@ -23,6 +24,13 @@ namespace Kernel {
 
 class PhysicalCore {
 public:
+    /// Cumulative host time spent by this core, used to derive utilization and idle ratios.
+    struct Utilization {
+        u64 guest_ns{};
+        u64 idle_ns{};
+        u64 spin_yields{};
+    };
+
     PhysicalCore(KernelCore& kernel, std::size_t core_index);
     ~PhysicalCore();
 
@@ -58,10 +66,22 @@ public:
     // Check if this core is interrupted.
     bool IsInterrupted() const;
 
+    // Ask the running guest thread, if any, to halt so that the guest profiler can sample it.
+    void RequestProfileSample();
+
     std::size_t CoreIndex() const {
         return m_core_index;
     }
 
+    Utilization GetUtilization() const;
+
+private:
+    // Detect guest threads spinning on yields or the system tick and back off on the host.
+    void UpdateSpinDetection(KProcess& process, KThread* thread, u32 svc_num);
+
+    // Translate guest code recorded by the translation profile while this core has no work.
+    void WarmUpTranslation();
+
 private:
     KernelCore& m_kernel;
     const std::size_t m_core_index;
@@ -72,6 +92,14 @@ private:
     KThread* m_current_thread{};
     bool m_is_interrupted{};
     bool m_is_single_core{};
+
+    bool m_adaptive_spin_yield{};
+    KThread* m_spin_thread{};
+    u32 m_spin_count{};
+
+    std::atomic<u64> m_guest_ns{};
+    std::atomic<u64> m_idle_ns{};
+    std::atomic<u64> m_spin_yields{};
 };
 
 } // namespace Kernel
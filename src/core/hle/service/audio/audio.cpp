@@ -27,8 +27,17 @@ void LoopProcess(Core::System& system) {
                                          std::make_shared<IFinalOutputRecorderManager>(system));
     server_manager->RegisterNamedService("audren:u",
                                          std::make_shared<IAudioRendererManager>(system));
+    ServerManager::RunServer(std::move(server_manager));
+}
+
+void LoopProcessHardwareOpus(Core::System& system) {
+    auto server_manager = std::make_unique<ServerManager>(system);
+
+    // Decoder sessions are independent of each other, so unlike the renderer and audio out
+    // sessions they are served by several threads, letting games decode streams concurrently.
     server_manager->RegisterNamedService("hwopus",
                                          std::make_shared<IHardwareOpusDecoderManager>(system));
+    server_manager->StartAdditionalHostThreads("hwopus", 3);
     ServerManager::RunServer(std::move(server_manager));
 }
 
@@ -3,6 +3,7 @@
 
 #include "common/string_util.h"
 #include "core/file_sys/fssrv/fssrv_sf_path.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
 #include "core/hle/service/cmif_serialization.h"
 #include "core/hle/service/filesystem/fsp/fs_i_directory.h"
 #include "core/hle/service/filesystem/fsp/fs_i_file.h"
@@ -10,10 +11,11 @@
 
 namespace Service::FileSystem {
 
-IFileSystem::IFileSystem(Core::System& system_, FileSys::VirtualDir dir_, SizeGetter size_getter_)
+IFileSystem::IFileSystem(Core::System& system_, FileSys::VirtualDir dir_, SizeGetter size_getter_,
+                         std::shared_ptr<FileSys::WriteBackCache> write_back_)
     : ServiceFramework{system_, "IFileSystem"}, backend{std::make_unique<FileSys::Fsa::IFileSystem>(
                                                     dir_)},
-      size_getter{std::move(size_getter_)} {
+      size_getter{std::move(size_getter_)}, write_back{std::move(write_back_)} {
     static const FunctionInfo functions[] = {
         {0, D<&IFileSystem::CreateFile>, "CreateFile"},
         {1, D<&IFileSystem::DeleteFile>, "DeleteFile"},
@@ -36,6 +38,8 @@ IFileSystem::IFileSystem(Core::System& system_, FileSys::VirtualDir dir_, SizeGe
     RegisterHandlers(functions);
 }
 
+IFileSystem::~IFileSystem() = default;
+
 Result IFileSystem::CreateFile(const InLargeData<FileSys::Sf::Path, BufferAttr_HipcPointer> path,
                                s32 option, s64 size) {
     LOG_DEBUG(Service_FS, "called. file={}, option=0x{:X}, size=0x{:08X}", path->str, option, size);
@@ -124,8 +128,11 @@ Result IFileSystem::GetEntryType(
 }
 
 Result IFileSystem::Commit() {
-    LOG_WARNING(Service_FS, "(STUBBED) called");
+    LOG_DEBUG(Service_FS, "called");
 
+    if (write_back && !write_back->Commit()) {
+        LOG_ERROR(Service_FS, "Failed to commit some of the files written");
+    }
     R_SUCCEED();
 }
 
@@ -12,6 +12,10 @@
 #include "core/hle/service/filesystem/fsp/fsp_types.h"
 #include "core/hle/service/service.h"
 
+namespace FileSys {
+class WriteBackCache;
+}
+
 namespace FileSys::Sf {
 struct Path;
 }
@@ -23,7 +27,9 @@ class IDirectory;
 
 class IFileSystem final : public ServiceFramework<IFileSystem> {
 public:
-    explicit IFileSystem(Core::System& system_, FileSys::VirtualDir dir_, SizeGetter size_getter_);
+    explicit IFileSystem(Core::System& system_, FileSys::VirtualDir dir_, SizeGetter size_getter_,
+                         std::shared_ptr<FileSys::WriteBackCache> write_back_ = {});
+    ~IFileSystem() override;
 
     Result CreateFile(const InLargeData<FileSys::Sf::Path, BufferAttr_HipcPointer> path, s32 option,
                       s64 size);
@@ -55,6 +61,8 @@ public:
 private:
     std::unique_ptr<FileSys::Fsa::IFileSystem> backend;
     SizeGetter size_getter;
+    // Writes buffered on behalf of the filesystem, if any, which are flushed on commit.
+    std::shared_ptr<FileSys::WriteBackCache> write_back;
 };
 
 } // namespace Service::FileSystem
@@ -19,14 +19,19 @@ IMultiCommitManager::IMultiCommitManager(Core::System& system_)
 IMultiCommitManager::~IMultiCommitManager() = default;
 
 Result IMultiCommitManager::Add(std::shared_ptr<IFileSystem> filesystem) {
-    LOG_WARNING(Service_FS, "(STUBBED) called");
+    LOG_DEBUG(Service_FS, "called");
 
+    filesystems.push_back(std::move(filesystem));
     R_SUCCEED();
 }
 
 Result IMultiCommitManager::Commit() {
-    LOG_WARNING(Service_FS, "(STUBBED) called");
+    LOG_DEBUG(Service_FS, "called, num_filesystems={}", filesystems.size());
 
+    // Each filesystem is committed on its own, the commit is not atomic across them.
+    for (const auto& filesystem : filesystems) {
+        R_TRY(filesystem->Commit());
+    }
     R_SUCCEED();
 }
 
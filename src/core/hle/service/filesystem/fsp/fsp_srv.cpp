@@ -26,6 +26,7 @@
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/system_archive/system_archive.h"
 #include "core/file_sys/vfs/vfs.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
 #include "core/hle/result.h"
 #include "core/hle/service/cmif_serialization.h"
 #include "core/hle/service/filesystem/filesystem.h"
@@ -270,8 +271,15 @@ Result FSP_SRV::OpenSaveDataFileSystem(OutInterface<IFileSystem> out_interface,
         ASSERT(false);
     }
 
-    *out_interface =
-        std::make_shared<IFileSystem>(system, std::move(dir), SizeGetter::FromStorageId(fsc, id));
+    // Writes are buffered until the title commits them, and are then written as whole files.
+    std::shared_ptr<FileSys::WriteBackCache> write_back;
+    if (Settings::values.savedata_write_back.GetValue()) {
+        write_back = FileSys::WriteBackCache::Open(std::move(dir));
+        dir = write_back->GetRoot();
+    }
+
+    *out_interface = std::make_shared<IFileSystem>(
+        system, std::move(dir), SizeGetter::FromStorageId(fsc, id), std::move(write_back));
 
     R_SUCCEED();
 }
@@ -190,24 +190,56 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
     // Define an nce patch context for each potential module.
     PatchCollection patch_ctx{is_application};
 
-    // Use the NSO module loader to figure out the code layout
+    std::vector<size_t> module_indices;
+    std::vector<FileSys::VirtualFile> module_files;
     for (size_t i = 0; i < static_modules.size(); i++) {
-        const auto& module = static_modules[i];
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
-        if (!module_file) {
-            continue;
+        if (auto module_file = dir->GetFile(static_modules[i])) {
+            module_indices.push_back(i);
+            module_files.push_back(std::move(module_file));
         }
+    }
+
+    std::vector<const FileSys::VfsFile*> module_file_ptrs;
+    for (const auto& module_file : module_files) {
+        module_file_ptrs.push_back(module_file.get());
+    }
 
-        const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
-        const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, code_size, should_pass_arguments, false, {},
-            patch_ctx.GetPatchers(), patch_ctx.GetLastIndex());
-        if (!tentative_next_load_addr) {
+    // Use the NSO module loader to figure out the code layout
+    if (auto* const patchers = patch_ctx.GetPatchers()) {
+        // The code of each module is patched in order, while the following modules are still
+        // being decompressed.
+        const std::vector<size_t> image_offsets(module_files.size());
+        const bool success = AppLoader_NSO::DecompressModules(
+            module_file_ptrs, image_offsets, [&](size_t index, NSOImage&& image) {
+                const auto i = module_indices[index];
+                const bool should_pass_arguments = std::strcmp(static_modules[i], "rtld") == 0;
+                const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
+                    process, system, std::move(image), code_size, should_pass_arguments, false,
+                    {}, patchers, patch_ctx.GetLastIndex());
+                if (!tentative_next_load_addr) {
+                    return false;
+                }
+
+                patch_ctx.SaveIndex(i);
+                code_size = *tentative_next_load_addr;
+                return true;
+            });
+        if (!success) {
             return {ResultStatus::ErrorLoadingNSO, {}};
         }
-
-        patch_ctx.SaveIndex(i);
-        code_size = *tentative_next_load_addr;
+    } else {
+        for (size_t index = 0; index < module_files.size(); index++) {
+            const auto i = module_indices[index];
+            const bool should_pass_arguments = std::strcmp(static_modules[i], "rtld") == 0;
+            const auto tentative_next_load_addr =
+                AppLoader_NSO::LoadModule(process, system, *module_files[index], code_size,
+                                          should_pass_arguments, false);
+            if (!tentative_next_load_addr) {
+                return {ResultStatus::ErrorLoadingNSO, {}};
+            }
+
+            code_size = *tentative_next_load_addr;
+        }
     }
 
     // Enable direct memory mapping in case of NCE.
@@ -228,31 +260,39 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
         return {ResultStatus::ErrorUnableToParseKernelMetadata, {}};
     }
 
-    // Load NSO modules
+    // Load NSO modules, decompressing all of them at once into their final images.
     modules.clear();
     const VAddr base_address{GetInteger(process.GetEntryPoint())};
     VAddr next_load_addr{base_address};
     const FileSys::PatchManager pm{metadata.GetTitleID(), system.GetFileSystemController(),
                                    system.GetContentProvider()};
-    for (size_t i = 0; i < static_modules.size(); i++) {
-        const auto& module = static_modules[i];
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
-        if (!module_file) {
-            continue;
-        }
 
-        const VAddr load_addr{next_load_addr};
-        const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
-        const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, load_addr, should_pass_arguments, true, pm,
-            patch_ctx.GetPatchers(), patch_ctx.GetIndex(i));
-        if (!tentative_next_load_addr) {
-            return {ResultStatus::ErrorLoadingNSO, {}};
-        }
+    std::vector<size_t> image_offsets;
+    for (const auto i : module_indices) {
+        image_offsets.push_back(
+            AppLoader_NSO::GetModuleStart(true, patch_ctx.GetPatchers(), patch_ctx.GetIndex(i)));
+    }
 
-        next_load_addr = *tentative_next_load_addr;
-        modules.insert_or_assign(load_addr, module);
-        LOG_DEBUG(Loader, "loaded module {} @ {:#X}", module, load_addr);
+    const bool success = AppLoader_NSO::DecompressModules(
+        module_file_ptrs, image_offsets, [&](size_t index, NSOImage&& image) {
+            const auto i = module_indices[index];
+            const auto& module = static_modules[i];
+            const VAddr load_addr{next_load_addr};
+            const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
+            const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
+                process, system, std::move(image), load_addr, should_pass_arguments, true, pm,
+                patch_ctx.GetPatchers(), patch_ctx.GetIndex(i));
+            if (!tentative_next_load_addr) {
+                return false;
+            }
+
+            next_load_addr = *tentative_next_load_addr;
+            modules.insert_or_assign(load_addr, module);
+            LOG_DEBUG(Loader, "loaded module {} @ {:#X}", module, load_addr);
+            return true;
+        });
+    if (!success) {
+        return {ResultStatus::ErrorLoadingNSO, {}};
     }
 
     is_loaded = true;
@@ -1,11 +1,18 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include "common/hex_util.h"
-#include "common/scope_exit.h"
 #include "core/core.h"
+#include "core/crypto/sha_util.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/nca_metadata.h"
 #include "core/file_sys/registered_cache.h"
@@ -14,7 +21,6 @@
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/deconstructed_rom_directory.h"
 #include "core/loader/nca.h"
-#include "mbedtls/sha256.h"
 
 namespace Loader {
 
@@ -109,34 +115,50 @@ ResultStatus AppLoader_NCA::VerifyIntegrity(std::function<bool(size_t, size_t)>
     const auto input_hash =
         Common::HexStringToVector(file->GetName().substr(0, NcaFileNameHashLength), false);
 
-    // Declare buffer to read into.
-    std::vector<u8> buffer(4_MiB);
+    // Declare buffers to read into. The next chunk is read while the current one is hashed.
+    std::array<std::vector<u8>, 2> buffers{std::vector<u8>(4_MiB), std::vector<u8>(4_MiB)};
+    size_t current_buffer = 0;
 
     // Initialize sha256 verification context.
-    mbedtls_sha256_context ctx;
-    mbedtls_sha256_init(&ctx);
-    mbedtls_sha256_starts_ret(&ctx, 0);
-
-    // Ensure we maintain a clean state on exit.
-    SCOPE_EXIT {
-        mbedtls_sha256_free(&ctx);
-    };
+    Core::Crypto::SHA256Hasher hasher;
 
     // Declare counters.
     const size_t total_size = file->GetSize();
     size_t processed_size = 0;
 
+    const auto ReadChunk = [this, &buffers, total_size](size_t index, size_t offset) {
+        const size_t intended_read_size = std::min(buffers[index].size(), total_size - offset);
+        return file->Read(buffers[index].data(), intended_read_size, offset);
+    };
+
+    // Begin reading the file.
+    std::future<size_t> pending_read;
+    if (total_size > 0) {
+        pending_read = std::async(std::launch::async, ReadChunk, current_buffer, processed_size);
+    }
+
     // Begin iterating the file.
     while (processed_size < total_size) {
-        // Refill the buffer.
-        const size_t intended_read_size = std::min(buffer.size(), total_size - processed_size);
-        const size_t read_size = file->Read(buffer.data(), intended_read_size, processed_size);
+        // Wait for the buffer to be refilled.
+        const size_t read_size = pending_read.get();
+        if (read_size == 0) {
+            LOG_ERROR(Loader, "Failed to read NCA {} at offset {:#X}", name, processed_size);
+            return ResultStatus::ErrorIntegrityVerificationFailed;
+        }
+
+        // Start reading the next chunk into the other buffer.
+        const size_t next_offset = processed_size + read_size;
+        if (next_offset < total_size) {
+            pending_read =
+                std::async(std::launch::async, ReadChunk, current_buffer ^ 1, next_offset);
+        }
 
         // Update the hash function with the buffer contents.
-        mbedtls_sha256_update_ret(&ctx, buffer.data(), read_size);
+        hasher.Update(buffers[current_buffer].data(), read_size);
 
         // Update counters.
-        processed_size += read_size;
+        processed_size = next_offset;
+        current_buffer ^= 1;
 
         // Call the progress function.
         if (!progress_callback(processed_size, total_size)) {
@@ -145,8 +167,7 @@ ResultStatus AppLoader_NCA::VerifyIntegrity(std::function<bool(size_t, size_t)>
     }
 
     // Finalize context and compute the output hash.
-    std::array<u8, NcaSha256HashLength> output_hash;
-    mbedtls_sha256_finish_ret(&ctx, output_hash.data());
+    const auto output_hash = hasher.Finish();
 
     // Compare to expected.
     if (std::memcmp(input_hash.data(), output_hash.data(), NcaSha256HalfHashLength) != 0) {
@@ -158,6 +179,94 @@ ResultStatus AppLoader_NCA::VerifyIntegrity(std::function<bool(size_t, size_t)>
     return ResultStatus::Success;
 }
 
+ResultStatus AppLoader_NCA::VerifyIntegrityParallel(
+    const std::vector<FileSys::VirtualFile>& files,
+    const std::function<bool(size_t, size_t)>& progress_callback) {
+    // The files usually share a single disk, so verifying more at once only adds seeking.
+    constexpr size_t MaxVerificationThreads = 4;
+    constexpr auto ProgressInterval = std::chrono::milliseconds{50};
+
+    // Parse the NCAs up front, so that the workers only read and hash.
+    size_t total_size = 0;
+    std::vector<std::unique_ptr<AppLoader_NCA>> loaders;
+    loaders.reserve(files.size());
+    for (const auto& nca_file : files) {
+        total_size += nca_file->GetSize();
+        loaders.push_back(std::make_unique<AppLoader_NCA>(nca_file));
+    }
+
+    if (loaders.empty()) {
+        return ResultStatus::Success;
+    }
+
+    std::vector<std::atomic<size_t>> processed_sizes(loaders.size());
+    std::atomic<size_t> next_loader{};
+    std::atomic_bool cancelled{};
+    ResultStatus first_failure = ResultStatus::Success;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    const size_t num_threads =
+        std::min({loaders.size(), MaxVerificationThreads,
+                  std::max<size_t>(std::thread::hardware_concurrency(), 1)});
+    size_t active_threads = num_threads;
+
+    const auto Worker = [&] {
+        for (size_t i = next_loader++; i < loaders.size() && !cancelled; i = next_loader++) {
+            const auto result =
+                loaders[i]->VerifyIntegrity([&, i](size_t nca_processed_size, size_t) {
+                    processed_sizes[i].store(nca_processed_size, std::memory_order_relaxed);
+                    return !cancelled.load(std::memory_order_relaxed);
+                });
+
+            // Stop the other workers on the first failure, keeping its status.
+            if (result != ResultStatus::Success && !cancelled.exchange(true)) {
+                first_failure = result;
+            }
+        }
+
+        std::scoped_lock lk{mutex};
+        --active_threads;
+        cv.notify_one();
+    };
+
+    std::vector<std::jthread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back(Worker);
+    }
+
+    // Report the combined progress from the calling thread until all workers are done.
+    bool user_cancelled = false;
+    std::unique_lock lk{mutex};
+    while (active_threads > 0) {
+        cv.wait_for(lk, ProgressInterval, [&] { return active_threads == 0; });
+        if (user_cancelled || cancelled) {
+            continue;
+        }
+
+        size_t processed_size = 0;
+        for (const auto& nca_processed_size : processed_sizes) {
+            processed_size += nca_processed_size.load(std::memory_order_relaxed);
+        }
+
+        lk.unlock();
+        if (!progress_callback(processed_size, total_size)) {
+            user_cancelled = true;
+            cancelled = true;
+        }
+        lk.lock();
+    }
+    lk.unlock();
+
+    threads.clear();
+
+    if (user_cancelled) {
+        return ResultStatus::ErrorIntegrityVerificationFailed;
+    }
+    return first_failure;
+}
+
 ResultStatus AppLoader_NCA::ReadRomFS(FileSys::VirtualFile& dir) {
     if (nca == nullptr) {
         return ResultStatus::ErrorNotInitialized;
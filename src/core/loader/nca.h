@@ -41,6 +41,19 @@ public:
 
     ResultStatus VerifyIntegrity(std::function<bool(size_t, size_t)> progress_callback) override;
 
+    /**
+     * Verifies the integrity of several NCA files in parallel.
+     *
+     * @param files The NCA files to verify.
+     * @param progress_callback Receives the combined progress of all files. It is only invoked
+     *                          from the calling thread, and returning false cancels verification.
+     *
+     * @return ResultStatus::Success if all files were verified, or the status of the first failure.
+     */
+    static ResultStatus VerifyIntegrityParallel(
+        const std::vector<FileSys::VirtualFile>& files,
+        const std::function<bool(size_t, size_t)>& progress_callback);
+
     ResultStatus ReadRomFS(FileSys::VirtualFile& dir) override;
     ResultStatus ReadProgramId(u64& out_program_id) override;
 
@@ -1,8 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstring>
+#include <future>
+#include <thread>
 #include <vector>
 
 #include "common/common_funcs.h"
@@ -11,6 +14,7 @@
 #include "common/lz4_compression.h"
 #include "common/settings.h"
 #include "common/swap.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/hle/kernel/code_set.h"
@@ -37,19 +41,84 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
-                                  const NSOSegmentHeader& header) {
-    std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
+constexpr u32 PageAlignSize(u32 size) {
+    return static_cast<u32>((size + Core::Memory::YUZU_PAGEMASK) & ~Core::Memory::YUZU_PAGEMASK);
+}
+
+// Segments of a title rarely benefit from more decompression threads than this.
+constexpr size_t MaxDecompressThreads = 8;
 
-    ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
-               uncompressed_data.size());
+struct PendingImage {
+    NSOImage image{};
+    std::vector<std::future<bool>> segments;
+};
 
-    return uncompressed_data;
+bool ReadHeader(const FileSys::VfsFile& nso_file, NSOHeader& nso_header) {
+    if (nso_file.GetSize() < sizeof(NSOHeader)) {
+        return false;
+    }
+    if (sizeof(NSOHeader) != nso_file.ReadObject(&nso_header)) {
+        return false;
+    }
+    return nso_header.magic == Common::MakeMagic('N', 'S', 'O', '0');
 }
 
-constexpr u32 PageAlignSize(u32 size) {
-    return static_cast<u32>((size + Core::Memory::YUZU_PAGEMASK) & ~Core::Memory::YUZU_PAGEMASK);
+// Returns the end of the last segment within the image, excluding bss and arguments.
+size_t GetSegmentsEnd(const NSOHeader& nso_header, size_t image_offset) {
+    size_t end = image_offset;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        const auto& segment = nso_header.segments[i];
+        const std::size_t size = nso_header.IsSegmentCompressed(i)
+                                     ? segment.size
+                                     : nso_header.segments_compressed_size[i];
+        end = std::max<size_t>(end, image_offset + segment.location + size);
+    }
+    return end;
+}
+
+// Reads the segments of an NSO into its image, queueing the compressed ones for decompression.
+bool QueueDecompression(const FileSys::VfsFile& nso_file, size_t image_offset,
+                        PendingImage& pending, Common::ThreadWorker& workers) {
+    auto& image = pending.image;
+    if (!ReadHeader(nso_file, image.header)) {
+        return false;
+    }
+    image.name = nso_file.GetName();
+    image.image_offset = image_offset;
+
+    // The image is sized before any segment is queued, so that it is not reallocated under them.
+    const auto& nso_header = image.header;
+    image.memory.resize(GetSegmentsEnd(nso_header, image_offset));
+
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        // Segments are decompressed straight from the file into the image when it is memory backed.
+        const auto& segment = nso_header.segments[i];
+        std::vector<u8> buffer;
+        const auto data =
+            nso_file.ReadSpan(buffer, nso_header.segments_compressed_size[i], segment.offset);
+        u8* const dst = image.memory.data() + image_offset + segment.location;
+
+        if (!nso_header.IsSegmentCompressed(i)) {
+            std::memcpy(dst, data.data(), data.size());
+            continue;
+        }
+
+        const u32 size = segment.size;
+        std::packaged_task<bool()> task{[dst, size, data, buffer = std::move(buffer)] {
+            const int decompressed_size =
+                Common::Compression::DecompressDataLZ4(dst, size, data.data(), data.size());
+            if (decompressed_size != static_cast<int>(size)) {
+                LOG_ERROR(Loader, "Failed to decompress NSO segment, {} != {}", size,
+                          decompressed_size);
+                return false;
+            }
+            return true;
+        }};
+        pending.segments.push_back(task.get_future());
+        workers.QueueWork(std::move(task));
+    }
+
+    return true;
 }
 } // Anonymous namespace
 
@@ -73,51 +142,108 @@ FileType AppLoader_NSO::IdentifyType(const FileSys::VirtualFile& in_file) {
     return FileType::NSO;
 }
 
+size_t AppLoader_NSO::GetModuleStart(bool load_into_process,
+                                     std::vector<Core::NCE::Patcher>* patches, s32 patch_index) {
+    // Allocate some space at the beginning if we are patching in PreText mode.
+#ifdef HAS_NCE
+    if (patches && load_into_process) {
+        auto* patch = &patches->operator[](patch_index);
+        if (patch->GetPatchMode() == Core::NCE::PatchMode::PreText) {
+            return patch->GetSectionSize();
+        }
+    }
+#endif
+    return 0;
+}
+
+bool AppLoader_NSO::DecompressModules(std::span<const FileSys::VfsFile* const> files,
+                                      std::span<const size_t> image_offsets,
+                                      const std::function<bool(size_t, NSOImage&&)>& callback) {
+    // Declared before the workers, so that queued tasks are done with the images when they are
+    // destroyed on an early return.
+    std::vector<PendingImage> pending(files.size());
+
+    const size_t num_workers =
+        std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MaxDecompressThreads);
+    Common::ThreadWorker workers{num_workers, "NSODecompressor"};
+
+    // Files are read on this thread, as reads of the underlying storage may not be thread safe,
+    // while the segments read so far are decompressed on the workers.
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!QueueDecompression(*files[i], image_offsets[i], pending[i], workers)) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        bool success = true;
+        for (auto& segment : pending[i].segments) {
+            success &= segment.get();
+        }
+        if (!success || !callback(i, std::move(pending[i].image))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
                                                const FileSys::VfsFile& nso_file, VAddr load_base,
                                                bool should_pass_arguments, bool load_into_process,
                                                std::optional<FileSys::PatchManager> pm,
                                                std::vector<Core::NCE::Patcher>* patches,
                                                s32 patch_index) {
-    if (nso_file.GetSize() < sizeof(NSOHeader)) {
-        return std::nullopt;
-    }
+    // Only the size of the image is needed to compute the code layout, unless its code is patched.
+    if (!load_into_process && patches == nullptr) {
+        NSOHeader nso_header{};
+        if (!ReadHeader(nso_file, nso_header)) {
+            return std::nullopt;
+        }
 
-    NSOHeader nso_header{};
-    if (sizeof(NSOHeader) != nso_file.ReadObject(&nso_header)) {
-        return std::nullopt;
+        const bool has_arguments =
+            should_pass_arguments && !Settings::values.program_args.GetValue().empty();
+        const size_t image_size = GetSegmentsEnd(nso_header, 0) +
+                                  (has_arguments ? NSO_ARGUMENT_DATA_ALLOCATION_SIZE : 0) +
+                                  nso_header.segments[2].bss_size;
+        return load_base + PageAlignSize(static_cast<u32>(image_size));
     }
 
-    if (nso_header.magic != Common::MakeMagic('N', 'S', 'O', '0')) {
-        return std::nullopt;
-    }
+    const size_t module_start = GetModuleStart(load_into_process, patches, patch_index);
+    const std::array files{&nso_file};
+    const std::array image_offsets{module_start};
+
+    std::optional<VAddr> result;
+    DecompressModules(files, image_offsets, [&](size_t, NSOImage&& image) {
+        result = LoadModule(process, system, std::move(image), load_base, should_pass_arguments,
+                            load_into_process, std::move(pm), patches, patch_index);
+        return result.has_value();
+    });
+    return result;
+}
 
-    // Allocate some space at the beginning if we are patching in PreText mode.
-    const size_t module_start = [&]() -> size_t {
-#ifdef HAS_NCE
-        if (patches && load_into_process) {
-            auto* patch = &patches->operator[](patch_index);
-            if (patch->GetPatchMode() == Core::NCE::PatchMode::PreText) {
-                return patch->GetSectionSize();
-            }
-        }
-#endif
-        return 0;
-    }();
+std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
+                                               NSOImage&& image, VAddr load_base,
+                                               bool should_pass_arguments, bool load_into_process,
+                                               std::optional<FileSys::PatchManager> pm,
+                                               std::vector<Core::NCE::Patcher>* patches,
+                                               s32 patch_index) {
+    const size_t module_start = GetModuleStart(load_into_process, patches, patch_index);
+    const auto& nso_header = image.header;
+
+    // Move the segments if the image was decompressed for a different patch section size.
+    Kernel::PhysicalMemory program_image = std::move(image.memory);
+    if (image.image_offset < module_start) {
+        program_image.insert(program_image.begin(), module_start - image.image_offset, u8{0});
+    } else if (image.image_offset > module_start) {
+        program_image.erase(program_image.begin(),
+                            program_image.begin() +
+                                static_cast<std::ptrdiff_t>(image.image_offset - module_start));
+    }
 
     // Build program image
     Kernel::CodeSet codeset;
-    Kernel::PhysicalMemory program_image;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data = nso_file.ReadBytes(nso_header.segments_compressed_size[i],
-                                                  nso_header.segments[i].offset);
-        if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
-        }
-        program_image.resize(module_start + nso_header.segments[i].location +
-                             static_cast<u32>(data.size()));
-        std::memcpy(program_image.data() + module_start + nso_header.segments[i].location,
-                    data.data(), data.size());
         codeset.segments[i].addr = module_start + nso_header.segments[i].location;
         codeset.segments[i].offset = module_start + nso_header.segments[i].location;
         codeset.segments[i].size = nso_header.segments[i].size;
@@ -147,7 +273,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     }
 
     // Apply patches if necessary
-    const auto name = nso_file.GetName();
+    const auto& name = image.name;
     if (pm && (pm->HasNSOPatch(nso_header.build_id, name) || Settings::values.dump_nso)) {
         std::span<u8> patchable_section(program_image.data() + module_start,
                                         program_image.size() - module_start);
@@ -4,11 +4,15 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <optional>
+#include <span>
+#include <string>
 #include <type_traits>
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/file_sys/patch_manager.h"
+#include "core/hle/kernel/physical_memory.h"
 #include "core/loader/loader.h"
 
 namespace Core {
@@ -71,6 +75,15 @@ struct NSOArgumentHeader {
 };
 static_assert(sizeof(NSOArgumentHeader) == 0x20, "NSOArgumentHeader has incorrect size.");
 
+/// An NSO with its segments decompressed into the image it is loaded from.
+struct NSOImage {
+    NSOHeader header;
+    std::string name;
+    /// Bytes left free at the start of the image, for a patch section placed before the text.
+    size_t image_offset;
+    Kernel::PhysicalMemory memory;
+};
+
 /// Loads an NSO file
 class AppLoader_NSO final : public AppLoader {
 public:
@@ -96,6 +109,33 @@ public:
                                            std::vector<Core::NCE::Patcher>* patches = nullptr,
                                            s32 patch_index = -1);
 
+    static std::optional<VAddr> LoadModule(Kernel::KProcess& process, Core::System& system,
+                                           NSOImage&& image, VAddr load_base,
+                                           bool should_pass_arguments, bool load_into_process,
+                                           std::optional<FileSys::PatchManager> pm = {},
+                                           std::vector<Core::NCE::Patcher>* patches = nullptr,
+                                           s32 patch_index = -1);
+
+    /// Returns the size of the patch section placed before the text of a module, if any.
+    static size_t GetModuleStart(bool load_into_process, std::vector<Core::NCE::Patcher>* patches,
+                                 s32 patch_index);
+
+    /**
+     * Decompresses the segments of several NSOs concurrently.
+     *
+     * Images are passed to the callback in order as soon as they are ready, so that they can be
+     * patched or loaded while the following ones are still being decompressed.
+     *
+     * @param files         The NSO files to decompress.
+     * @param image_offsets The bytes to leave free at the start of the image of each file.
+     * @param callback      Receives the index and image of each file, returning false to stop.
+     *
+     * @return False if a file is not a valid NSO or the callback stopped, true otherwise.
+     */
+    static bool DecompressModules(std::span<const FileSys::VfsFile* const> files,
+                                  std::span<const size_t> image_offsets,
+                                  const std::function<bool(size_t, NSOImage&&)>& callback);
+
     LoadResult Load(Kernel::KProcess& process, Core::System& system) override;
 
     ResultStatus ReadNSOModules(Modules& out_modules) override;
@@ -93,31 +93,14 @@ ResultStatus AppLoader_XCI::VerifyIntegrity(std::function<bool(size_t, size_t)>
     // Get list of all NCAs.
     const auto ncas = secure_partition->GetNCAsCollapsed();
 
-    size_t total_size = 0;
-    size_t processed_size = 0;
-
-    // Loop over NCAs, collecting the total size to verify.
-    for (const auto& nca : ncas) {
-        total_size += nca->GetBaseFile()->GetSize();
-    }
-
-    // Loop over NCAs again, verifying each.
+    std::vector<FileSys::VirtualFile> nca_files;
+    nca_files.reserve(ncas.size());
     for (const auto& nca : ncas) {
-        AppLoader_NCA loader_nca(nca->GetBaseFile());
-
-        const auto NcaProgressCallback = [&](size_t nca_processed_size, size_t nca_total_size) {
-            return progress_callback(processed_size + nca_processed_size, total_size);
-        };
-
-        const auto verification_result = loader_nca.VerifyIntegrity(NcaProgressCallback);
-        if (verification_result != ResultStatus::Success) {
-            return verification_result;
-        }
-
-        processed_size += nca->GetBaseFile()->GetSize();
+        nca_files.push_back(nca->GetBaseFile());
     }
 
-    return ResultStatus::Success;
+    // Verify the NCAs in parallel.
+    return AppLoader_NCA::VerifyIntegrityParallel(nca_files, progress_callback);
 }
 
 ResultStatus AppLoader_XCI::ReadRomFS(FileSys::VirtualFile& out_file) {
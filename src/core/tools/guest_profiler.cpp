@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/arm/arm_interface.h"
+#include "core/arm/debug.h"
+#include "core/core.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/physical_core.h"
+#include "core/tools/guest_profiler.h"
+
+namespace Tools {
+namespace {
+
+// Maximum number of frames captured per sample.
+constexpr size_t MaxSampleDepth = 64;
+
+std::string GetFrameName(const Core::BacktraceEntry& entry) {
+    if (!entry.name.empty()) {
+        return fmt::format("{}`{}", entry.module, entry.name);
+    }
+    return fmt::format("{}`{:#x}", entry.module, entry.offset);
+}
+
+} // Anonymous namespace
+
+GuestProfiler::GuestProfiler(Core::System& system_) : system{system_} {}
+
+GuestProfiler::~GuestProfiler() {
+    Stop();
+}
+
+void GuestProfiler::Start(std::chrono::microseconds interval) {
+    if (IsRunning()) {
+        return;
+    }
+
+    LOG_INFO(Core, "Starting guest profiler with a {}us sampling interval", interval.count());
+    sampler_thread = std::jthread(
+        [this, interval](std::stop_token stop_token) { SamplerThread(stop_token, interval); });
+}
+
+void GuestProfiler::Stop() {
+    if (!IsRunning()) {
+        return;
+    }
+
+    sampler_thread.request_stop();
+    sampler_thread.join();
+    sampler_thread = {};
+}
+
+bool GuestProfiler::IsRunning() const {
+    return sampler_thread.joinable();
+}
+
+void GuestProfiler::Clear() {
+    std::scoped_lock lk{mutex};
+    stacks.clear();
+    sample_count = 0;
+}
+
+void GuestProfiler::RecordSample(Kernel::KProcess* process, const Core::ArmInterface& interface) {
+    if (process == nullptr || process != system.ApplicationProcess()) {
+        // Only the application is profiled, as module symbols are resolved against it.
+        return;
+    }
+
+    Kernel::Svc::ThreadContext ctx{};
+    interface.GetContext(ctx);
+    auto stack = Core::GetRawBacktraceFromContext(process, ctx, MaxSampleDepth);
+
+    std::scoped_lock lk{mutex};
+    ++stacks[std::move(stack)];
+    ++sample_count;
+}
+
+u64 GuestProfiler::GetSampleCount() const {
+    std::scoped_lock lk{mutex};
+    return sample_count;
+}
+
+std::string GuestProfiler::GetFoldedStacks(Kernel::KProcess* process) const {
+    std::scoped_lock lk{mutex};
+    if (process == nullptr || stacks.empty()) {
+        return {};
+    }
+
+    // Symbolicate every captured address at once, so module symbols are only parsed once.
+    std::vector<Core::BacktraceEntry> entries;
+    for (const auto& [stack, count] : stacks) {
+        for (const u64 address : stack) {
+            entries.push_back({"", 0, address, 0, ""});
+        }
+    }
+    Core::SymbolicateBacktrace(process, entries);
+
+    std::string out;
+    auto entry = entries.begin();
+    for (const auto& [stack, count] : stacks) {
+        // Folded stacks are written from the outermost frame to the innermost one.
+        const auto stack_begin = entry;
+        entry += static_cast<std::ptrdiff_t>(stack.size());
+
+        std::string line;
+        for (auto frame = entry; frame != stack_begin; --frame) {
+            if (!line.empty()) {
+                line += ';';
+            }
+            line += GetFrameName(*std::prev(frame));
+        }
+        out += fmt::format("{} {}\n", line, count);
+    }
+    return out;
+}
+
+bool GuestProfiler::WriteFoldedStacks(Kernel::KProcess* process,
+                                      const std::filesystem::path& path) const {
+    const auto folded_stacks = GetFoldedStacks(process);
+    if (folded_stacks.empty()) {
+        LOG_WARNING(Core, "No guest profiler samples were recorded");
+        return false;
+    }
+
+    const auto written =
+        Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile, folded_stacks);
+    if (written != folded_stacks.size()) {
+        LOG_ERROR(Core, "Failed to write guest profile to {}", path.string());
+        return false;
+    }
+
+    LOG_INFO(Core, "Wrote {} guest profiler samples to {}", GetSampleCount(), path.string());
+    return true;
+}
+
+void GuestProfiler::SamplerThread(std::stop_token stop_token,
+                                  std::chrono::microseconds interval) {
+    Common::SetCurrentThreadName("GuestProfiler");
+
+    auto& kernel = system.Kernel();
+    while (Common::StoppableTimedWait(stop_token, interval)) {
+        for (size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; core++) {
+            kernel.PhysicalCore(core).RequestProfileSample();
+        }
+    }
+}
+
+} // namespace Tools
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+
+namespace Core {
+class ArmInterface;
+class System;
+} // namespace Core
+
+namespace Kernel {
+class KProcess;
+}
+
+namespace Tools {
+
+/**
+ * Sampling profiler for guest code.
+ *
+ * A background thread periodically asks every emulated core to briefly halt. The halted core
+ * captures the guest PC and frame-pointer backtrace of the running thread, and identical stacks
+ * are aggregated. Stacks are symbolicated with the loaded module symbols only when the profile
+ * is written out, which keeps the per-sample cost low.
+ */
+class GuestProfiler {
+public:
+    explicit GuestProfiler(Core::System& system_);
+    ~GuestProfiler();
+
+    // Starts sampling all cores at the given interval.
+    void Start(std::chrono::microseconds interval);
+
+    // Stops sampling. Collected samples are kept until Clear() is called.
+    void Stop();
+
+    // Returns whether or not the sampler thread is running.
+    bool IsRunning() const;
+
+    // Discards all collected samples.
+    void Clear();
+
+    // Records a sample from a halted core. Called by the core which was asked to sample.
+    void RecordSample(Kernel::KProcess* process, const Core::ArmInterface& interface);
+
+    // Returns the total number of samples recorded.
+    u64 GetSampleCount() const;
+
+    // Symbolicates the collected samples for the given process and returns them as folded
+    // stacks ("outer;...;inner count" per line), as consumed by flamegraph tools.
+    std::string GetFoldedStacks(Kernel::KProcess* process) const;
+
+    // Writes the folded stacks to the given path. Returns whether or not the write succeeded.
+    bool WriteFoldedStacks(Kernel::KProcess* process, const std::filesystem::path& path) const;
+
+private:
+    void SamplerThread(std::stop_token stop_token, std::chrono::microseconds interval);
+
+    Core::System& system;
+
+    mutable std::mutex mutex;
+    std::map<std::vector<u64>, u64> stacks;
+    u64 sample_count{};
+
+    std::jthread sampler_thread;
+};
+
+} // namespace Tools
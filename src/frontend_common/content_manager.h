@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <boost/algorithm/string.hpp>
 #include "common/common_types.h"
 #include "common/literals.h"
@@ -122,6 +124,50 @@ inline bool RemoveMod(const Service::FileSystem::FileSystemController& fs_contro
     return false;
 }
 
+/**
+ * \brief Creates the function used to copy content into the NAND during installation
+ * \param callback Callback to report the progress of the copy, called once for every MiB of each
+ * file with its total size and the current progress. If you return true to the callback, it will
+ * cancel the copy as soon as possible. Files may be copied concurrently, but calls to the callback
+ * are serialized.
+ * \return Copy function to pass to the registered cache
+ */
+inline FileSys::VfsCopyFunction MakeInstallCopyFunction(
+    const std::function<bool(size_t, size_t)>& callback) {
+    using namespace Common::Literals;
+    constexpr size_t CopyBlockSize = 4_MiB;
+    constexpr size_t ProgressInterval = 1_MiB;
+
+    const auto callback_mutex = std::make_shared<std::mutex>();
+    return [callback, callback_mutex](const FileSys::VirtualFile& src,
+                                      const FileSys::VirtualFile& dest, std::size_t block_size) {
+        if (src == nullptr || dest == nullptr) {
+            return false;
+        }
+
+        const size_t size = src->GetSize();
+        size_t next_report = 0;
+        const auto report_until = [&](size_t offset) {
+            std::scoped_lock lk{*callback_mutex};
+            for (; next_report <= offset && next_report < size; next_report += ProgressInterval) {
+                if (callback(size, next_report)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        if (!FileSys::VfsStreamCopy(src, dest, CopyBlockSize, report_until)) {
+            return false;
+        }
+        if (report_until(size)) {
+            dest->Resize(0);
+            return false;
+        }
+        return true;
+    };
+}
+
 /**
  * \brief Installs an NSP
  * \param system Reference to the system instance
@@ -135,28 +181,7 @@ inline bool RemoveMod(const Service::FileSystem::FileSystemController& fs_contro
 inline InstallResult InstallNSP(Core::System& system, FileSys::VfsFilesystem& vfs,
                                 const std::string& filename,
                                 const std::function<bool(size_t, size_t)>& callback) {
-    const auto copy = [callback](const FileSys::VirtualFile& src, const FileSys::VirtualFile& dest,
-                                 std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        using namespace Common::Literals;
-        std::vector<u8> buffer(1_MiB);
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (callback(src->GetSize(), i)) {
-                dest->Resize(0);
-                return false;
-            }
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
-        }
-        return true;
-    };
+    const auto copy = MakeInstallCopyFunction(callback);
 
     std::shared_ptr<FileSys::NSP> nsp;
     FileSys::VirtualFile file = vfs.OpenFile(filename, FileSys::OpenMode::Read);
@@ -201,28 +226,7 @@ inline InstallResult InstallNCA(FileSys::VfsFilesystem& vfs, const std::string&
                                 FileSys::RegisteredCache& registered_cache,
                                 const FileSys::TitleType title_type,
                                 const std::function<bool(size_t, size_t)>& callback) {
-    const auto copy = [callback](const FileSys::VirtualFile& src, const FileSys::VirtualFile& dest,
-                                 std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        using namespace Common::Literals;
-        std::vector<u8> buffer(1_MiB);
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (callback(src->GetSize(), i)) {
-                dest->Resize(0);
-                return false;
-            }
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
-        }
-        return true;
-    };
+    const auto copy = MakeInstallCopyFunction(callback);
 
     const auto nca =
         std::make_shared<FileSys::NCA>(vfs.OpenFile(filename, FileSys::OpenMode::Read));
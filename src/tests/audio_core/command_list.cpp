@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/common/common.h"
+#include "audio_core/renderer/behavior/behavior_info.h"
+#include "audio_core/renderer/command/command_buffer.h"
+#include "audio_core/renderer/command/command_processing_time_estimator.h"
+#include "audio_core/renderer/command/icommand.h"
+#include "audio_core/renderer/memory/memory_pool_info.h"
+#include "audio_core/renderer/mix/mix_info.h"
+#include "audio_core/renderer/voice/voice_info.h"
+#include "audio_core/renderer/voice/voice_state.h"
+#include "common/common_types.h"
+
+using namespace AudioCore;
+using namespace AudioCore::Renderer;
+
+namespace {
+
+constexpr s16 OutputChannels = 2;
+constexpr u32 MaxVoices = 96;
+
+/// Everything the commands point to, kept together so a single memory pool covers all of it.
+struct Workbuffer {
+    std::array<s32, (OutputChannels + MaxVoices) * TargetSampleCount> mix_buffers;
+    std::array<VoiceState, MaxVoices> voice_states;
+    std::array<s32, OutputChannels> depop_buffer;
+};
+
+/**
+ * Builds the command list the renderer generates for a stereo final mix fed by filtered, ramped
+ * mono voices, and processes it as the ADSP does. The data source and clear commands read guest
+ * memory, so instead each frame copies the voice samples into the mix buffers directly.
+ */
+class CommandListFixture {
+public:
+    explicit CommandListFixture(u32 voice_count_)
+        : voice_count{voice_count_}, buffer_count{OutputChannels + voice_count_},
+          workbuffer{std::make_unique<Workbuffer>()},
+          estimator{TargetSampleCount, buffer_count}, source(voice_count * TargetSampleCount),
+          command_memory((voice_count * 4 + OutputChannels + 1) * 0x100) {
+        std::mt19937 rng{0x5EED};
+        std::uniform_int_distribution<s32> pcm_dist{-0x8000, 0x7FFF};
+        std::generate(source.begin(), source.end(), [&] { return pcm_dist(rng); });
+
+        memory_pool.SetCpuAddress(CpuAddr(workbuffer.get()), sizeof(Workbuffer));
+        memory_pool.SetDspAddress(CpuAddr(workbuffer.get()));
+
+        command_buffer.command_list = command_memory;
+        command_buffer.sample_count = TargetSampleCount;
+        command_buffer.sample_rate = TargetSampleRate;
+        command_buffer.memory_pool = &memory_pool;
+        command_buffer.time_estimator = &estimator;
+        command_buffer.behavior = &behavior;
+        GenerateCommands();
+
+        processor.sample_count = TargetSampleCount;
+        processor.target_sample_rate = TargetSampleRate;
+        processor.mix_buffers =
+            std::span(workbuffer->mix_buffers).first(buffer_count * TargetSampleCount);
+        processor.buffer_count = buffer_count;
+    }
+
+    /**
+     * Render one frame of audio.
+     *
+     * @return The number of commands processed.
+     */
+    u32 ProcessFrame() {
+        auto& mix_buffers{workbuffer->mix_buffers};
+        std::fill_n(mix_buffers.begin(), OutputChannels * TargetSampleCount, 0);
+        std::copy(source.begin(), source.end(),
+                  mix_buffers.begin() + OutputChannels * TargetSampleCount);
+        workbuffer->depop_buffer = {0x4000, -0x4000};
+
+        auto* commands{command_memory.data()};
+        u32 processed_count{};
+        for (u32 index = 0; index < command_buffer.count; index++) {
+            auto& command{*reinterpret_cast<ICommand*>(commands)};
+            if (!command.Verify(processor)) {
+                break;
+            }
+
+            command.Process(processor);
+            processed_count++;
+            commands += command.size;
+        }
+        return processed_count;
+    }
+
+    u32 GetCommandCount() const {
+        return command_buffer.count;
+    }
+
+    std::span<const s32> GetOutput() const {
+        return std::span(workbuffer->mix_buffers).first(OutputChannels * TargetSampleCount);
+    }
+
+private:
+    void GenerateCommands() {
+        VoiceInfo voice_info{};
+        voice_info.prev_volume = 0.6f;
+        voice_info.volume = 0.8f;
+        // Low-pass at roughly 4 KHz, with the coefficients in Q14.
+        voice_info.biquads[0] = {
+            .enabled = true,
+            .b = {811, 1622, 811},
+            .a = {20965, -7825},
+        };
+        voice_info.biquad_initialized[0] = true;
+
+        for (u32 voice = 0; voice < voice_count; voice++) {
+            const auto node_id{static_cast<s32>(voice)};
+            const auto buffer_index{static_cast<s16>(OutputChannels + voice)};
+            auto& voice_state{workbuffer->voice_states[voice]};
+
+            command_buffer.GenerateBiquadFilterCommand(node_id, voice_info, voice_state,
+                                                       buffer_index, 0, 0, false);
+            command_buffer.GenerateVolumeRampCommand(node_id, voice_info, buffer_index, 15);
+            for (s16 channel = 0; channel < OutputChannels; channel++) {
+                command_buffer.GenerateMixRampCommand(
+                    node_id, buffer_index, buffer_index, channel, 0.5f, 0.45f,
+                    CpuAddr(&voice_state.previous_samples[channel]), 15);
+            }
+        }
+
+        const auto final_mix_node_id{static_cast<s32>(voice_count)};
+        for (s16 channel = 0; channel < OutputChannels; channel++) {
+            command_buffer.GenerateVolumeCommand(final_mix_node_id, 0, channel, 0.9f, 15);
+        }
+
+        MixInfo mix_info{{}, 0, behavior};
+        mix_info.buffer_offset = 0;
+        mix_info.buffer_count = OutputChannels;
+        mix_info.sample_rate = TargetSampleRate;
+        command_buffer.GenerateDepopForMixBuffersCommand(final_mix_node_id, mix_info,
+                                                         workbuffer->depop_buffer);
+    }
+
+    u32 voice_count;
+    u32 buffer_count;
+    std::unique_ptr<Workbuffer> workbuffer;
+    BehaviorInfo behavior{};
+    MemoryPoolInfo memory_pool{};
+    CommandProcessingTimeEstimatorVersion5 estimator;
+    std::vector<s32> source;
+    std::vector<u8> command_memory;
+    CommandBuffer command_buffer{};
+    ADSP::AudioRenderer::CommandListProcessor processor{};
+};
+
+} // Anonymous namespace
+
+TEST_CASE("AudioRenderer: Processes every generated command", "[audio_core]") {
+    CommandListFixture fixture{8};
+    REQUIRE(fixture.GetCommandCount() == 8 * 4 + OutputChannels + 1);
+    REQUIRE(fixture.ProcessFrame() == fixture.GetCommandCount());
+
+    const auto output{fixture.GetOutput()};
+    REQUIRE(std::any_of(output.begin(), output.end(), [](s32 sample) { return sample != 0; }));
+}
+
+TEST_CASE("AudioRenderer: Command list benchmark", "[audio_core][.benchmark]") {
+    CommandListFixture few_voices{8};
+    BENCHMARK("8 voices") {
+        return few_voices.ProcessFrame();
+    };
+
+    CommandListFixture many_voices{MaxVoices};
+    BENCHMARK("96 voices") {
+        return many_voices.ProcessFrame();
+    };
+}
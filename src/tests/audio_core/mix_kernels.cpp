@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "common/common_types.h"
+#include "common/fixed_point.h"
+
+using namespace AudioCore::Renderer;
+
+namespace {
+
+// Reference implementations, as the mix commands computed their samples with FixedPoint.
+template <size_t Q>
+s32 ReferenceMix(std::vector<s32>& output, const std::vector<s32>& input, f32 volume_, f32 ramp_) {
+    Common::FixedPoint<64 - Q, Q> volume{volume_};
+    const Common::FixedPoint<64 - Q, Q> ramp{ramp_};
+    Common::FixedPoint<64 - Q, Q> sample{0};
+    for (size_t i = 0; i < output.size(); i++) {
+        sample = input[i] * volume;
+        output[i] = (output[i] + sample).to_int();
+        volume += ramp;
+    }
+    return sample.to_int();
+}
+
+template <size_t Q>
+void ReferenceScale(std::vector<s32>& output, const std::vector<s32>& input, f32 volume_,
+                    f32 ramp_) {
+    Common::FixedPoint<64 - Q, Q> gain{volume_};
+    const Common::FixedPoint<64 - Q, Q> ramp{ramp_};
+    for (size_t i = 0; i < output.size(); i++) {
+        output[i] = (input[i] * gain).to_int();
+        gain += ramp;
+    }
+}
+
+struct Case {
+    std::vector<s32> input;
+    std::vector<s32> output;
+    f32 volume;
+    f32 ramp;
+};
+
+// Generates buffers of the sizes used by the renderer and odd sizes exercising the tails of the
+// vector kernels, with samples both in the usual 24-bit range and over the full 32-bit range.
+std::vector<Case> MakeCases() {
+    std::mt19937 rng{0x5EED};
+    std::uniform_int_distribution<s32> pcm_dist{-0x800000, 0x7FFFFF};
+    std::uniform_int_distribution<s32> full_dist{std::numeric_limits<s32>::min(),
+                                                 std::numeric_limits<s32>::max()};
+    std::uniform_real_distribution<f32> volume_dist{-2.0f, 2.0f};
+
+    std::vector<Case> cases;
+    for (const u32 sample_count : {0U, 1U, 3U, 7U, 13U, 160U, 240U, 241U}) {
+        for (u32 variant = 0; variant < 16; variant++) {
+            Case test_case{
+                .input = std::vector<s32>(sample_count),
+                .output = std::vector<s32>(sample_count),
+                .volume = volume_dist(rng),
+                .ramp = 0.0f,
+            };
+            for (u32 i = 0; i < sample_count; i++) {
+                const bool full_range = variant % 4 == 3;
+                test_case.input[i] = full_range ? full_dist(rng) : pcm_dist(rng);
+                test_case.output[i] = full_range ? full_dist(rng) : pcm_dist(rng);
+            }
+            if (variant % 2 == 1 && sample_count != 0) {
+                const auto target_volume = volume_dist(rng);
+                test_case.ramp =
+                    (target_volume - test_case.volume) / static_cast<f32>(sample_count);
+            }
+            // Volumes which no longer fit in 32 bits once converted take the scalar path.
+            if (variant == 14) {
+                test_case.volume = 70000.0f;
+            }
+            cases.push_back(std::move(test_case));
+        }
+    }
+    return cases;
+}
+
+template <size_t Q>
+void CheckMix() {
+    for (const auto& test_case : MakeCases()) {
+        const auto sample_count = static_cast<u32>(test_case.input.size());
+        const Common::FixedPoint<64 - Q, Q> volume{test_case.volume};
+        const Common::FixedPoint<64 - Q, Q> ramp{test_case.ramp};
+
+        auto expected = test_case.output;
+        const auto expected_last = ReferenceMix<Q>(expected, test_case.input, test_case.volume,
+                                                   test_case.ramp);
+        auto output = test_case.output;
+        const auto last =
+            MixSamples<Q>(output, test_case.input, volume.to_raw(), ramp.to_raw(), sample_count);
+        REQUIRE(output == expected);
+        REQUIRE(last == expected_last);
+
+        ReferenceScale<Q>(expected, test_case.input, test_case.volume, test_case.ramp);
+        ScaleSamples<Q>(output, test_case.input, volume.to_raw(), ramp.to_raw(), sample_count);
+        REQUIRE(output == expected);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MixKernels: Matches fixed point arithmetic with 15 bits", "[audio_core]") {
+    CheckMix<15>();
+}
+
+TEST_CASE("MixKernels: Matches fixed point arithmetic with 23 bits", "[audio_core]") {
+    CheckMix<23>();
+}
+
+TEST_CASE("MixKernels: Mixes in place", "[audio_core]") {
+    std::vector<s32> buffer(37);
+    for (size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = static_cast<s32>(i * 1000) - 12345;
+    }
+    const Common::FixedPoint<49, 15> volume{0.75f};
+    const Common::FixedPoint<49, 15> ramp{0.01f};
+
+    auto expected = buffer;
+    const auto expected_last = ReferenceMix<15>(expected, buffer, 0.75f, 0.01f);
+    const auto last = MixSamples<15>(buffer, buffer, volume.to_raw(), ramp.to_raw(),
+                                     static_cast<u32>(buffer.size()));
+    REQUIRE(buffer == expected);
+    REQUIRE(last == expected_last);
+}
@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/common/common.h"
+#include "audio_core/renderer/command/effect/delay_line_kernels.h"
+#include "audio_core/renderer/command/effect/i3dl2_reverb.h"
+#include "audio_core/renderer/command/effect/reverb.h"
+#include "common/common_types.h"
+#include "common/fixed_point.h"
+
+using namespace AudioCore;
+using namespace AudioCore::Renderer;
+
+namespace {
+
+constexpr s32 ToRaw(f32 value) {
+    return static_cast<s32>(value * (1 << 14));
+}
+
+/// The parameters of the "Room" preset.
+I3dl2ReverbInfo::ParameterVersion1 MakeI3dl2Parameter(u16 channel_count) {
+    return {
+        .channel_count_max = channel_count,
+        .channel_count = channel_count,
+        .sample_rate = TargetSampleRate,
+        .room_HF_gain = -454.0f,
+        .reference_HF = 5000.0f,
+        .late_reverb_decay_time = 0.4f,
+        .late_reverb_HF_decay_ratio = 0.83f,
+        .room_gain = -1000.0f,
+        .reflection_gain = -1646.0f,
+        .reverb_gain = 53.0f,
+        .late_reverb_diffusion = 100.0f,
+        .reflection_delay = 0.002f,
+        .late_reverb_delay_time = 0.003f,
+        .late_reverb_density = 100.0f,
+        .dry_gain = 1.0f,
+        .state = EffectInfoBase::ParameterState::Initialized,
+    };
+}
+
+ReverbInfo::ParameterVersion2 MakeReverbParameter(u16 channel_count) {
+    return {
+        .channel_count_max = channel_count,
+        .channel_count = channel_count,
+        .sample_rate = static_cast<u32>(ToRaw(TargetSampleRate / 1000.0f)),
+        .early_mode = 1,
+        .early_gain = ToRaw(0.7f),
+        .pre_delay = ToRaw(10.0f),
+        .late_mode = 1,
+        .late_gain = ToRaw(0.6f),
+        .decay_time = ToRaw(1.5f),
+        .high_freq_decay_ratio = ToRaw(0.5f),
+        .colouration = ToRaw(0.7f),
+        .base_gain = ToRaw(0.5f),
+        .wet_gain = ToRaw(0.5f),
+        .dry_gain = ToRaw(0.5f),
+        .state = EffectInfoBase::ParameterState::Initialized,
+    };
+}
+
+/**
+ * Runs a reverb command on noise, as the ADSP does once it has been initialized, with its inputs
+ * and outputs in separate mix buffers.
+ */
+template <typename Command, typename State>
+class EffectBenchmark {
+public:
+    explicit EffectBenchmark(const decltype(Command::parameter)& parameter)
+        : channel_count{parameter.channel_count},
+          mix_buffers(channel_count * 2 * TargetSampleCount) {
+        // The noise is taken straight from the engine, as the output of the distributions differs
+        // between standard libraries, and the golden output must not.
+        std::mt19937 rng{0x5EED};
+        source.resize(channel_count * TargetSampleCount);
+        std::generate(source.begin(), source.end(),
+                      [&] { return static_cast<s32>(rng() >> 8) - 0x800000; });
+
+        command.parameter = parameter;
+        for (u32 channel = 0; channel < channel_count; channel++) {
+            command.inputs[channel] = static_cast<s16>(channel);
+            command.outputs[channel] = static_cast<s16>(channel_count + channel);
+        }
+        command.state = CpuAddr(&state);
+        command.workbuffer = 0;
+        command.effect_enabled = true;
+
+        processor.sample_count = TargetSampleCount;
+        processor.target_sample_rate = TargetSampleRate;
+        processor.mix_buffers = mix_buffers;
+        processor.buffer_count = channel_count * 2;
+
+        ProcessFrame();
+        command.parameter.state = EffectInfoBase::ParameterState::Updated;
+    }
+
+    void ProcessFrame() {
+        std::ranges::copy(source, mix_buffers.begin());
+        command.Process(processor);
+    }
+
+    std::span<const s32> GetOutput() const {
+        return std::span(mix_buffers).subspan(channel_count * TargetSampleCount);
+    }
+
+private:
+    u32 channel_count;
+    std::vector<s32> source;
+    std::vector<s32> mix_buffers;
+    State state{};
+    Command command{};
+    ADSP::AudioRenderer::CommandListProcessor processor{};
+};
+
+using I3dl2ReverbBenchmark = EffectBenchmark<I3dl2ReverbCommand, I3dl2ReverbInfo::State>;
+using ReverbBenchmark = EffectBenchmark<ReverbCommand, ReverbInfo::State>;
+
+/// Output of each layout after eight frames, as rendered by the FixedPoint implementation the
+/// delay line kernels replaced.
+struct GoldenOutput {
+    u16 channel_count;
+    u64 i3dl2_reverb_hash;
+    u64 reverb_hash;
+};
+constexpr std::array<GoldenOutput, 4> GoldenOutputs{{
+    {1, 0x80165D97EF331BD9ULL, 0x0D458A56FB90CFDEULL},
+    {2, 0x8728BD38A61DBE22ULL, 0x53F98CFFFC809E17ULL},
+    {4, 0x6838B563EEE9239BULL, 0xF1277079ACB31DA7ULL},
+    {6, 0x54BD78766E6EAC4DULL, 0x97A908CEBE585AE8ULL},
+}};
+
+/// FNV-1a hash of the little endian bytes of the samples.
+u64 HashOutput(std::span<const s32> output) {
+    u64 hash = 0xCBF29CE484222325ULL;
+    for (const s32 sample : output) {
+        for (u32 byte = 0; byte < sizeof(sample); byte++) {
+            hash ^= (static_cast<u32>(sample) >> (byte * 8)) & 0xFF;
+            hash *= 0x100000001B3ULL;
+        }
+    }
+    return hash;
+}
+
+template <typename Benchmark>
+u64 RenderOutput(Benchmark& benchmark) {
+    for (u32 frame = 0; frame < 8; frame++) {
+        benchmark.ProcessFrame();
+    }
+    return HashOutput(benchmark.GetOutput());
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Reverb: Delay line kernels match fixed point arithmetic", "[audio_core]") {
+    using Fixed = Common::FixedPoint<50, 14>;
+    std::mt19937 rng{0x5EED};
+    std::uniform_int_distribution<s64> sample_dist{std::numeric_limits<s64>::min(),
+                                                   std::numeric_limits<s64>::max()};
+    std::uniform_int_distribution<s64> gain_dist{0, 1 << 15};
+
+    std::vector<Fixed> buffer(97);
+    for (auto& sample : buffer) {
+        sample = Fixed::from_base(sample_dist(rng));
+    }
+
+    // Gains which don't fit in 31 bits take the scalar path.
+    for (const s64 extra_gain : {s64{0}, s64{-20000}, s64{1} << 33}) {
+        for (const u32 sample_count : {1U, 3U, 64U, 97U}) {
+            for (const u32 position : {0U, 5U, 96U}) {
+                const auto gain{Fixed::from_base(gain_dist(rng) + extra_gain)};
+                std::vector<s64> output(sample_count);
+                std::generate(output.begin(), output.end(), [&] { return sample_dist(rng); });
+
+                auto expected{output};
+                for (u32 i = 0; i < sample_count; i++) {
+                    const auto tap{buffer[(position + i) % buffer.size()] * gain};
+                    expected[i] = (Fixed::from_base(expected[i]) + tap).to_raw();
+                }
+                AccumulateTap(output, buffer, position, gain);
+                REQUIRE(output == expected);
+
+                for (auto& sample : expected) {
+                    sample = (Fixed::from_base(sample) * gain).to_raw();
+                }
+                ApplyGain(output, gain);
+                REQUIRE(output == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Reverb: Matches the golden output of every channel layout", "[audio_core]") {
+    for (const auto& golden : GoldenOutputs) {
+        I3dl2ReverbBenchmark i3dl2_reverb{MakeI3dl2Parameter(golden.channel_count)};
+        REQUIRE(RenderOutput(i3dl2_reverb) == golden.i3dl2_reverb_hash);
+
+        ReverbBenchmark reverb{MakeReverbParameter(golden.channel_count)};
+        REQUIRE(RenderOutput(reverb) == golden.reverb_hash);
+    }
+}
+
+TEST_CASE("Reverb: Benchmark", "[audio_core][.benchmark]") {
+    I3dl2ReverbBenchmark i3dl2_reverb_stereo{MakeI3dl2Parameter(2)};
+    BENCHMARK("I3DL2 reverb, 2 channels") {
+        i3dl2_reverb_stereo.ProcessFrame();
+    };
+
+    I3dl2ReverbBenchmark i3dl2_reverb_surround{MakeI3dl2Parameter(6)};
+    BENCHMARK("I3DL2 reverb, 6 channels") {
+        i3dl2_reverb_surround.ProcessFrame();
+    };
+
+    ReverbBenchmark reverb_stereo{MakeReverbParameter(2)};
+    BENCHMARK("Reverb, 2 channels") {
+        reverb_stereo.ProcessFrame();
+    };
+
+    ReverbBenchmark reverb_surround{MakeReverbParameter(6)};
+    BENCHMARK("Reverb, 6 channels") {
+        reverb_surround.ProcessFrame();
+    };
+}
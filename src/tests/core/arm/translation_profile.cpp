@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/arm/translation_profile.h"
+
+namespace {
+
+constexpr u64 ProgramId = 0x0100000000010000ULL;
+constexpr std::array<u8, 0x20> BuildId{0x12, 0x34, 0x56, 0x78};
+
+struct ScopedProfilePath {
+    ScopedProfilePath()
+        : path{std::filesystem::temp_directory_path() / "yuzu_translation_profile_test.bin"} {}
+    ~ScopedProfilePath() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    std::filesystem::path path;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("TranslationProfile: Round trips blocks relative to their module", "[core]") {
+    const ScopedProfilePath profile;
+    const std::vector<Core::TranslationProfileModule> saved_modules{
+        {.name = "main", .base = 0x80004000, .end = 0x80008000},
+        {.name = "sdk", .base = 0x80010000, .end = 0x80020000},
+    };
+    const std::vector<u64> blocks{
+        0x80004000, 0x80004004, 0x80007FFC, // main, including adjacent blocks
+        0x80008000,                         // the end of main, which is outside of every module
+        0x80010000, 0x8001FFFC,             // sdk
+        0x90000000,                         // outside of every module
+    };
+    REQUIRE(Core::WriteTranslationProfile(profile.path, ProgramId, BuildId, saved_modules, blocks));
+
+    // Load the modules at other addresses, as happens with address space randomization.
+    const std::vector<Core::TranslationProfileModule> loaded_modules{
+        {.name = "sdk", .base = 0x10000000, .end = 0x10010000},
+        {.name = "main", .base = 0x20000000, .end = 0x20004000},
+    };
+    auto loaded = Core::ReadTranslationProfile(profile.path, ProgramId, BuildId, loaded_modules);
+    std::ranges::sort(loaded);
+    REQUIRE(loaded ==
+            std::vector<u64>{0x10000000, 0x1000FFFC, 0x20000000, 0x20000004, 0x20003FFC});
+}
+
+TEST_CASE("TranslationProfile: Ignores profiles of other builds", "[core]") {
+    const ScopedProfilePath profile;
+    const std::vector<Core::TranslationProfileModule> modules{
+        {.name = "main", .base = 0x80004000, .end = 0x80008000},
+    };
+    const std::vector<u64> blocks{0x80004000};
+    REQUIRE(Core::WriteTranslationProfile(profile.path, ProgramId, BuildId, modules, blocks));
+
+    std::array<u8, 0x20> other_build_id = BuildId;
+    other_build_id[0] ^= 0xFF;
+    REQUIRE(Core::ReadTranslationProfile(profile.path, ProgramId, other_build_id, modules).empty());
+    REQUIRE(Core::ReadTranslationProfile(profile.path, ProgramId + 1, BuildId, modules).empty());
+    REQUIRE(Core::ReadTranslationProfile(profile.path, ProgramId, BuildId, modules) == blocks);
+}
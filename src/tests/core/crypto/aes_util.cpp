@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/hex_util.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/key_manager.h"
+
+using namespace Core::Crypto;
+
+namespace {
+
+std::vector<u8> MakeData(std::size_t size) {
+    std::vector<u8> data(size);
+    for (std::size_t i = 0; i < size; i++) {
+        data[i] = static_cast<u8>(i * 7 + (i >> 8));
+    }
+    return data;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("AESCipher: CTR test vector", "[crypto]") {
+    // NIST SP 800-38A, F.5.1 CTR-AES128.Encrypt
+    const auto key = Common::HexStringToArray<0x10>("2b7e151628aed2a6abf7158809cf4f3c");
+    const auto counter = Common::HexStringToArray<0x10>("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+    const auto plaintext = Common::HexStringToVector(
+        "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+        "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710",
+        false);
+    const auto ciphertext = Common::HexStringToVector(
+        "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+        "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee",
+        false);
+
+    AESCipher<Key128> cipher(key, Mode::CTR);
+    std::vector<u8> out(plaintext.size());
+
+    cipher.SetIV(counter);
+    cipher.Transcode(plaintext.data(), plaintext.size(), out.data(), Op::Encrypt);
+    REQUIRE(out == ciphertext);
+
+    cipher.SetIV(counter);
+    cipher.Transcode(ciphertext.data(), ciphertext.size(), out.data(), Op::Decrypt);
+    REQUIRE(out == plaintext);
+}
+
+TEST_CASE("AESCipher: CTR counter carries across calls", "[crypto]") {
+    const auto key = Common::HexStringToArray<0x10>("000102030405060708090a0b0c0d0e0f");
+    const auto counter = Common::HexStringToArray<0x10>("00000000000000000000fffffffffffe");
+    const auto data = MakeData(0x1000);
+
+    AESCipher<Key128> cipher(key, Mode::CTR);
+    std::vector<u8> whole(data.size());
+    cipher.SetIV(counter);
+    cipher.Transcode(data.data(), data.size(), whole.data(), Op::Decrypt);
+
+    // Transcoding block-aligned chunks must continue the counter of the previous call.
+    std::vector<u8> chunked(data.size());
+    cipher.SetIV(counter);
+    for (std::size_t offset = 0; offset < data.size(); offset += 0x30) {
+        const std::size_t size = std::min<std::size_t>(0x30, data.size() - offset);
+        cipher.Transcode(data.data() + offset, size, chunked.data() + offset, Op::Decrypt);
+    }
+    REQUIRE(chunked == whole);
+
+    // A partial block is transcoded with the keystream of its block.
+    std::vector<u8> partial(5);
+    cipher.SetIV(counter);
+    cipher.Transcode(data.data(), partial.size(), partial.data(), Op::Decrypt);
+    REQUIRE(std::equal(partial.begin(), partial.end(), whole.begin()));
+}
+
+TEST_CASE("AESCipher: XTS test vector", "[crypto]") {
+    // IEEE P1619, XTS-AES-128 test vector 2
+    const auto key = Common::HexStringToArray<0x20>(
+        "1111111111111111111111111111111122222222222222222222222222222222");
+    const auto iv = Common::HexStringToArray<0x10>("33333333330000000000000000000000");
+    const auto plaintext = Common::HexStringToVector(
+        "4444444444444444444444444444444444444444444444444444444444444444", false);
+    const auto ciphertext = Common::HexStringToVector(
+        "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0", false);
+
+    AESCipher<Key256> cipher(key, Mode::XTS);
+    std::vector<u8> out(plaintext.size());
+
+    cipher.SetIV(iv);
+    cipher.Transcode(plaintext.data(), plaintext.size(), out.data(), Op::Encrypt);
+    REQUIRE(out == ciphertext);
+
+    cipher.SetIV(iv);
+    cipher.Transcode(ciphertext.data(), ciphertext.size(), out.data(), Op::Decrypt);
+    REQUIRE(out == plaintext);
+}
+
+TEST_CASE("AESCipher: XTS multi-sector transcode", "[crypto]") {
+    constexpr std::size_t SectorSize = 0x200;
+    constexpr std::size_t SectorId = 0x1234;
+
+    const auto key = Common::HexStringToArray<0x20>(
+        "27182818284590452353602874713526"
+        "31415926535897932384626433832795");
+    const auto data = MakeData(SectorSize * 8);
+
+    AESCipher<Key256> cipher(key, Mode::XTS);
+    std::vector<u8> encrypted(data.size());
+    cipher.XTSTranscode(data.data(), data.size(), encrypted.data(), SectorId, SectorSize,
+                        Op::Encrypt);
+    REQUIRE(encrypted != data);
+
+    // Every sector must decrypt independently with its own tweak.
+    std::vector<u8> decrypted(data.size());
+    for (std::size_t i = 0; i < data.size(); i += SectorSize) {
+        cipher.XTSTranscode(encrypted.data() + i, SectorSize, decrypted.data() + i,
+                            SectorId + i / SectorSize, SectorSize, Op::Decrypt);
+    }
+    REQUIRE(decrypted == data);
+}
+
+TEST_CASE("AESCipher: Throughput benchmark", "[crypto][.benchmark]") {
+    constexpr std::size_t DataSize = 16 * 1024 * 1024;
+
+    const auto data = MakeData(DataSize);
+    std::vector<u8> out(DataSize);
+
+    BENCHMARK("AES-128-CTR 16 MiB") {
+        AESCipher<Key128> cipher(Key128{}, Mode::CTR);
+        cipher.SetIV(std::array<u8, 0x10>{});
+        cipher.Transcode(data.data(), data.size(), out.data(), Op::Decrypt);
+        return out[0];
+    };
+
+    BENCHMARK("AES-128-XTS 16 MiB, 0x4000 byte sectors") {
+        AESCipher<Key256> cipher(Key256{}, Mode::XTS);
+        cipher.XTSTranscode(data.data(), data.size(), out.data(), 0, 0x4000, Op::Decrypt);
+        return out[0];
+    };
+}
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/hex_util.h"
+#include "core/crypto/sha_util.h"
+
+using namespace Core::Crypto;
+
+namespace {
+
+std::array<u8, 0x20> HashString(std::string_view data) {
+    return SHA256(reinterpret_cast<const u8*>(data.data()), data.size());
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SHA256: Test vectors", "[crypto]") {
+    // FIPS 180-2, Appendix B
+    REQUIRE(HashString("") ==
+            Common::HexStringToArray<0x20>(
+                "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    REQUIRE(HashString("abc") ==
+            Common::HexStringToArray<0x20>(
+                "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    REQUIRE(HashString("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+            Common::HexStringToArray<0x20>(
+                "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+}
+
+TEST_CASE("SHA256: Incremental updates", "[crypto]") {
+    // One million repetitions of 'a', hashed in chunks that straddle the block boundaries.
+    const std::vector<u8> data(1000000, 'a');
+    const auto expected = Common::HexStringToArray<0x20>(
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+    SHA256Hasher hasher;
+    std::size_t offset = 0;
+    for (std::size_t chunk = 1; offset < data.size(); chunk = chunk * 3 % 257 + 1) {
+        const std::size_t size = std::min(chunk, data.size() - offset);
+        hasher.Update(data.data() + offset, size);
+        offset += size;
+    }
+    REQUIRE(hasher.Finish() == expected);
+    REQUIRE(SHA256(data.data(), data.size()) == expected);
+}
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <numeric>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/file_sys/fssystem/fssystem_block_cache.h"
+
+using FileSys::BlockCache;
+
+TEST_CASE("BlockCache: Partial reads", "[file_sys]") {
+    BlockCache cache{0x1000, 1};
+    const u64 owner = cache.AllocateOwner();
+
+    std::array<u8, 0x100> block;
+    std::iota(block.begin(), block.end(), u8{0});
+    cache.Insert(owner, 0x4000, block.data(), block.size());
+
+    std::array<u8, 0x10> out{};
+    REQUIRE(cache.Read(owner, 0x4000, out.data(), 0x20, out.size()));
+    REQUIRE(out[0] == 0x20);
+    REQUIRE(out[0xF] == 0x2F);
+
+    // Reads past the end of the block, of other offsets or of other owners miss.
+    REQUIRE(!cache.Read(owner, 0x4000, out.data(), 0xF8, out.size()));
+    REQUIRE(!cache.Read(owner, 0x4100, out.data(), 0, out.size()));
+    REQUIRE(!cache.Read(cache.AllocateOwner(), 0x4000, out.data(), 0, out.size()));
+
+    const auto stats = cache.GetStatistics();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 3);
+    REQUIRE(stats.used_size == block.size());
+}
+
+TEST_CASE("BlockCache: Least recently used eviction", "[file_sys]") {
+    BlockCache cache{0x300, 1};
+    const u64 owner = cache.AllocateOwner();
+
+    const std::array<u8, 0x100> block{};
+    std::array<u8, 1> out{};
+    cache.Insert(owner, 0, block.data(), block.size());
+    cache.Insert(owner, 1, block.data(), block.size());
+    cache.Insert(owner, 2, block.data(), block.size());
+
+    // Touch the oldest block, so the next insertion evicts the second one instead.
+    REQUIRE(cache.Read(owner, 0, out.data(), 0, out.size()));
+    cache.Insert(owner, 3, block.data(), block.size());
+
+    REQUIRE(cache.Read(owner, 0, out.data(), 0, out.size()));
+    REQUIRE(!cache.Read(owner, 1, out.data(), 0, out.size()));
+    REQUIRE(cache.Read(owner, 2, out.data(), 0, out.size()));
+    REQUIRE(cache.Read(owner, 3, out.data(), 0, out.size()));
+    REQUIRE(cache.GetStatistics().used_size == 0x300);
+
+    // Blocks larger than a shard are not cached.
+    const std::array<u8, 0x400> large{};
+    cache.Insert(owner, 4, large.data(), large.size());
+    REQUIRE(!cache.Read(owner, 4, out.data(), 0, out.size()));
+}
+
+TEST_CASE("BlockCache: Invalidation", "[file_sys]") {
+    BlockCache cache{0x10000, 4};
+    const u64 owner_a = cache.AllocateOwner();
+    const u64 owner_b = cache.AllocateOwner();
+
+    const std::array<u8, 0x100> block{};
+    std::array<u8, 1> out{};
+    for (s64 offset = 0; offset < 0x10; offset++) {
+        cache.Insert(owner_a, offset, block.data(), block.size());
+        cache.Insert(owner_b, offset, block.data(), block.size());
+    }
+
+    cache.Invalidate(owner_a);
+    for (s64 offset = 0; offset < 0x10; offset++) {
+        REQUIRE(!cache.Read(owner_a, offset, out.data(), 0, out.size()));
+        REQUIRE(cache.Read(owner_b, offset, out.data(), 0, out.size()));
+    }
+    REQUIRE(cache.GetStatistics().used_size == 0x10 * block.size());
+}
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/fs/path_util.h"
+#include "core/file_sys/vfs/vfs_real.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
+
+namespace {
+
+// A directory of the host, removed with everything in it once the test is done.
+struct ScopedHostDirectory {
+    ScopedHostDirectory()
+        : path{std::filesystem::temp_directory_path() / "yuzu_write_back_test"} {
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+        dir = vfs.OpenDirectory(Common::FS::PathToUTF8String(path), FileSys::OpenMode::ReadWrite);
+    }
+    ~ScopedHostDirectory() {
+        dir.reset();
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    std::filesystem::path path;
+    FileSys::RealVfsFilesystem vfs;
+    FileSys::VirtualDir dir;
+};
+
+std::vector<u8> Bytes(std::string_view text) {
+    return {text.begin(), text.end()};
+}
+
+} // Anonymous namespace
+
+TEST_CASE("WriteBackCache: Buffers writes until committed", "[file_sys]") {
+    ScopedHostDirectory host;
+    REQUIRE(host.dir->CreateFile("save.bin")->WriteBytes(Bytes("0123456789")) == 10);
+
+    auto cache = std::make_shared<FileSys::WriteBackCache>(host.dir);
+    const auto file = cache->GetRoot()->GetFile("save.bin");
+    REQUIRE(file != nullptr);
+
+    // Separate writes which come to touch are merged, and the rest of the file stays readable.
+    REQUIRE(file->WriteBytes(Bytes("ab"), 2) == 2);
+    REQUIRE(file->WriteBytes(Bytes("cd"), 4) == 2);
+    REQUIRE(file->WriteBytes(Bytes("xy"), 12) == 2);
+    REQUIRE(file->GetSize() == 14);
+    REQUIRE(file->ReadAllBytes() == Bytes(std::string_view{"01abcd6789\0\0xy", 14}));
+
+    // Nothing reaches the host until the commit.
+    const auto host_file = host.dir->GetFile("save.bin");
+    REQUIRE(host_file->ReadAllBytes() == Bytes("0123456789"));
+    REQUIRE(cache->Commit());
+    REQUIRE(host_file->ReadAllBytes() == Bytes(std::string_view{"01abcd6789\0\0xy", 14}));
+    REQUIRE(host.dir->GetFile("save.bin.tmp") == nullptr);
+
+    // A truncated file does not read back its old contents when it grows again.
+    REQUIRE(file->Resize(4));
+    REQUIRE(file->Resize(6));
+    REQUIRE(file->WriteBytes(Bytes("z"), 5) == 1);
+    REQUIRE(file->ReadAllBytes() == Bytes(std::string_view{"01ab\0z", 6}));
+    REQUIRE(cache->Commit());
+    REQUIRE(host_file->ReadAllBytes() == Bytes(std::string_view{"01ab\0z", 6}));
+
+    const auto statistics = cache->GetStatistics();
+    REQUIRE(statistics.bytes_written == 7);
+    REQUIRE(statistics.bytes_committed == 20);
+    REQUIRE(statistics.files_committed == 2);
+    REQUIRE(statistics.failed_commits == 0);
+}
+
+TEST_CASE("WriteBackCache: Discards the writes of deleted and recreated files", "[file_sys]") {
+    ScopedHostDirectory host;
+    REQUIRE(host.dir->CreateFile("deleted.bin")->WriteBytes(Bytes("old")) == 3);
+    REQUIRE(host.dir->CreateFile("recreated.bin")->WriteBytes(Bytes("old")) == 3);
+
+    auto cache = std::make_shared<FileSys::WriteBackCache>(host.dir);
+    const auto root = cache->GetRoot();
+    const auto deleted = root->GetFile("deleted.bin");
+    const auto recreated = root->GetFile("recreated.bin");
+    REQUIRE(deleted->WriteBytes(Bytes("new")) == 3);
+    REQUIRE(recreated->WriteBytes(Bytes("new")) == 3);
+
+    // Handles of a deleted file fail, rather than writing it back on the next commit.
+    REQUIRE(root->DeleteFile("deleted.bin"));
+    REQUIRE(deleted->WriteBytes(Bytes("late")) == 0);
+    REQUIRE(deleted->GetSize() == 0);
+
+    // Handles of a recreated file see the new file.
+    REQUIRE(root->CreateFile("recreated.bin") != nullptr);
+    REQUIRE(recreated->GetSize() == 0);
+    REQUIRE(recreated->WriteBytes(Bytes("newer")) == 5);
+
+    REQUIRE(cache->Commit());
+    REQUIRE(host.dir->GetFile("deleted.bin") == nullptr);
+    REQUIRE(host.dir->GetFile("recreated.bin")->ReadAllBytes() == Bytes("newer"));
+}
+
+TEST_CASE("WriteBackCache: Writes large files through", "[file_sys]") {
+    ScopedHostDirectory host;
+    REQUIRE(host.dir->CreateFile("large.bin") != nullptr);
+
+    auto cache = std::make_shared<FileSys::WriteBackCache>(host.dir);
+    const auto file = cache->GetRoot()->GetFile("large.bin");
+    REQUIRE(file->WriteBytes(Bytes("small")) == 5);
+
+    // Growing past the budget commits what was buffered, and later writes go to the host.
+    constexpr size_t Offset = FileSys::WriteBackCache::MaxDirtySize;
+    REQUIRE(file->WriteBytes(Bytes("large"), Offset) == 5);
+    const auto host_file = host.dir->GetFile("large.bin");
+    REQUIRE(host_file->GetSize() == Offset + 5);
+    REQUIRE(host_file->ReadBytes(5, 0) == Bytes("small"));
+    REQUIRE(host_file->ReadBytes(5, Offset) == Bytes("large"));
+}
+
+TEST_CASE("RealVfsFile: Replaces the contents of an open file", "[file_sys]") {
+    ScopedHostDirectory host;
+    const auto file = host.dir->CreateFile("file.bin");
+    REQUIRE(file->WriteBytes(Bytes("old contents")) == 12);
+    REQUIRE(file->ReadAllBytes() == Bytes("old contents"));
+
+    REQUIRE(file->Replace(Bytes("new")));
+    REQUIRE(file->GetSize() == 3);
+    REQUIRE(file->ReadAllBytes() == Bytes("new"));
+    REQUIRE(host.dir->GetFile("file.bin.tmp") == nullptr);
+}
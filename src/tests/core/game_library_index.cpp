@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <filesystem>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/file_sys/nca_metadata.h"
+#include "core/game_library_index.h"
+#include "core/loader/loader.h"
+
+namespace {
+
+using FileEntry = Core::GameLibraryIndex::FileEntry;
+
+struct ScopedIndexPath {
+    ScopedIndexPath()
+        : path{std::filesystem::temp_directory_path() / "yuzu_game_library_index_test.bin"} {}
+    ~ScopedIndexPath() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    std::filesystem::path path;
+};
+
+void RequireEqual(const FileEntry& lhs, const FileEntry& rhs) {
+    REQUIRE(lhs.path == rhs.path);
+    REQUIRE(lhs.size == rhs.size);
+    REQUIRE(lhs.write_time == rhs.write_time);
+    REQUIRE(lhs.file_type == rhs.file_type);
+    REQUIRE(lhs.keys_fingerprint == rhs.keys_fingerprint);
+    REQUIRE(lhs.has_programs == rhs.has_programs);
+    REQUIRE(lhs.content_fingerprint == rhs.content_fingerprint);
+
+    REQUIRE(lhs.contents.size() == rhs.contents.size());
+    for (size_t i = 0; i < lhs.contents.size(); i++) {
+        const auto& lhs_content = lhs.contents[i];
+        const auto& rhs_content = rhs.contents[i];
+        REQUIRE(lhs_content.title_type == rhs_content.title_type);
+        REQUIRE(lhs_content.record_type == rhs_content.record_type);
+        REQUIRE(lhs_content.title_id == rhs_content.title_id);
+        REQUIRE(lhs_content.offset == rhs_content.offset);
+        REQUIRE(lhs_content.size == rhs_content.size);
+    }
+
+    REQUIRE(lhs.programs.size() == rhs.programs.size());
+    for (size_t i = 0; i < lhs.programs.size(); i++) {
+        const auto& lhs_program = lhs.programs[i];
+        const auto& rhs_program = rhs.programs[i];
+        REQUIRE(lhs_program.program_id == rhs_program.program_id);
+        REQUIRE(lhs_program.title == rhs_program.title);
+        REQUIRE(lhs_program.icon == rhs_program.icon);
+        REQUIRE(lhs_program.romfs_updatable == rhs_program.romfs_updatable);
+        REQUIRE(lhs_program.update_offset == rhs_program.update_offset);
+        REQUIRE(lhs_program.update_size == rhs_program.update_size);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("GameLibraryIndex: Round trips indexed files", "[core]") {
+    const ScopedIndexPath index;
+    const FileEntry package{
+        .path = "/games/package.nsp",
+        .size = 0x12345678,
+        .write_time = 0x1122334455667788,
+        .file_type = Loader::FileType::NSP,
+        .keys_fingerprint = 0xAAAABBBBCCCCDDDD,
+        .contents =
+            {
+                {
+                    .title_type = FileSys::TitleType::Application,
+                    .record_type = FileSys::ContentRecordType::Program,
+                    .title_id = 0x0100000000010000,
+                    .offset = 0x4000,
+                    .size = 0x100000,
+                },
+                {
+                    .title_type = FileSys::TitleType::Update,
+                    .record_type = FileSys::ContentRecordType::Control,
+                    .title_id = 0x0100000000010800,
+                    .offset = 0x104000,
+                    .size = 0x8000,
+                },
+            },
+        .has_programs = true,
+        .content_fingerprint = 0x0123456789ABCDEF,
+        .programs =
+            {
+                {
+                    .program_id = 0x0100000000010000,
+                    .title = "Game",
+                    .icon = {0xFF, 0xD8, 0xFF, 0xE0},
+                    .romfs_updatable = true,
+                    .update_offset = 0x104000,
+                    .update_size = 0x8000,
+                },
+                {
+                    .program_id = 0x0100000000010001,
+                    .title = "Game: Second Program",
+                    .icon = {},
+                    .romfs_updatable = false,
+                    .update_offset = 0,
+                    .update_size = 0,
+                },
+            },
+    };
+    // Files of unknown formats are indexed without any contents or programs.
+    const FileEntry unknown{
+        .path = "/games/readme.nro",
+        .size = 16,
+        .write_time = 1,
+        .file_type = Loader::FileType::Unknown,
+        .keys_fingerprint = 0,
+        .contents = {},
+        .has_programs = false,
+        .content_fingerprint = 0,
+        .programs = {},
+    };
+
+    const std::vector<const FileEntry*> files{&package, &unknown};
+    REQUIRE(Core::GameLibraryIndex::WriteIndex(index.path, files));
+
+    const auto loaded = Core::GameLibraryIndex::ReadIndex(index.path);
+    REQUIRE(loaded.size() == files.size());
+    RequireEqual(*loaded[0], package);
+    RequireEqual(*loaded[1], unknown);
+}
+
+TEST_CASE("GameLibraryIndex: Stops at a truncated index", "[core]") {
+    const ScopedIndexPath index;
+    const FileEntry file{
+        .path = "/games/game.xci",
+        .size = 0x1000,
+        .write_time = 2,
+        .file_type = Loader::FileType::XCI,
+        .keys_fingerprint = 3,
+        .contents = {},
+        .has_programs = false,
+        .content_fingerprint = 0,
+        .programs = {},
+    };
+    const std::vector<const FileEntry*> files{&file, &file};
+    REQUIRE(Core::GameLibraryIndex::WriteIndex(index.path, files));
+
+    // Cut the second record short, which must not be read back.
+    const auto size = std::filesystem::file_size(index.path);
+    std::filesystem::resize_file(index.path, size - 4);
+
+    const auto loaded = Core::GameLibraryIndex::ReadIndex(index.path);
+    REQUIRE(loaded.size() == 1);
+    RequireEqual(*loaded[0], file);
+}
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/core.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/hle/kernel/k_address_arbiter.h"
+#include "core/hle/kernel/k_hashed_thread_tree.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/k_scoped_resource_reservation.h"
+#include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/svc_common.h"
+#include "core/hle/kernel/svc_results.h"
+#include "core/hle/kernel/svc_types.h"
+#include "core/memory.h"
+
+namespace {
+
+/**
+ * Boots the kernel with a process owning a heap, as the loader does for homebrew, and runs host
+ * threads as threads of that process, as the HLE services do.
+ */
+class ArbiterFixture {
+public:
+    ArbiterFixture() {
+        system.Initialize();
+        kernel.Initialize();
+
+        process = Kernel::KProcess::Create(kernel);
+        REQUIRE(R_SUCCEEDED(process->LoadFromMetadata(FileSys::ProgramMetadata::GetDefault(),
+                                                      Kernel::PageSize, 0, false)));
+        Kernel::KProcess::Register(kernel, process);
+
+        Kernel::KProcessAddress heap_address{};
+        REQUIRE(R_SUCCEEDED(process->GetPageTable().SetHeapSize(
+            std::addressof(heap_address), Kernel::Svc::HeapSizeAlignment)));
+        base_address = GetInteger(heap_address);
+    }
+
+    ~ArbiterFixture() {
+        threads.clear();
+        process->Close();
+        kernel.Shutdown();
+    }
+
+    /// Runs func on a new thread of the process, returning the kernel thread it runs as.
+    Kernel::KThread* RunThread(std::function<void()>&& func) {
+        Kernel::KScopedResourceReservation thread_reservation(
+            process, Kernel::LimitableResource::ThreadCountMax);
+        REQUIRE(thread_reservation.Succeeded());
+
+        Kernel::KThread* thread = Kernel::KThread::Create(kernel);
+        REQUIRE(R_SUCCEEDED(Kernel::KThread::InitializeDummyThread(thread, process)));
+        thread_reservation.Commit();
+        Kernel::KThread::Register(kernel, thread);
+
+        threads.emplace_back([this, thread, func_ = std::move(func)] {
+            kernel.RegisterHostThread(thread);
+            func_();
+            thread->Close();
+        });
+        return thread;
+    }
+
+    /// Blocks until every thread in waiting_threads is waiting on the arbiter.
+    static void WaitUntilWaiting(const std::vector<Kernel::KThread*>& waiting_threads) {
+        for (const auto* thread : waiting_threads) {
+            while (!thread->IsWaitingForAddressArbiter()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    Core::System system;
+    Kernel::KernelCore& kernel{system.Kernel()};
+    Kernel::KProcess* process{};
+    u64 base_address{};
+    std::vector<std::jthread> threads;
+};
+
+/// Finds an address which isn't address, but is hashed into the same bucket of waiters.
+u64 FindCollidingAddress(u64 address) {
+    using Trees = Kernel::KAddressArbiter::HashedThreadTree;
+    const auto bucket = Trees::GetBucketIndex(address);
+    for (u64 other = address + sizeof(u32);; other += sizeof(u32)) {
+        if (Trees::GetBucketIndex(other) == bucket) {
+            return other;
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("KAddressArbiter: Signals the waiters of an address in order", "[kernel]") {
+    ArbiterFixture fixture;
+    auto* process = fixture.process;
+    const u64 address = fixture.base_address;
+    const u64 colliding_address = FindCollidingAddress(address);
+    REQUIRE(colliding_address < fixture.base_address + Kernel::Svc::HeapSizeAlignment);
+    process->GetMemory().Write32(address, 0);
+    process->GetMemory().Write32(colliding_address, 0);
+
+    constexpr size_t NumWaiters = 6;
+    std::mutex woken_lock;
+    std::vector<size_t> woken;
+    std::vector<Result> results(NumWaiters, ResultUnknown);
+    std::vector<Kernel::KThread*> waiters;
+    const auto wait = [&](u64 wait_address, size_t index) {
+        return [&, wait_address, index] {
+            results[index] = process->WaitAddressArbiter(
+                wait_address, Kernel::Svc::ArbitrationType::WaitIfEqual, 0, -1);
+            std::scoped_lock lk{woken_lock};
+            woken.push_back(index);
+        };
+    };
+
+    // Queue the waiters one at a time, so that their order in the tree is known.
+    for (size_t index = 0; index < NumWaiters; index++) {
+        const u64 wait_address = index % 2 == 0 ? address : colliding_address;
+        waiters.push_back(fixture.RunThread(wait(wait_address, index)));
+        ArbiterFixture::WaitUntilWaiting(waiters);
+    }
+
+    // Waiters of equal priority are woken in the order they waited, and only those waiting on
+    // the signalled address are woken, even though the other address shares their bucket.
+    const auto signal = [&](u64 signal_address, s32 count, size_t expected_woken) {
+        REQUIRE(process->SignalAddressArbiter(signal_address, Kernel::Svc::SignalType::Signal, 0,
+                                              count) == ResultSuccess);
+        while (true) {
+            {
+                std::scoped_lock lk{woken_lock};
+                if (woken.size() >= expected_woken) {
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+    signal(address, 1, 1);
+    signal(address, 1, 2);
+    {
+        std::scoped_lock lk{woken_lock};
+        REQUIRE(woken == std::vector<size_t>{0, 2});
+    }
+
+    REQUIRE(waiters[4]->IsWaitingForAddressArbiter());
+    signal(colliding_address, -1, 5);
+    signal(address, -1, 6);
+    fixture.threads.clear();
+    REQUIRE(woken.size() == NumWaiters);
+    for (const Result result : results) {
+        REQUIRE(result == ResultSuccess);
+    }
+
+    // The waiters woken by a single broadcast may run in any order on the host.
+    std::vector<size_t> broadcast_woken(woken.begin() + 2, woken.end() - 1);
+    std::ranges::sort(broadcast_woken);
+    REQUIRE(broadcast_woken == std::vector<size_t>{1, 3, 5});
+    REQUIRE(woken.back() == 4);
+}
+
+TEST_CASE("KAddressArbiter: Checks the value before waiting", "[kernel]") {
+    ArbiterFixture fixture;
+    auto* process = fixture.process;
+    const u64 address = fixture.base_address;
+    process->GetMemory().Write32(address, 5);
+
+    // Each of these must return without ever putting the thread to sleep.
+    std::vector<Result> results;
+    fixture.RunThread([&] {
+        using Kernel::Svc::ArbitrationType;
+        results.push_back(
+            process->WaitAddressArbiter(address, ArbitrationType::WaitIfEqual, 4, -1));
+        results.push_back(
+            process->WaitAddressArbiter(address, ArbitrationType::WaitIfLessThan, 5, -1));
+        results.push_back(process->WaitAddressArbiter(address, ArbitrationType::WaitIfEqual, 5, 0));
+    });
+    fixture.threads.clear();
+    REQUIRE(results == std::vector<Result>{Kernel::ResultInvalidState, Kernel::ResultInvalidState,
+                                           Kernel::ResultTimedOut});
+}
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/intrusive_red_black_tree.h"
+#include "core/hle/kernel/k_hashed_thread_tree.h"
+
+namespace {
+
+struct Waiter {
+    Common::IntrusiveRedBlackTreeNode node{};
+    u64 key{};
+    s32 priority{};
+
+    u64 GetConditionVariableKey() const {
+        return key;
+    }
+    s32 GetPriority() const {
+        return priority;
+    }
+};
+
+struct WaiterComparator {
+    struct RedBlackKeyType {
+        u64 cv_key{};
+        s32 priority{};
+
+        constexpr u64 GetConditionVariableKey() const {
+            return cv_key;
+        }
+        constexpr s32 GetPriority() const {
+            return priority;
+        }
+    };
+
+    template <typename T>
+        requires(std::same_as<T, Waiter> || std::same_as<T, RedBlackKeyType>)
+    static constexpr int Compare(const T& lhs, const Waiter& rhs) {
+        const u64 l_key = lhs.GetConditionVariableKey();
+        const u64 r_key = rhs.GetConditionVariableKey();
+
+        if (l_key < r_key) {
+            return -1;
+        } else if (l_key == r_key && lhs.GetPriority() < rhs.GetPriority()) {
+            return -1;
+        } else {
+            return 1;
+        }
+    }
+};
+
+using WaiterTree =
+    Common::IntrusiveRedBlackTreeMemberTraits<&Waiter::node>::TreeType<WaiterComparator>;
+using HashedWaiterTree = Kernel::KHashedThreadTree<WaiterTree>;
+
+constexpr size_t NumWaiters = 8192;
+constexpr size_t NumAddresses = 1024;
+constexpr u64 BaseAddress = 0x8000000;
+
+std::vector<Waiter> MakeWaiters() {
+    std::mt19937 rng{1234};
+    std::uniform_int_distribution<s32> priority_dist{0, 63};
+
+    std::vector<Waiter> waiters(NumWaiters);
+    for (size_t i = 0; i < NumWaiters; i++) {
+        waiters[i].key = BaseAddress + (i % NumAddresses) * sizeof(u32);
+        waiters[i].priority = priority_dist(rng);
+    }
+    return waiters;
+}
+
+// Signals every waiter on a key, returning the number of woken waiters.
+template <typename Tree>
+size_t SignalAll(Tree& tree, u64 key) {
+    size_t num_waiters = 0;
+    auto it = tree.nfind_key({key, -1});
+    while (it != tree.end() && it->GetConditionVariableKey() == key) {
+        it = tree.erase(it);
+        ++num_waiters;
+    }
+    return num_waiters;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("KHashedThreadTree: Spreads neighbouring addresses over buckets", "[kernel]") {
+    for (u64 key = BaseAddress; key < BaseAddress + NumAddresses * sizeof(u32); key += 4) {
+        REQUIRE(HashedWaiterTree::GetBucketIndex(key) < HashedWaiterTree::BucketCount);
+    }
+
+    // Neighbouring words must not all collapse into a single bucket.
+    std::vector<size_t> buckets;
+    for (u64 i = 0; i < HashedWaiterTree::BucketCount; i++) {
+        buckets.push_back(HashedWaiterTree::GetBucketIndex(BaseAddress + i * sizeof(u32)));
+    }
+    std::ranges::sort(buckets);
+    const auto unique_end = std::unique(buckets.begin(), buckets.end());
+    REQUIRE(static_cast<size_t>(unique_end - buckets.begin()) > HashedWaiterTree::BucketCount / 2);
+}
+
+TEST_CASE("KHashedThreadTree: Stress benchmark", "[kernel][.benchmark]") {
+    BENCHMARK_ADVANCED("Single tree")(Catch::Benchmark::Chronometer meter) {
+        auto waiters = MakeWaiters();
+        meter.measure([&] {
+            WaiterTree tree;
+            for (auto& waiter : waiters) {
+                tree.insert(waiter);
+            }
+            size_t woken = 0;
+            for (size_t address = 0; address < NumAddresses; address++) {
+                woken += SignalAll(tree, BaseAddress + address * sizeof(u32));
+            }
+            return woken;
+        });
+    };
+
+    BENCHMARK_ADVANCED("Hashed trees")(Catch::Benchmark::Chronometer meter) {
+        auto waiters = MakeWaiters();
+        meter.measure([&] {
+            HashedWaiterTree trees;
+            for (auto& waiter : waiters) {
+                trees.GetTree(waiter.key).insert(waiter);
+            }
+            size_t woken = 0;
+            for (size_t address = 0; address < NumAddresses; address++) {
+                const u64 key = BaseAddress + address * sizeof(u32);
+                woken += SignalAll(trees.GetTree(key), key);
+            }
+            return woken;
+        });
+    };
+}
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/textures/decoders.h"
+
+using namespace Tegra::Texture;
+
+TEST_CASE("Swizzle: Swizzling lines matches swizzling the whole subrect", "[video_core]") {
+    constexpr u32 BytesPerPixel = 4;
+    std::mt19937 rng{0x5EED};
+    std::uniform_int_distribution<u32> byte_dist{0, 0xFF};
+
+    for (const u32 width : {1U, 5U, 64U, 100U, 1280U}) {
+        for (const u32 height : {1U, 9U, 40U, 130U}) {
+            for (const u32 block_height : {0U, 2U, 4U}) {
+                const u32 pitch = width * BytesPerPixel;
+                std::vector<u8> input(pitch * height);
+                for (auto& value : input) {
+                    value = static_cast<u8>(byte_dist(rng));
+                }
+
+                const auto size =
+                    CalculateSize(true, BytesPerPixel, width, height, 1, block_height, 0);
+                std::vector<u8> expected(size);
+                SwizzleSubrect(expected, input, BytesPerPixel, width, height, 1, 0, 0, width,
+                               height, block_height, 0, pitch);
+
+                // Split the lines unevenly, as concurrent slices of a frame would be.
+                std::vector<u8> output(size);
+                const u32 split = height / 3;
+                SwizzleLines(output, input, pitch, 0, split, block_height, pitch);
+                SwizzleLines(output, input, pitch, split, height, block_height, pitch);
+                REQUIRE(output == expected);
+            }
+        }
+    }
+}
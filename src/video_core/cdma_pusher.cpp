@@ -14,10 +14,10 @@
 
 namespace Tegra {
 CDmaPusher::CDmaPusher(Host1x::Host1x& host1x_)
-    : host1x{host1x_}, nvdec_processor(std::make_shared<Host1x::Nvdec>(host1x)),
+    : host1x{host1x_}, sync_manager(std::make_unique<Host1x::SyncptIncrManager>(host1x)),
+      nvdec_processor(std::make_shared<Host1x::Nvdec>(host1x)),
       vic_processor(std::make_unique<Host1x::Vic>(host1x, nvdec_processor)),
-      host1x_processor(std::make_unique<Host1x::Control>(host1x)),
-      sync_manager(std::make_unique<Host1x::SyncptIncrManager>(host1x)) {}
+      host1x_processor(std::make_unique<Host1x::Control>(host1x)) {}
 
 CDmaPusher::~CDmaPusher() = default;
 
@@ -79,8 +79,11 @@ void CDmaPusher::ExecuteCommand(u32 state_offset, u32 data) {
             if (cond == 0) {
                 sync_manager->Increment(syncpoint_id);
             } else {
-                sync_manager->SignalDone(
-                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id));
+                // With frame threading, the increment waits for the decoder to output the frame.
+                const auto handle =
+                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id);
+                nvdec_processor->QueueAfterDecode(
+                    syncpoint_id, [this, handle] { sync_manager->SignalDone(handle); });
             }
             break;
         }
@@ -103,8 +106,11 @@ void CDmaPusher::ExecuteCommand(u32 state_offset, u32 data) {
             if (cond == 0) {
                 sync_manager->Increment(syncpoint_id);
             } else {
-                sync_manager->SignalDone(
-                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id));
+                // VIC writes frames out in the background, so the increment waits for it to finish.
+                const auto handle =
+                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id);
+                vic_processor->QueueAfterWrites(
+                    [this, handle] { sync_manager->SignalDone(handle); });
             }
             break;
         }
@@ -103,10 +103,11 @@ private:
     void ThiStateWrite(ThiRegisters& state, u32 offset, u32 argument);
 
     Host1x::Host1x& host1x;
+    /// Outlives vic_processor, which may still be signalling increments when it is destroyed
+    std::unique_ptr<Host1x::SyncptIncrManager> sync_manager;
     std::shared_ptr<Tegra::Host1x::Nvdec> nvdec_processor;
     std::unique_ptr<Tegra::Host1x::Vic> vic_processor;
     std::unique_ptr<Tegra::Host1x::Control> host1x_processor;
-    std::unique_ptr<Host1x::SyncptIncrManager> sync_manager;
     ChClassId current_class{};
     ThiRegisters vic_thi_state{};
     ThiRegisters nvdec_thi_state{};
@@ -1,7 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/settings.h"
 #include "video_core/host1x/codecs/codec.h"
 #include "video_core/host1x/codecs/h264.h"
@@ -12,12 +15,51 @@
 
 namespace Tegra {
 
+namespace {
+// Submissions the decoder hasn't output a frame for after this many more are taken as decoded,
+// as hidden and corrupt frames are never output.
+constexpr size_t MaxPendingSubmissions = 32;
+
+std::string_view GetCodecName(Host1x::NvdecCommon::VideoCodec codec) {
+    switch (codec) {
+    case Host1x::NvdecCommon::VideoCodec::None:
+        return "None";
+    case Host1x::NvdecCommon::VideoCodec::H264:
+        return "H264";
+    case Host1x::NvdecCommon::VideoCodec::VP8:
+        return "VP8";
+    case Host1x::NvdecCommon::VideoCodec::H265:
+        return "H265";
+    case Host1x::NvdecCommon::VideoCodec::VP9:
+        return "VP9";
+    default:
+        return "Unknown";
+    }
+}
+
+u64 ToMicroseconds(std::chrono::steady_clock::duration duration) {
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+} // Anonymous namespace
+
 Codec::Codec(Host1x::Host1x& host1x_, const Host1x::NvdecCommon::NvdecRegisters& regs)
     : host1x(host1x_), state{regs}, h264_decoder(std::make_unique<Decoder::H264>(host1x)),
       vp8_decoder(std::make_unique<Decoder::VP8>(host1x)),
       vp9_decoder(std::make_unique<Decoder::VP9>(host1x)) {}
 
-Codec::~Codec() = default;
+Codec::~Codec() {
+    for (const auto& [codec, codec_statistics] : statistics) {
+        const u64 submit_count = std::max<u64>(codec_statistics.submit_count, 1);
+        LOG_DEBUG(HW_GPU,
+                  "{}: {} frames submitted, {} received, decode time avg {} us max {} us, "
+                  "latency avg {} us max {} us",
+                  GetCodecName(codec), codec_statistics.submit_count, codec_statistics.frame_count,
+                  codec_statistics.total_decode_time / submit_count,
+                  codec_statistics.max_decode_time, codec_statistics.total_latency / submit_count,
+                  codec_statistics.max_latency);
+    }
+}
 
 void Codec::Initialize() {
     initialized = decode_api.Initialize(current_codec);
@@ -25,6 +67,10 @@ void Codec::Initialize() {
 
 void Codec::SetTargetCodec(Host1x::NvdecCommon::VideoCodec codec) {
     if (current_codec != codec) {
+        // A new stream starts with the new codec, so finish the old one and have the next frame
+        // initialize the decoder again.
+        Flush();
+        initialized = false;
         current_codec = codec;
         LOG_INFO(Service_NVDRV, "NVDEC video codec initialized to {}", GetCurrentCodecName());
     }
@@ -59,18 +105,43 @@ void Codec::Decode() {
         }
     }();
 
-    // Send assembled bitstream to decoder.
-    if (!decode_api.SendPacket(packet_data, configuration_size)) {
-        return;
-    }
+    // Send assembled bitstream to decoder, tagged with its submission index. The decoder passes
+    // the index on to the decoded frame, which tells which submissions have been decoded.
+    const auto submit_time = Clock::now();
+    const size_t previous_frame_count = frames.size();
+    const u64 submission = submitted_count++;
+    pending_submissions.emplace_back(submission, submit_time);
 
     // Only receive/store visible frames.
-    if (vp9_hidden_frame) {
+    if (decode_api.SendPacket(packet_data, configuration_size, static_cast<s64>(submission)) &&
+        !vp9_hidden_frame) {
+        // Receive output frames from decoder.
+        decode_api.ReceiveFrames(frames);
+    }
+
+    UpdateDecodedCount(previous_frame_count);
+
+    while (frames.size() > 10) {
+        LOG_DEBUG(HW_GPU, "ReceiveFrames overflow, dropped frame");
+        frames.pop();
+    }
+
+    auto& codec_statistics = statistics[current_codec];
+    const u64 decode_time = ToMicroseconds(Clock::now() - submit_time);
+    codec_statistics.submit_count++;
+    codec_statistics.total_decode_time += decode_time;
+    codec_statistics.max_decode_time = std::max(codec_statistics.max_decode_time, decode_time);
+}
+
+void Codec::Flush() {
+    if (!initialized) {
         return;
     }
 
-    // Receive output frames from decoder.
-    decode_api.ReceiveFrames(frames);
+    const size_t previous_frame_count = frames.size();
+    decode_api.Flush(frames);
+    decoded_count = submitted_count;
+    UpdateDecodedCount(previous_frame_count);
 
     while (frames.size() > 10) {
         LOG_DEBUG(HW_GPU, "ReceiveFrames overflow, dropped frame");
@@ -78,7 +149,35 @@ void Codec::Decode() {
     }
 }
 
-std::unique_ptr<FFmpeg::Frame> Codec::GetCurrentFrame() {
+void Codec::UpdateDecodedCount(size_t previous_frame_count) {
+    if (!decode_api.IsFrameThreaded()) {
+        // Without frame threading, every frame is decoded by the time its packet has been sent.
+        decoded_count = submitted_count;
+    } else if (frames.size() > previous_frame_count) {
+        // Frames are output in submission order, so every submission up to that of the last frame
+        // received has been decoded.
+        const s64 last_submission = frames.back()->GetPts();
+        if (last_submission >= 0) {
+            decoded_count = std::max(decoded_count, static_cast<u64>(last_submission) + 1);
+        }
+    }
+    if (pending_submissions.size() > MaxPendingSubmissions) {
+        decoded_count = std::max(decoded_count, pending_submissions.front().first + 1);
+    }
+
+    auto& codec_statistics = statistics[current_codec];
+    codec_statistics.frame_count += frames.size() - std::min(frames.size(), previous_frame_count);
+
+    const auto now = Clock::now();
+    while (!pending_submissions.empty() && pending_submissions.front().first < decoded_count) {
+        const u64 latency = ToMicroseconds(now - pending_submissions.front().second);
+        codec_statistics.total_latency += latency;
+        codec_statistics.max_latency = std::max(codec_statistics.max_latency, latency);
+        pending_submissions.pop_front();
+    }
+}
+
+std::shared_ptr<FFmpeg::Frame> Codec::GetCurrentFrame() {
     // Sometimes VIC will request more frames than have been decoded.
     // in this case, return a blank frame and don't overwrite previous data.
     if (frames.empty()) {
@@ -95,19 +194,6 @@ Host1x::NvdecCommon::VideoCodec Codec::GetCurrentCodec() const {
 }
 
 std::string_view Codec::GetCurrentCodecName() const {
-    switch (current_codec) {
-    case Host1x::NvdecCommon::VideoCodec::None:
-        return "None";
-    case Host1x::NvdecCommon::VideoCodec::H264:
-        return "H264";
-    case Host1x::NvdecCommon::VideoCodec::VP8:
-        return "VP8";
-    case Host1x::NvdecCommon::VideoCodec::H265:
-        return "H265";
-    case Host1x::NvdecCommon::VideoCodec::VP9:
-        return "VP9";
-    default:
-        return "Unknown";
-    }
+    return GetCodecName(current_codec);
 }
 } // namespace Tegra
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string_view>
@@ -23,6 +26,21 @@ namespace Host1x {
 class Host1x;
 } // namespace Host1x
 
+struct DecodeStatistics {
+    /// Number of frames submitted to the decoder
+    u64 submit_count;
+    /// Total time taken to submit the frames and receive the decoded output, in microseconds
+    u64 total_decode_time;
+    /// Longest time taken to submit a frame and receive the decoded output, in microseconds
+    u64 max_decode_time;
+    /// Number of frames received from the decoder
+    u64 frame_count;
+    /// Total time from submitting the frames to receiving them, in microseconds
+    u64 total_latency;
+    /// Longest time from submitting a frame to receiving it, in microseconds
+    u64 max_latency;
+};
+
 class Codec {
 public:
     explicit Codec(Host1x::Host1x& host1x, const Host1x::NvdecCommon::NvdecRegisters& regs);
@@ -37,8 +55,12 @@ public:
     /// Call decoders to construct headers, decode AVFrame with ffmpeg
     void Decode();
 
+    /// Receives the frames the decoder is holding back at the end of a stream, after which every
+    /// submitted frame is decoded. The decoder is then ready for a new stream.
+    void Flush();
+
     /// Returns next decoded frame
-    [[nodiscard]] std::unique_ptr<FFmpeg::Frame> GetCurrentFrame();
+    [[nodiscard]] std::shared_ptr<FFmpeg::Frame> GetCurrentFrame();
 
     /// Returns the value of current_codec
     [[nodiscard]] Host1x::NvdecCommon::VideoCodec GetCurrentCodec() const;
@@ -46,7 +68,23 @@ public:
     /// Return name of the current codec
     [[nodiscard]] std::string_view GetCurrentCodecName() const;
 
+    /// Returns the number of frames submitted to the decoder
+    [[nodiscard]] u64 GetSubmittedCount() const {
+        return submitted_count;
+    }
+
+    /// Returns the number of submitted frames known to have been decoded. With frame threading,
+    /// this lags behind the number submitted until the decoder outputs their frames.
+    [[nodiscard]] u64 GetDecodedCount() const {
+        return decoded_count;
+    }
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Marks the submissions up to the last frame received as decoded
+    void UpdateDecodedCount(size_t previous_frame_count);
+
     bool initialized{};
     Host1x::NvdecCommon::VideoCodec current_codec{Host1x::NvdecCommon::VideoCodec::None};
     FFmpeg::DecodeApi decode_api;
@@ -57,7 +95,13 @@ private:
     std::unique_ptr<Decoder::VP8> vp8_decoder;
     std::unique_ptr<Decoder::VP9> vp9_decoder;
 
-    std::queue<std::unique_ptr<FFmpeg::Frame>> frames{};
+    std::queue<std::shared_ptr<FFmpeg::Frame>> frames{};
+
+    u64 submitted_count{};
+    u64 decoded_count{};
+    // Submission times of the frames still being decoded, by submission index.
+    std::deque<std::pair<u64, Clock::time_point>> pending_submissions;
+    std::map<Host1x::NvdecCommon::VideoCodec, DecodeStatistics> statistics;
 };
 
 } // namespace Tegra
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
@@ -20,6 +22,8 @@ namespace {
 
 constexpr AVPixelFormat PreferredGpuFormat = AV_PIX_FMT_NV12;
 constexpr AVPixelFormat PreferredCpuFormat = AV_PIX_FMT_YUV420P;
+// Enough for the frames queued by the codec and the frame VIC is writing out.
+constexpr size_t MaxPooledFrames = 16;
 constexpr std::array PreferredGpuDecoders = {
     AV_HWDEVICE_TYPE_CUDA,
 #ifdef _WIN32
@@ -55,10 +59,11 @@ std::string AVError(int errnum) {
 
 } // namespace
 
-Packet::Packet(std::span<const u8> data) {
+Packet::Packet(std::span<const u8> data, s64 pts) {
     m_packet = av_packet_alloc();
     m_packet->data = const_cast<u8*>(data.data());
     m_packet->size = static_cast<s32>(data.size());
+    m_packet->pts = pts;
 }
 
 Packet::~Packet() {
@@ -73,6 +78,79 @@ Frame::~Frame() {
     av_frame_free(&m_frame);
 }
 
+std::shared_ptr<Frame> FramePool::Acquire() {
+    std::unique_ptr<Frame> frame;
+    {
+        std::scoped_lock lock{m_mutex};
+        if (!m_free_frames.empty()) {
+            frame = std::move(m_free_frames.back());
+            m_free_frames.pop_back();
+        }
+    }
+    if (!frame) {
+        frame = std::make_unique<Frame>();
+    }
+    return Wrap(std::move(frame), false);
+}
+
+std::shared_ptr<Frame> FramePool::AcquireForTransfer(int width, int height, AVPixelFormat format) {
+    std::unique_ptr<Frame> frame;
+    {
+        std::scoped_lock lock{m_mutex};
+        const auto it = std::ranges::find_if(m_transfer_frames, [&](const auto& transfer_frame) {
+            return transfer_frame->GetWidth() == width && transfer_frame->GetHeight() == height &&
+                   transfer_frame->GetPixelFormat() == format;
+        });
+        if (it != m_transfer_frames.end()) {
+            frame = std::move(*it);
+            m_transfer_frames.erase(it);
+        } else if (!m_transfer_frames.empty()) {
+            // The stream changed size, so frames of the old size won't be reused.
+            frame = std::move(m_transfer_frames.front());
+            m_transfer_frames.erase(m_transfer_frames.begin());
+        } else if (!m_free_frames.empty()) {
+            frame = std::move(m_free_frames.back());
+            m_free_frames.pop_back();
+        }
+    }
+    if (!frame) {
+        frame = std::make_unique<Frame>();
+    }
+    if (frame->GetWidth() != width || frame->GetHeight() != height ||
+        frame->GetPixelFormat() != format) {
+        av_frame_unref(frame->GetFrame());
+        frame->SetFormat(format);
+    }
+    return Wrap(std::move(frame), true);
+}
+
+std::shared_ptr<Frame> FramePool::Wrap(std::unique_ptr<Frame> frame, bool keep_buffers) {
+    // Frames are released on the VIC threads, and may outlive the decoder and its pool.
+    return std::shared_ptr<Frame>(
+        frame.release(), [weak_pool = weak_from_this(), keep_buffers](Frame* released_frame) {
+            std::unique_ptr<Frame> owned_frame{released_frame};
+            if (const auto pool = weak_pool.lock()) {
+                pool->Release(std::move(owned_frame), keep_buffers);
+            }
+        });
+}
+
+void FramePool::Release(std::unique_ptr<Frame> frame, bool keep_buffers) {
+    // Buffers still referenced elsewhere, such as by the deinterlacer, can't be written to again.
+    // Decoded frames are unreferenced straight away, so the decoder can reuse their buffers.
+    const bool keep = keep_buffers && frame->GetFrame()->buf[0] &&
+                      av_frame_is_writable(frame->GetFrame()) != 0;
+    if (!keep) {
+        av_frame_unref(frame->GetFrame());
+    }
+
+    std::scoped_lock lock{m_mutex};
+    auto& frames = keep ? m_transfer_frames : m_free_frames;
+    if (frames.size() < MaxPooledFrames) {
+        frames.push_back(std::move(frame));
+    }
+}
+
 Decoder::Decoder(Tegra::Host1x::NvdecCommon::VideoCodec codec) {
     const AVCodecID av_codec = [&] {
         switch (codec) {
@@ -190,6 +268,10 @@ DecoderContext::DecoderContext(const Decoder& decoder) {
     m_codec_context->thread_type &= ~FF_THREAD_FRAME;
 }
 
+void DecoderContext::EnableFrameThreading() {
+    m_codec_context->thread_type |= FF_THREAD_FRAME;
+}
+
 DecoderContext::~DecoderContext() {
     av_buffer_unref(&m_codec_context->hw_device_ctx);
     avcodec_free_context(&m_codec_context);
@@ -224,11 +306,29 @@ bool DecoderContext::SendPacket(const Packet& packet) {
     return true;
 }
 
-std::unique_ptr<Frame> DecoderContext::ReceiveFrame(bool* out_is_interlaced) {
-    auto dst_frame = std::make_unique<Frame>();
+bool DecoderContext::SendEndOfStream() {
+    // An empty packet puts the decoder in draining mode, in which it outputs every frame it holds.
+    if (const int ret = avcodec_send_packet(m_codec_context, nullptr); ret < 0) {
+        LOG_ERROR(HW_GPU, "avcodec_send_packet error: {}", AVError(ret));
+        return false;
+    }
+
+    return true;
+}
 
+void DecoderContext::FlushBuffers() {
+    avcodec_flush_buffers(m_codec_context);
+}
+
+std::shared_ptr<Frame> DecoderContext::ReceiveFrame(FramePool& frame_pool,
+                                                    bool* out_is_interlaced) {
     const auto ReceiveImpl = [&](AVFrame* frame) {
-        if (const int ret = avcodec_receive_frame(m_codec_context, frame); ret < 0) {
+        const int ret = avcodec_receive_frame(m_codec_context, frame);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR(AVERROR_EOF)) {
+            return false;
+        }
+
+        if (ret < 0) {
             LOG_ERROR(HW_GPU, "avcodec_receive_frame error: {}", AVError(ret));
             return false;
         }
@@ -243,28 +343,29 @@ std::unique_ptr<Frame> DecoderContext::ReceiveFrame(bool* out_is_interlaced) {
     };
 
     if (m_codec_context->hw_device_ctx) {
-        // If we have a hardware context, make a separate frame here to receive the
-        // hardware result before sending it to the output.
-        Frame intermediate_frame;
-
-        if (!ReceiveImpl(intermediate_frame.GetFrame())) {
+        // If we have a hardware context, receive the hardware result in a separate frame before
+        // transferring it to the output, reusing the buffers of an earlier output frame.
+        if (!ReceiveImpl(m_hardware_frame.GetFrame())) {
             return {};
         }
 
-        dst_frame->SetFormat(PreferredGpuFormat);
-        if (const int ret =
-                av_hwframe_transfer_data(dst_frame->GetFrame(), intermediate_frame.GetFrame(), 0);
-            ret < 0) {
+        auto dst_frame = frame_pool.AcquireForTransfer(
+            m_hardware_frame.GetWidth(), m_hardware_frame.GetHeight(), PreferredGpuFormat);
+        const int ret =
+            av_hwframe_transfer_data(dst_frame->GetFrame(), m_hardware_frame.GetFrame(), 0);
+        av_frame_unref(m_hardware_frame.GetFrame());
+        if (ret < 0) {
             LOG_ERROR(HW_GPU, "av_hwframe_transfer_data error: {}", AVError(ret));
             return {};
         }
-    } else {
-        // Otherwise, decode the frame as normal.
-        if (!ReceiveImpl(dst_frame->GetFrame())) {
-            return {};
-        }
+        return dst_frame;
     }
 
+    // Otherwise, decode the frame as normal.
+    auto dst_frame = frame_pool.Acquire();
+    if (!ReceiveImpl(dst_frame->GetFrame())) {
+        return {};
+    }
     return dst_frame;
 }
 
@@ -335,8 +436,8 @@ bool DeinterlaceFilter::AddSourceFrame(const Frame& frame) {
     return true;
 }
 
-std::unique_ptr<Frame> DeinterlaceFilter::DrainSinkFrame() {
-    auto dst_frame = std::make_unique<Frame>();
+std::shared_ptr<Frame> DeinterlaceFilter::DrainSinkFrame(FramePool& frame_pool) {
+    auto dst_frame = frame_pool.Acquire();
     const int ret = av_buffersink_get_frame(m_sink_context, dst_frame->GetFrame());
 
     if (ret == AVERROR(EAGAIN) || ret == AVERROR(AVERROR_EOF)) {
@@ -373,32 +474,47 @@ bool DecodeApi::Initialize(Tegra::Host1x::NvdecCommon::VideoCodec codec) {
         m_hardware_context->InitializeForDecoder(*m_decoder_context, *m_decoder);
     }
 
+    // Decode frames concurrently if requested. Hardware decoders already decode asynchronously.
+    if (Settings::values.nvdec_frame_threading.GetValue() &&
+        !m_decoder_context->GetCodecContext()->hw_device_ctx) {
+        m_decoder_context->EnableFrameThreading();
+    }
+
     // Open the decoder context.
     if (!m_decoder_context->OpenContext(*m_decoder)) {
         this->Reset();
         return false;
     }
 
+    if (m_decoder_context->IsFrameThreaded()) {
+        LOG_INFO(HW_GPU, "Using FFmpeg frame threading with {} threads",
+                 m_decoder_context->GetCodecContext()->thread_count);
+    }
+
     return true;
 }
 
-bool DecodeApi::SendPacket(std::span<const u8> packet_data, size_t configuration_size) {
-    FFmpeg::Packet packet(packet_data);
+bool DecodeApi::SendPacket(std::span<const u8> packet_data, size_t configuration_size, s64 pts) {
+    FFmpeg::Packet packet(packet_data, pts);
     return m_decoder_context->SendPacket(packet);
 }
 
-void DecodeApi::ReceiveFrames(std::queue<std::unique_ptr<Frame>>& frame_queue) {
-    // Receive raw frame from decoder.
-    bool is_interlaced;
-    auto frame = m_decoder_context->ReceiveFrame(&is_interlaced);
-    if (!frame) {
-        return;
-    }
+void DecodeApi::ReceiveFrames(std::queue<std::shared_ptr<Frame>>& frame_queue) {
+    // Receive every raw frame the decoder has finished. Without frame threading, this is at most
+    // the frame of the last packet sent.
+    while (true) {
+        bool is_interlaced;
+        auto frame = m_decoder_context->ReceiveFrame(*m_frame_pool, &is_interlaced);
+        if (!frame) {
+            return;
+        }
+
+        if (!is_interlaced) {
+            // If the frame is not interlaced, we can pend it now.
+            frame_queue.push(std::move(frame));
+            continue;
+        }
 
-    if (!is_interlaced) {
-        // If the frame is not interlaced, we can pend it now.
-        frame_queue.push(std::move(frame));
-    } else {
         // Create the deinterlacer if needed.
         if (!m_deinterlace_filter) {
             m_deinterlace_filter.emplace(*frame);
@@ -411,7 +527,7 @@ void DecodeApi::ReceiveFrames(std::queue<std::unique_ptr<Frame>>& frame_queue) {
 
         // Pend output fields.
         while (true) {
-            auto filter_frame = m_deinterlace_filter->DrainSinkFrame();
+            auto filter_frame = m_deinterlace_filter->DrainSinkFrame(*m_frame_pool);
             if (!filter_frame) {
                 break;
             }
@@ -421,4 +537,17 @@ void DecodeApi::ReceiveFrames(std::queue<std::unique_ptr<Frame>>& frame_queue) {
     }
 }
 
+void DecodeApi::Flush(std::queue<std::shared_ptr<Frame>>& frame_queue) {
+    if (!m_decoder_context) {
+        return;
+    }
+
+    // Drain the decoder of the frames it's holding back, then leave draining mode so that it
+    // accepts packets of a new stream.
+    if (m_decoder_context->SendEndOfStream()) {
+        ReceiveFrames(frame_queue);
+    }
+    m_decoder_context->FlushBuffers();
+}
+
 } // namespace FFmpeg
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <vector>
@@ -35,6 +36,7 @@ namespace FFmpeg {
 
 class Packet;
 class Frame;
+class FramePool;
 class Decoder;
 class HardwareContext;
 class DecoderContext;
@@ -46,7 +48,7 @@ public:
     YUZU_NON_COPYABLE(Packet);
     YUZU_NON_MOVEABLE(Packet);
 
-    explicit Packet(std::span<const u8> data);
+    explicit Packet(std::span<const u8> data, s64 pts);
     ~Packet();
 
     AVPacket* GetPacket() const {
@@ -98,6 +100,10 @@ public:
         m_frame->format = format;
     }
 
+    s64 GetPts() const {
+        return m_frame->pts;
+    }
+
     AVFrame* GetFrame() const {
         return m_frame;
     }
@@ -106,6 +112,32 @@ private:
     AVFrame* m_frame{};
 };
 
+// Recycles frames once they are released by their last user, rather than allocating new ones for
+// every decoded frame.
+class FramePool : public std::enable_shared_from_this<FramePool> {
+public:
+    YUZU_NON_COPYABLE(FramePool);
+    YUZU_NON_MOVEABLE(FramePool);
+
+    FramePool() = default;
+    ~FramePool() = default;
+
+    // Returns a frame holding no data.
+    std::shared_ptr<Frame> Acquire();
+
+    // Returns a frame to transfer a hardware frame into, keeping the buffers of a frame transferred
+    // previously if their size and format match.
+    std::shared_ptr<Frame> AcquireForTransfer(int width, int height, AVPixelFormat format);
+
+private:
+    std::shared_ptr<Frame> Wrap(std::unique_ptr<Frame> frame, bool keep_buffers);
+    void Release(std::unique_ptr<Frame> frame, bool keep_buffers);
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Frame>> m_free_frames;
+    std::vector<std::unique_ptr<Frame>> m_transfer_frames;
+};
+
 // Wraps an AVCodec, a type containing information about a codec.
 class Decoder {
 public:
@@ -158,16 +190,27 @@ public:
     ~DecoderContext();
 
     void InitializeHardwareDecoder(const HardwareContext& context, AVPixelFormat hw_pix_fmt);
+    void EnableFrameThreading();
     bool OpenContext(const Decoder& decoder);
     bool SendPacket(const Packet& packet);
-    std::unique_ptr<Frame> ReceiveFrame(bool* out_is_interlaced);
+    bool SendEndOfStream();
+    std::shared_ptr<Frame> ReceiveFrame(FramePool& frame_pool, bool* out_is_interlaced);
+    void FlushBuffers();
 
     AVCodecContext* GetCodecContext() const {
         return m_codec_context;
     }
 
+    // Whether frames are decoded concurrently, each on its own thread. The decoder then holds
+    // back its output until it has been sent a packet for every thread.
+    bool IsFrameThreaded() const {
+        return (m_codec_context->active_thread_type & FF_THREAD_FRAME) != 0;
+    }
+
 private:
     AVCodecContext* m_codec_context{};
+    // Receives hardware frames before they are transferred to the host.
+    Frame m_hardware_frame;
 };
 
 // Wraps an AVFilterGraph.
@@ -180,7 +223,7 @@ public:
     ~DeinterlaceFilter();
 
     bool AddSourceFrame(const Frame& frame);
-    std::unique_ptr<Frame> DrainSinkFrame();
+    std::shared_ptr<Frame> DrainSinkFrame(FramePool& frame_pool);
 
 private:
     AVFilterGraph* m_filter_graph{};
@@ -200,10 +243,16 @@ public:
     bool Initialize(Tegra::Host1x::NvdecCommon::VideoCodec codec);
     void Reset();
 
-    bool SendPacket(std::span<const u8> packet_data, size_t configuration_size);
-    void ReceiveFrames(std::queue<std::unique_ptr<Frame>>& frame_queue);
+    bool SendPacket(std::span<const u8> packet_data, size_t configuration_size, s64 pts);
+    void ReceiveFrames(std::queue<std::shared_ptr<Frame>>& frame_queue);
+    void Flush(std::queue<std::shared_ptr<Frame>>& frame_queue);
+
+    bool IsFrameThreaded() const {
+        return m_decoder_context && m_decoder_context->IsFrameThreaded();
+    }
 
 private:
+    std::shared_ptr<FramePool> m_frame_pool{std::make_shared<FramePool>()};
     std::optional<FFmpeg::Decoder> m_decoder;
     std::optional<FFmpeg::DecoderContext> m_decoder_context;
     std::optional<FFmpeg::HardwareContext> m_hardware_context;
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "common/assert.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/host1x/nvdec.h"
@@ -13,7 +15,16 @@ namespace Tegra::Host1x {
 Nvdec::Nvdec(Host1x& host1x_)
     : host1x(host1x_), state{}, codec(std::make_unique<Codec>(host1x, state)) {}
 
-Nvdec::~Nvdec() = default;
+Nvdec::~Nvdec() {
+    auto& syncpoint_manager = host1x.GetSyncpointManager();
+    for (const auto& [syncpoint_id, handle] : deferrals) {
+        syncpoint_manager.DeregisterHostDeferral(syncpoint_id, handle);
+    }
+
+    // The stream ends with the channel, so have the decoder output the frames it's holding back.
+    codec->Flush();
+    RunDecoded();
+}
 
 void Nvdec::ProcessMethod(u32 method, u32 argument) {
     state.reg_array[method] = static_cast<u64>(argument) << 8;
@@ -28,16 +39,52 @@ void Nvdec::ProcessMethod(u32 method, u32 argument) {
     }
 }
 
-std::unique_ptr<FFmpeg::Frame> Nvdec::GetFrame() {
+std::shared_ptr<FFmpeg::Frame> Nvdec::GetFrame() {
     return codec->GetCurrentFrame();
 }
 
+void Nvdec::QueueAfterDecode(u32 syncpoint_id, Common::UniqueFunction<void> func) {
+    if (codec->GetDecodedCount() >= codec->GetSubmittedCount()) {
+        func();
+        return;
+    }
+
+    // Waiting on the syncpoint releases the deferred functions early. The decoder only outputs a
+    // frame once it has been sent packets for all of its threads, which a guest waiting on each
+    // decode would otherwise never send.
+    const auto is_registered = [syncpoint_id](const auto& deferral) {
+        return deferral.first == syncpoint_id;
+    };
+    if (std::ranges::none_of(deferrals, is_registered)) {
+        const auto handle = host1x.GetSyncpointManager().RegisterHostDeferral(
+            syncpoint_id, [this, syncpoint_id] { ReleasePending(syncpoint_id); });
+        deferrals.emplace_back(syncpoint_id, handle);
+    }
+
+    {
+        std::scoped_lock lk{pending_lock};
+        pending_decodes.push_back({
+            .decoded_count = codec->GetSubmittedCount(),
+            .syncpoint_id = syncpoint_id,
+            .func = std::move(func),
+        });
+    }
+
+    // Something which started waiting before the decode was queued has already run the releases,
+    // and would never be woken. A waiter starting later either sees the decode when it releases,
+    // or is seen here.
+    if (host1x.GetSyncpointManager().HasHostWaiters(syncpoint_id)) {
+        ReleasePending(syncpoint_id);
+    }
+}
+
 void Nvdec::Execute() {
     switch (codec->GetCurrentCodec()) {
     case NvdecCommon::VideoCodec::H264:
     case NvdecCommon::VideoCodec::VP8:
     case NvdecCommon::VideoCodec::VP9:
         codec->Decode();
+        RunDecoded();
         break;
     default:
         UNIMPLEMENTED_MSG("Codec {}", codec->GetCurrentCodecName());
@@ -45,4 +92,36 @@ void Nvdec::Execute() {
     }
 }
 
+void Nvdec::RunDecoded() {
+    std::deque<PendingDecode> decoded;
+    {
+        std::scoped_lock lk{pending_lock};
+        const u64 decoded_count = codec->GetDecodedCount();
+        while (!pending_decodes.empty() && pending_decodes.front().decoded_count <= decoded_count) {
+            decoded.push_back(std::move(pending_decodes.front()));
+            pending_decodes.pop_front();
+        }
+    }
+    for (auto& pending : decoded) {
+        pending.func();
+    }
+}
+
+void Nvdec::ReleasePending(u32 syncpoint_id) {
+    std::deque<PendingDecode> released;
+    {
+        std::scoped_lock lk{pending_lock};
+        const auto last = std::find_if(pending_decodes.rbegin(), pending_decodes.rend(),
+                                       [syncpoint_id](const PendingDecode& pending) {
+                                           return pending.syncpoint_id == syncpoint_id;
+                                       });
+        const auto end = last.base();
+        std::move(pending_decodes.begin(), end, std::back_inserter(released));
+        pending_decodes.erase(pending_decodes.begin(), end);
+    }
+    for (auto& pending : released) {
+        pending.func();
+    }
+}
+
 } // namespace Tegra::Host1x
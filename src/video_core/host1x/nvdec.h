@@ -3,10 +3,15 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 #include "common/common_types.h"
+#include "common/unique_function.h"
 #include "video_core/host1x/codecs/codec.h"
+#include "video_core/host1x/syncpoint_manager.h"
 
 namespace Tegra {
 
@@ -23,15 +28,35 @@ public:
     void ProcessMethod(u32 method, u32 argument);
 
     /// Return most recently decoded frame
-    [[nodiscard]] std::unique_ptr<FFmpeg::Frame> GetFrame();
+    [[nodiscard]] std::shared_ptr<FFmpeg::Frame> GetFrame();
+
+    /// Run func once the frames executed so far have been decoded. With frame threading, this is
+    /// once the decoder outputs them, or as soon as something waits on syncpoint_id.
+    void QueueAfterDecode(u32 syncpoint_id, Common::UniqueFunction<void> func);
 
 private:
+    struct PendingDecode {
+        u64 decoded_count;
+        u32 syncpoint_id;
+        Common::UniqueFunction<void> func;
+    };
+
     /// Invoke codec to decode a frame
     void Execute();
 
+    /// Run the functions of the pending decodes which have been decoded.
+    void RunDecoded();
+
+    /// Run the functions of the pending decodes up to the last one for syncpoint_id.
+    void ReleasePending(u32 syncpoint_id);
+
     Host1x& host1x;
     NvdecCommon::NvdecRegisters state;
     std::unique_ptr<Codec> codec;
+
+    std::mutex pending_lock;
+    std::deque<PendingDecode> pending_decodes;
+    std::vector<std::pair<u32, SyncpointManager::DeferralHandle>> deferrals;
 };
 
 } // namespace Host1x
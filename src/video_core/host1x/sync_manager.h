@@ -37,10 +37,10 @@ public:
     /// IncrememntAllDone, including handle
     void SignalDone(u32 handle);
 
+private:
     /// Increment all sequential pending increments that are already done.
     void IncrementAllDone();
 
-private:
     std::vector<SyncptIncr> increments;
     std::mutex increment_lock;
     u32 current_id{};
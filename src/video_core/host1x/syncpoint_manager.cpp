@@ -57,6 +57,33 @@ void SyncpointManager::DeregisterHostAction(u32 syncpoint_id, const ActionHandle
     DeregisterAction(host_action_storage[syncpoint_id], handle);
 }
 
+SyncpointManager::DeferralHandle SyncpointManager::RegisterHostDeferral(
+    u32 syncpoint_id, std::function<void()>&& release) {
+    std::unique_lock lk(deferral_guard);
+    auto& deferral_storage = host_deferral_storage[syncpoint_id];
+    return deferral_storage.emplace(deferral_storage.end(), std::move(release));
+}
+
+void SyncpointManager::DeregisterHostDeferral(u32 syncpoint_id, const DeferralHandle& handle) {
+    std::unique_lock lk(deferral_guard);
+    auto& deferral_storage = host_deferral_storage[syncpoint_id];
+    for (auto it = deferral_storage.begin(); it != deferral_storage.end(); it++) {
+        if (it == handle) {
+            deferral_storage.erase(it);
+            return;
+        }
+    }
+}
+
+void SyncpointManager::ReleaseHostDeferrals(u32 syncpoint_id) {
+    // The releases run with deferral_guard held, so that a device can't be deregistered and
+    // destroyed while its callback is running. They increment the syncpoint, taking guard.
+    std::unique_lock lk(deferral_guard);
+    for (auto& release : host_deferral_storage[syncpoint_id]) {
+        release();
+    }
+}
+
 void SyncpointManager::IncrementGuest(u32 syncpoint_id) {
     Increment(syncpoints_guest[syncpoint_id], wait_guest_cv, guest_action_storage[syncpoint_id]);
 }
@@ -71,7 +98,25 @@ void SyncpointManager::WaitGuest(u32 syncpoint_id, u32 expected_value) {
 
 void SyncpointManager::WaitHost(u32 syncpoint_id, u32 expected_value) {
     MICROPROFILE_SCOPE(GPU_wait);
+    if (IsReadyHost(syncpoint_id, expected_value)) {
+        return;
+    }
+
+    // The waiter is counted before releasing the deferrals, so that a device deferring an
+    // increment afterwards sees it through HasHostWaiters.
+    host_waiters[syncpoint_id].fetch_add(1);
+    ReleaseHostDeferrals(syncpoint_id);
     Wait(syncpoints_host[syncpoint_id], wait_host_cv, expected_value);
+    host_waiters[syncpoint_id].fetch_sub(1);
+}
+
+bool SyncpointManager::HasHostWaiters(u32 syncpoint_id) {
+    if (host_waiters[syncpoint_id].load() > 0) {
+        return true;
+    }
+
+    std::unique_lock lk(guard);
+    return !host_action_storage[syncpoint_id].empty();
 }
 
 void SyncpointManager::Increment(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv,
@@ -42,10 +42,27 @@ public:
 
     template <typename Func>
     ActionHandle RegisterHostAction(u32 syncpoint_id, u32 expected_value, Func&& action) {
-        return RegisterAction(syncpoints_host[syncpoint_id], host_action_storage[syncpoint_id],
-                              expected_value, std::move(action));
+        // The action is registered before releasing the deferrals, so that a device deferring an
+        // increment afterwards sees it through HasHostWaiters.
+        const auto handle = RegisterAction(syncpoints_host[syncpoint_id],
+                                           host_action_storage[syncpoint_id], expected_value,
+                                           std::move(action));
+        if (!IsReadyHost(syncpoint_id, expected_value)) {
+            ReleaseHostDeferrals(syncpoint_id);
+        }
+        return handle;
     }
 
+    using DeferralHandle = std::list<std::function<void()>>::iterator;
+
+    /// Register a callback making the host increments of syncpoint_id a device is holding back.
+    /// It is called whenever something starts waiting on the host syncpoint before it reaches the
+    /// value waited for. Waiters which started earlier have already run the callbacks, so a device
+    /// must check HasHostWaiters after deferring an increment, and make it itself if there are.
+    DeferralHandle RegisterHostDeferral(u32 syncpoint_id, std::function<void()>&& release);
+
+    void DeregisterHostDeferral(u32 syncpoint_id, const DeferralHandle& handle);
+
     void DeregisterGuestAction(u32 syncpoint_id, const ActionHandle& handle);
 
     void DeregisterHostAction(u32 syncpoint_id, const ActionHandle& handle);
@@ -66,7 +83,12 @@ public:
         return syncpoints_host[syncpoint_id].load(std::memory_order_acquire) >= expected_value;
     }
 
+    /// Returns whether anything is waiting on, or has an action pending on, the host syncpoint.
+    bool HasHostWaiters(u32 syncpoint_id);
+
 private:
+    void ReleaseHostDeferrals(u32 syncpoint_id);
+
     void Increment(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv,
                    std::list<RegisteredAction>& action_storage);
 
@@ -86,7 +108,11 @@ private:
     std::array<std::list<RegisteredAction>, NUM_MAX_SYNCPOINTS> guest_action_storage;
     std::array<std::list<RegisteredAction>, NUM_MAX_SYNCPOINTS> host_action_storage;
 
+    std::array<std::list<std::function<void()>>, NUM_MAX_SYNCPOINTS> host_deferral_storage;
+    std::array<std::atomic<u32>, NUM_MAX_SYNCPOINTS> host_waiters{};
+
     std::mutex guard;
+    std::mutex deferral_guard;
     std::condition_variable wait_guest_cv;
     std::condition_variable wait_host_cv;
 };
@@ -1,24 +1,34 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <thread>
+
+#if defined(ARCHITECTURE_x86_64)
+#include <emmintrin.h>
+#endif
 
 extern "C" {
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
 #endif
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic pop
 #endif
 }
 
+#include "common/alignment.h"
 #include "common/assert.h"
 #include "common/bit_field.h"
+#include "common/div_ceil.h"
 #include "common/logging/log.h"
 
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/guest_memory.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/host1x/nvdec.h"
 #include "video_core/host1x/vic.h"
@@ -36,6 +46,50 @@ enum class VideoPixelFormat : u64_le {
     RGBX8 = 0x23,
     YUV420 = 0x44,
 };
+
+// Output surfaces are written in place when they are contiguous in host memory, and otherwise
+// through a scratch buffer.
+using OutputSurface =
+    Tegra::Memory::GpuGuestMemoryScoped<u8, Tegra::Memory::GuestMemoryFlags::SafeWrite>;
+
+constexpr u32 MaxSliceCount = 4;
+
+// Slices of a frame are aligned to macroblocks, which also keeps subsampled chroma lines whole.
+constexpr u32 SliceAlignment = 16;
+
+u32 GetSliceCount() {
+    return std::clamp(std::thread::hardware_concurrency() / 2, 1U, MaxSliceCount);
+}
+
+AVPixelFormat GetTargetFormat(VideoPixelFormat pixel_format) {
+    switch (pixel_format) {
+    case VideoPixelFormat::RGBA8:
+        return AV_PIX_FMT_RGBA;
+    case VideoPixelFormat::BGRA8:
+        return AV_PIX_FMT_BGRA;
+    case VideoPixelFormat::RGBX8:
+        return AV_PIX_FMT_RGB0;
+    default:
+        return AV_PIX_FMT_RGBA;
+    }
+}
+
+/// Interleave a line of separate U and V samples into the UV pairs of an NV12 chroma line.
+void InterleaveChroma(u8* dst, const u8* src_u, const u8* src_v, size_t width) {
+    size_t x = 0;
+#if defined(ARCHITECTURE_x86_64)
+    for (; x + 16 <= width; x += 16) {
+        const __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_u + x));
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_v + x));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2), _mm_unpacklo_epi8(u, v));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2 + 16), _mm_unpackhi_epi8(u, v));
+    }
+#endif
+    for (; x < width; ++x) {
+        dst[x * 2] = src_u[x];
+        dst[x * 2 + 1] = src_v[x];
+    }
+}
 } // Anonymous namespace
 
 union VicConfig {
@@ -51,9 +105,16 @@ union VicConfig {
 
 Vic::Vic(Host1x& host1x_, std::shared_ptr<Nvdec> nvdec_processor_)
     : host1x(host1x_),
-      nvdec_processor(std::move(nvdec_processor_)), converted_frame_buffer{nullptr, av_free} {}
+      nvdec_processor(std::move(nvdec_processor_)), converted_frame_buffer{nullptr, av_free},
+      slice_count{GetSliceCount()}, slice_workers{slice_count, "VicSlice"},
+      write_worker{1, "VicWriter"} {}
 
-Vic::~Vic() = default;
+Vic::~Vic() {
+    write_worker.WaitForRequests();
+    for (auto* const scaler_context : scaler_contexts) {
+        sws_freeContext(scaler_context);
+    }
+}
 
 void Vic::ProcessMethod(Method method, u32 argument) {
     LOG_DEBUG(HW_GPU, "Vic method 0x{:X}", static_cast<u32>(method));
@@ -76,6 +137,23 @@ void Vic::ProcessMethod(Method method, u32 argument) {
     }
 }
 
+void Vic::QueueAfterWrites(Common::UniqueFunction<void> func) {
+    write_worker.QueueWork(std::move(func));
+}
+
+template <typename Func>
+void Vic::ForEachSlice(u32 height, u32 alignment, Func&& func) {
+    const u32 slice_height = Common::AlignUp(Common::DivCeil(height, slice_count), alignment);
+    u32 slice = 0;
+    for (u32 line_begin = 0; line_begin < height; line_begin += slice_height, ++slice) {
+        const u32 line_end = std::min(line_begin + slice_height, height);
+        slice_workers.QueueWork([&func, slice, line_begin, line_end] {
+            func(slice, line_begin, line_end);
+        });
+    }
+    slice_workers.WaitForRequests();
+}
+
 void Vic::Execute() {
     if (output_surface_luma_address == 0) {
         LOG_ERROR(Service_NVDRV, "VIC Luma address not set.");
@@ -94,14 +172,25 @@ void Vic::Execute() {
         LOG_WARNING(Service_NVDRV, "Frame dimensions {}x{} don't match surface dimensions {}x{}",
                     frame->GetWidth(), frame->GetHeight(), surface_width, surface_height);
     }
+    // Frames are written out in the background while the next one is decoded. Only one frame is
+    // in flight at once, as they share the conversion buffers.
+    write_worker.WaitForRequests();
     switch (config.pixel_format) {
     case VideoPixelFormat::RGBA8:
     case VideoPixelFormat::BGRA8:
     case VideoPixelFormat::RGBX8:
-        WriteRGBFrame(std::move(frame), config);
+        write_worker.QueueWork(
+            [this, frame = std::move(frame), config,
+             luma_address = output_surface_luma_address]() mutable {
+                WriteRGBFrame(std::move(frame), config, luma_address);
+            });
         break;
     case VideoPixelFormat::YUV420:
-        WriteYUVFrame(std::move(frame), config);
+        write_worker.QueueWork([this, frame = std::move(frame), config,
+                                luma_address = output_surface_luma_address,
+                                chroma_address = output_surface_chroma_address]() mutable {
+            WriteYUVFrame(std::move(frame), config, luma_address, chroma_address);
+        });
         break;
     default:
         UNIMPLEMENTED_MSG("Unknown video pixel format {:X}", config.pixel_format.Value());
@@ -109,43 +198,42 @@ void Vic::Execute() {
     }
 }
 
-void Vic::WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config) {
+void Vic::WriteRGBFrame(std::shared_ptr<FFmpeg::Frame> frame, const VicConfig& config,
+                        GPUVAddr luma_address) {
     LOG_TRACE(Service_NVDRV, "Writing RGB Frame");
 
     const auto frame_width = frame->GetWidth();
     const auto frame_height = frame->GetHeight();
     const auto frame_format = frame->GetPixelFormat();
+    const auto target_format = GetTargetFormat(config.pixel_format);
 
-    if (!scaler_ctx || frame_width != scaler_width || frame_height != scaler_height) {
-        const AVPixelFormat target_format = [pixel_format = config.pixel_format]() {
-            switch (pixel_format) {
-            case VideoPixelFormat::RGBA8:
-                return AV_PIX_FMT_RGBA;
-            case VideoPixelFormat::BGRA8:
-                return AV_PIX_FMT_BGRA;
-            case VideoPixelFormat::RGBX8:
-                return AV_PIX_FMT_RGB0;
-            default:
-                return AV_PIX_FMT_RGBA;
-            }
-        }();
-
-        sws_freeContext(scaler_ctx);
+    const u32 slice_height = Common::AlignUp(
+        Common::DivCeil(static_cast<u32>(frame_height), slice_count), SliceAlignment);
+    if (scaler_contexts.empty() || frame_width != scaler_width || frame_height != scaler_height ||
+        frame_format != scaler_source_format || target_format != scaler_target_format) {
+        for (auto* const scaler_context : scaler_contexts) {
+            sws_freeContext(scaler_context);
+        }
+        scaler_contexts.clear();
         // Frames are decoded into either YUV420 or NV12 formats. Convert to desired RGB format
-        scaler_ctx = sws_getContext(frame_width, frame_height, frame_format, frame_width,
-                                    frame_height, target_format, 0, nullptr, nullptr, nullptr);
+        for (s32 line = 0; line < frame_height; line += static_cast<s32>(slice_height)) {
+            const auto lines = std::min(static_cast<s32>(slice_height), frame_height - line);
+            scaler_contexts.push_back(sws_getContext(frame_width, lines, frame_format,
+                                                     frame_width, lines, target_format, 0,
+                                                     nullptr, nullptr, nullptr));
+        }
         scaler_width = frame_width;
         scaler_height = frame_height;
+        scaler_source_format = frame_format;
+        scaler_target_format = target_format;
         converted_frame_buffer.reset();
     }
     if (!converted_frame_buffer) {
         const size_t frame_size = frame_width * frame_height * 4;
         converted_frame_buffer = AVMallocPtr{static_cast<u8*>(av_malloc(frame_size)), av_free};
     }
-    const std::array<int, 4> converted_stride{frame_width * 4, frame_height * 4, 0, 0};
+    const u32 converted_stride = static_cast<u32>(frame_width) * 4;
     u8* const converted_frame_buf_addr{converted_frame_buffer.get()};
-    sws_scale(scaler_ctx, frame->GetPlanes(), frame->GetStrides(), 0, frame_height,
-              &converted_frame_buf_addr, converted_stride.data());
 
     // Use the minimum of surface/frame dimensions to avoid buffer overflow.
     const u32 surface_width = static_cast<u32>(config.surface_width_minus1) + 1;
@@ -153,25 +241,61 @@ void Vic::WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
     const u32 width = std::min(surface_width, static_cast<u32>(frame_width));
     const u32 height = std::min(surface_height, static_cast<u32>(frame_height));
     const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
-    if (blk_kind != 0) {
-        // swizzle pitch linear to block linear
-        const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
-        const auto size = Texture::CalculateSize(true, 4, width, height, 1, block_height, 0);
-        luma_buffer.resize_destructive(size);
-        std::span<const u8> frame_buff(converted_frame_buf_addr, 4 * width * height);
-        Texture::SwizzleSubrect(luma_buffer, frame_buff, 4, width, height, 1, 0, 0, width, height,
-                                block_height, 0, width * 4);
-
-        host1x.GMMU().WriteBlock(output_surface_luma_address, luma_buffer.data(), size);
-    } else {
+    const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
+    const size_t size = blk_kind != 0
+                            ? Texture::CalculateSize(true, 4, width, height, 1, block_height, 0)
+                            : width * height * 4;
+    luma_buffer.resize_destructive(size);
+    OutputSurface output{host1x.GMMU(), luma_address, size, &luma_buffer};
+
+    // Pitch linear frames the size of the surface are converted straight into it.
+    const bool convert_to_output = blk_kind == 0 && width == static_cast<u32>(frame_width) &&
+                                   height == static_cast<u32>(frame_height);
+    u8* const converted_base = convert_to_output ? output.data() : converted_frame_buf_addr;
+
+    // Each slice is converted by its own scaler, starting from the slice's first line, and
+    // swizzled as soon as it is converted.
+    const auto* const pixel_format_desc = av_pix_fmt_desc_get(frame_format);
+    ForEachSlice(static_cast<u32>(frame_height), SliceAlignment,
+                 [&](u32 slice, u32 line_begin, u32 line_end) {
+                     std::array<const u8*, 4> planes{};
+                     for (size_t plane = 0; plane < planes.size(); ++plane) {
+                         const u8* const data = frame->GetData(static_cast<int>(plane));
+                         if (!data) {
+                             continue;
+                         }
+                         const bool is_chroma = plane == 1 || plane == 2;
+                         const u32 plane_line =
+                             is_chroma ? line_begin >> pixel_format_desc->log2_chroma_h
+                                       : line_begin;
+                         planes[plane] = data + plane_line * frame->GetStride(
+                                                                 static_cast<int>(plane));
+                     }
+                     u8* const converted_slice = converted_base + line_begin * converted_stride;
+                     const int converted_slice_stride = static_cast<int>(converted_stride);
+                     sws_scale(scaler_contexts[slice], planes.data(), frame->GetStrides(), 0,
+                               static_cast<int>(line_end - line_begin), &converted_slice,
+                               &converted_slice_stride);
+
+                     if (blk_kind != 0 && line_begin < height) {
+                         // swizzle pitch linear to block linear
+                         Texture::SwizzleLines(
+                             std::span<u8>(output.data(), size),
+                             std::span<const u8>(converted_frame_buf_addr,
+                                                 converted_stride * frame_height),
+                             width * 4, line_begin, std::min(line_end, height), block_height,
+                             converted_stride);
+                     }
+                 });
+
+    if (blk_kind == 0 && !convert_to_output) {
         // send pitch linear frame
-        const size_t linear_size = width * height * 4;
-        host1x.GMMU().WriteBlock(output_surface_luma_address, converted_frame_buf_addr,
-                                 linear_size);
+        std::memcpy(output.data(), converted_frame_buf_addr, size);
     }
 }
 
-void Vic::WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config) {
+void Vic::WriteYUVFrame(std::shared_ptr<FFmpeg::Frame> frame, const VicConfig& config,
+                        GPUVAddr luma_address, GPUVAddr chroma_address) {
     LOG_TRACE(Service_NVDRV, "Writing YUV420 Frame");
 
     const std::size_t surface_width = config.surface_width_minus1 + 1;
@@ -182,58 +306,48 @@ void Vic::WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
     const auto frame_height = std::min(surface_height, static_cast<size_t>(frame->GetHeight()));
 
     const auto stride = static_cast<size_t>(frame->GetStride(0));
+    const auto half_stride = static_cast<size_t>(frame->GetStride(1));
+    const auto pixel_format = frame->GetPixelFormat();
+    if (pixel_format != AV_PIX_FMT_YUV420P && pixel_format != AV_PIX_FMT_NV12) {
+        ASSERT(false);
+        return;
+    }
 
-    luma_buffer.resize_destructive(aligned_width * surface_height);
-    chroma_buffer.resize_destructive(aligned_width * surface_height / 2);
+    // The decoded planes are copied straight to the output surfaces.
+    const std::size_t luma_size = aligned_width * surface_height;
+    const std::size_t chroma_size = aligned_width * surface_height / 2;
+    luma_buffer.resize_destructive(luma_size);
+    chroma_buffer.resize_destructive(chroma_size);
+    OutputSurface luma{host1x.GMMU(), luma_address, luma_size, &luma_buffer};
+    OutputSurface chroma{host1x.GMMU(), chroma_address, chroma_size, &chroma_buffer};
 
-    // Populate luma buffer
     const u8* luma_src = frame->GetData(0);
-    for (std::size_t y = 0; y < frame_height; ++y) {
-        const std::size_t src = y * stride;
-        const std::size_t dst = y * aligned_width;
-        std::memcpy(luma_buffer.data() + dst, luma_src + src, frame_width);
-    }
-    host1x.GMMU().WriteBlock(output_surface_luma_address, luma_buffer.data(), luma_buffer.size());
+    u8* const luma_buffer_data = luma.data();
+    u8* const chroma_buffer_data = chroma.data();
+    ForEachSlice(static_cast<u32>(frame_height), SliceAlignment,
+                 [&](u32, u32 line_begin, u32 line_end) {
+                     // Populate luma buffer
+                     for (std::size_t y = line_begin; y < line_end; ++y) {
+                         std::memcpy(luma_buffer_data + y * aligned_width, luma_src + y * stride,
+                                     frame_width);
+                     }
 
-    // Chroma
-    const std::size_t half_height = frame_height / 2;
-    const auto half_stride = static_cast<size_t>(frame->GetStride(1));
-
-    switch (frame->GetPixelFormat()) {
-    case AV_PIX_FMT_YUV420P: {
-        // Frame from FFmpeg software
-        // Populate chroma buffer from both channels with interleaving.
-        const std::size_t half_width = frame_width / 2;
-        u8* chroma_buffer_data = chroma_buffer.data();
-        const u8* chroma_b_src = frame->GetData(1);
-        const u8* chroma_r_src = frame->GetData(2);
-        for (std::size_t y = 0; y < half_height; ++y) {
-            const std::size_t src = y * half_stride;
-            const std::size_t dst = y * aligned_width;
-            for (std::size_t x = 0; x < half_width; ++x) {
-                chroma_buffer_data[dst + x * 2] = chroma_b_src[src + x];
-                chroma_buffer_data[dst + x * 2 + 1] = chroma_r_src[src + x];
-            }
-        }
-        break;
-    }
-    case AV_PIX_FMT_NV12: {
-        // Frame from VA-API hardware
-        // This is already interleaved so just copy
-        const u8* chroma_src = frame->GetData(1);
-        for (std::size_t y = 0; y < half_height; ++y) {
-            const std::size_t src = y * stride;
-            const std::size_t dst = y * aligned_width;
-            std::memcpy(chroma_buffer.data() + dst, chroma_src + src, frame_width);
-        }
-        break;
-    }
-    default:
-        ASSERT(false);
-        break;
-    }
-    host1x.GMMU().WriteBlock(output_surface_chroma_address, chroma_buffer.data(),
-                             chroma_buffer.size());
+                     // Chroma
+                     for (std::size_t y = line_begin / 2; y < line_end / 2; ++y) {
+                         u8* const dst = chroma_buffer_data + y * aligned_width;
+                         if (pixel_format == AV_PIX_FMT_YUV420P) {
+                             // Frame from FFmpeg software
+                             // Populate chroma buffer from both channels with interleaving.
+                             InterleaveChroma(dst, frame->GetData(1) + y * half_stride,
+                                              frame->GetData(2) + y * half_stride,
+                                              frame_width / 2);
+                         } else {
+                             // Frame from VA-API hardware
+                             // This is already interleaved so just copy
+                             std::memcpy(dst, frame->GetData(1) + y * stride, frame_width);
+                         }
+                     }
+                 });
 }
 
 } // namespace Host1x
@@ -4,9 +4,12 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/scratch_buffer.h"
+#include "common/thread_worker.h"
+#include "common/unique_function.h"
 
 struct SwsContext;
 
@@ -36,12 +39,23 @@ public:
     /// Write to the device state.
     void ProcessMethod(Method method, u32 argument);
 
+    /// Run func once the frames executed so far have been written to their output surfaces.
+    void QueueAfterWrites(Common::UniqueFunction<void> func);
+
 private:
     void Execute();
 
-    void WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config);
+    void WriteRGBFrame(std::shared_ptr<FFmpeg::Frame> frame, const VicConfig& config,
+                       GPUVAddr luma_address);
+
+    void WriteYUVFrame(std::shared_ptr<FFmpeg::Frame> frame, const VicConfig& config,
+                       GPUVAddr luma_address, GPUVAddr chroma_address);
 
-    void WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config);
+    /// Split the lines [0, height) into one slice per slice worker, with the lines of each slice
+    /// but the last a multiple of alignment, and call func(slice, line_begin, line_end) for each of
+    /// them concurrently.
+    template <typename Func>
+    void ForEachSlice(u32 height, u32 alignment, Func&& func);
 
     Host1x& host1x;
     std::shared_ptr<Tegra::Host1x::Nvdec> nvdec_processor;
@@ -57,9 +71,18 @@ private:
     GPUVAddr output_surface_luma_address{};
     GPUVAddr output_surface_chroma_address{};
 
-    SwsContext* scaler_ctx{};
+    /// One scaler for each slice, as a scaler converts the lines of a frame in order
+    std::vector<SwsContext*> scaler_contexts;
     s32 scaler_width{};
     s32 scaler_height{};
+    s32 scaler_source_format{};
+    s32 scaler_target_format{};
+
+    u32 slice_count;
+    /// Converts the slices of a frame concurrently
+    Common::ThreadWorker slice_workers;
+    /// Converts and writes out frames in order, so the next frame can be decoded meanwhile
+    Common::ThreadWorker write_worker;
 };
 
 } // namespace Host1x
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstring>
@@ -222,6 +223,36 @@ void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_p
     }
 }
 
+void SwizzleLines(std::span<u8> output, std::span<const u8> input, u32 width_bytes, u32 line_begin,
+                  u32 line_end, u32 block_height, u32 pitch_linear) {
+    // The low 4 bits of x are kept as they are by the swizzle, so each 16 byte chunk of a line is
+    // contiguous in the GOB.
+    static constexpr u32 CHUNK_SIZE = 16;
+    static_assert((SWIZZLE_X_BITS & (CHUNK_SIZE - 1)) == CHUNK_SIZE - 1);
+
+    const u32 stride = Common::AlignUpLog2(width_bytes, GOB_SIZE_X_SHIFT);
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height);
+    const u32 block_height_mask = (1U << block_height) - 1;
+    const u32 x_shift = GOB_SIZE_SHIFT + block_height;
+
+    for (u32 y = line_begin; y < line_end; ++y) {
+        const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
+        const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+        const u32 offset_y = (block_y >> block_height) * block_size +
+                             ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+        const u8* const src = &input[y * pitch_linear];
+
+        u32 swizzled_x = 0;
+        for (u32 x = 0; x < width_bytes;
+             x += CHUNK_SIZE, incrpdep<SWIZZLE_X_BITS, CHUNK_SIZE>(swizzled_x)) {
+            const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
+            const u32 swizzled_offset = offset_y + offset_x + (swizzled_x | swizzled_y);
+            std::memcpy(&output[swizzled_offset], src + x, std::min(CHUNK_SIZE, width_bytes - x));
+        }
+    }
+}
+
 void UnswizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x,
                       u32 extent_y, u32 block_height, u32 block_depth, u32 pitch_linear) {
@@ -60,6 +60,11 @@ void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_p
                     u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 extent_y,
                     u32 block_height, u32 block_depth, u32 pitch_linear);
 
+/// Copies lines [line_begin, line_end) of a 2D linear surface into a tiled surface, a row of a GOB
+/// at a time. Disjoint ranges of lines can be swizzled concurrently.
+void SwizzleLines(std::span<u8> output, std::span<const u8> input, u32 width_bytes, u32 line_begin,
+                  u32 line_end, u32 block_height, u32 pitch_linear);
+
 /// Copies a tiled subrectangle into a linear surface.
 void UnswizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x,
@@ -50,6 +50,7 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     INSERT(Settings, audio_muted, tr("Mute audio"), QStringLiteral());
     INSERT(Settings, volume, tr("Volume:"), QStringLiteral());
     INSERT(Settings, dump_audio_commands, QStringLiteral(), QStringLiteral());
+    INSERT(Settings, dump_audio_renderer_updates, QStringLiteral(), QStringLiteral());
     INSERT(UISettings, mute_when_in_background, tr("Mute audio when in background"),
            QStringLiteral());
 
@@ -71,6 +72,14 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
               "faster or not.\n200% for a 30 FPS game is 60 FPS, and for a "
               "60 FPS game it will be 120 FPS.\nDisabling it means unlocking the framerate to the "
               "maximum your PC can reach."));
+    INSERT(Settings, use_adaptive_spin_yield, tr("Yield host CPU on guest spin-waits"),
+           tr("Detects emulated cores busy-waiting on timers, yields or WFE and briefly gives "
+              "their host CPU time to other threads.\nImproves performance on hosts with few CPU "
+              "cores. Only applies to multicore emulation."));
+    INSERT(Settings, use_jit_warmup, tr("Warm up CPU translation cache"),
+           tr("Records the guest code translated while playing, and translates it ahead of time "
+              "on idle emulated cores the next time the game boots.\nReduces stutter when "
+              "starting the game or entering new areas. Only applies to multicore emulation."));
 
     // Cpu
     INSERT(Settings, cpu_accuracy, tr("Accuracy:"),
@@ -150,6 +159,10 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            tr("Specifies how videos should be decoded.\nIt can either use the CPU or the GPU for "
               "decoding, or perform no decoding at all (black screen on videos).\n"
               "In most cases, GPU decoding provides the best performance."));
+    INSERT(Settings, nvdec_frame_threading, tr("Decode video frames in parallel"),
+           tr("Decodes several video frames at once when using CPU video decoding.\n"
+              "Speeds up high resolution videos on CPUs with many cores, at the cost of a few "
+              "frames of delay."));
     INSERT(Settings, accelerate_astc, tr("ASTC Decoding Method:"),
            tr("This option controls how ASTC textures should be decoded.\n"
               "CPU: Use the CPU for decoding, slowest but safest method.\n"
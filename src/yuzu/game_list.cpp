@@ -19,6 +19,7 @@
 #include "core/core.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
+#include "core/game_library_index.h"
 #include "yuzu/compatibility_list.h"
 #include "yuzu/game_list.h"
 #include "yuzu/game_list_p.h"
@@ -861,9 +862,14 @@ void GameList::LoadInterfaceLayout() {
     header->resizeSection(COLUMN_NAME, header->width());
 }
 
-const QStringList GameList::supported_file_extensions = {
-    QStringLiteral("nso"), QStringLiteral("nro"), QStringLiteral("nca"),
-    QStringLiteral("xci"), QStringLiteral("nsp"), QStringLiteral("kip")};
+const QStringList GameList::supported_file_extensions = [] {
+    QStringList extensions;
+    for (const auto extension : Core::GameLibraryIndex::SupportedExtensions) {
+        extensions.append(
+            QString::fromLatin1(extension.data(), static_cast<int>(extension.size())));
+    }
+    return extensions;
+}();
 
 void GameList::RefreshGameDirectory() {
     if (!UISettings::values.game_dirs.empty() && current_worker != nullptr) {
@@ -14,14 +14,13 @@
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "core/core.h"
-#include "core/file_sys/card_image.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/control_metadata.h"
 #include "core/file_sys/fs_filesystem.h"
 #include "core/file_sys/nca_metadata.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
-#include "core/file_sys/submission_package.h"
+#include "core/game_library_index.h"
 #include "core/loader/loader.h"
 #include "yuzu/compatibility_list.h"
 #include "yuzu/game_list.h"
@@ -139,11 +138,6 @@ void GetMetadataFromControlNCA(const FileSys::PatchManager& patch_manager, const
         });
 }
 
-bool HasSupportedFileExtension(const std::string& file_name) {
-    const QFileInfo file = QFileInfo(QString::fromStdString(file_name));
-    return GameList::supported_file_extensions.contains(file.suffix(), Qt::CaseInsensitive);
-}
-
 bool IsExtractedNCAMain(const std::string& file_name) {
     return QFileInfo(QString::fromStdString(file_name)).fileName() == QStringLiteral("main");
 }
@@ -160,10 +154,9 @@ QString FormatGameName(const std::string& physical_name) {
 }
 
 QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
-                                Loader::AppLoader& loader, bool updatable = true) {
+                                Loader::FileType file_type, FileSys::VirtualFile update_raw,
+                                bool updatable = true) {
     QString out;
-    FileSys::VirtualFile update_raw;
-    loader.ReadUpdateRaw(update_raw);
     for (const auto& patch : patch_manager.GetPatches(update_raw)) {
         const bool is_update = patch.name == "Update";
         if (!updatable && is_update) {
@@ -180,7 +173,7 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
 
             // Display container name for packed updates
             if (is_update && ver == "PACKED") {
-                ver = Loader::GetFileTypeString(loader.GetFileType());
+                ver = Loader::GetFileTypeString(file_type);
             }
 
             out.append(QStringLiteral("%1 (%2)\n").arg(type, QString::fromStdString(ver)));
@@ -193,10 +186,11 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
 
 QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::string& name,
                                         const std::size_t size, const std::vector<u8>& icon,
-                                        Loader::AppLoader& loader, u64 program_id,
+                                        Loader::FileType file_type, u64 program_id,
                                         const CompatibilityList& compatibility_list,
                                         const PlayTime::PlayTimeManager& play_time_manager,
-                                        const FileSys::PatchManager& patch) {
+                                        const FileSys::PatchManager& patch,
+                                        const std::function<QString()>& patch_versions_generator) {
     const auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
 
     // The game list uses this as compatibility number for untested games
@@ -205,7 +199,6 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         compatibility = it->second.first;
     }
 
-    const auto file_type = loader.GetFileType();
     const auto file_type_string = QString::fromStdString(Loader::GetFileTypeString(file_type));
 
     QList<QStandardItem*> list{
@@ -218,9 +211,7 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
     };
 
     const auto patch_versions = GetGameListCachedObject(
-        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
-            return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
-        });
+        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", patch_versions_generator);
     list.insert(2, new GameListItem(patch_versions));
 
     return list;
@@ -234,8 +225,8 @@ GameListWorker::GameListWorker(FileSys::VirtualFilesystem vfs_,
                                const PlayTime::PlayTimeManager& play_time_manager_,
                                Core::System& system_)
     : vfs{std::move(vfs_)}, provider{provider_}, game_dirs{game_dirs_},
-      compatibility_list{compatibility_list_}, play_time_manager{play_time_manager_}, system{
-                                                                                          system_} {
+      compatibility_list{compatibility_list_}, play_time_manager{play_time_manager_},
+      system{system_}, library_index{system_, vfs} {
     // We want the game list to manage our lifetime.
     setAutoDelete(false);
 }
@@ -328,119 +319,64 @@ void GameListWorker::AddTitlesToGameList(GameListDir* parent_dir) {
             GetMetadataFromControlNCA(patch, *control, icon, name);
         }
 
-        auto entry = MakeGameListEntry(file->GetFullPath(), name, file->GetSize(), icon, *loader,
-                                       program_id, compatibility_list, play_time_manager, patch);
+        auto entry = MakeGameListEntry(
+            file->GetFullPath(), name, file->GetSize(), icon, loader->GetFileType(), program_id,
+            compatibility_list, play_time_manager, patch, [&patch, &loader] {
+                FileSys::VirtualFile update_raw;
+                loader->ReadUpdateRaw(update_raw);
+                return FormatPatchNameVersions(patch, loader->GetFileType(), update_raw,
+                                               loader->IsRomFSUpdatable());
+            });
         RecordEvent([=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
     }
 }
 
-void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_path, bool deep_scan,
+void GameListWorker::ScanFileSystem(const std::string& dir_path, bool deep_scan,
                                     GameListDir* parent_dir) {
-    const auto callback = [this, target, parent_dir](const std::filesystem::path& path) -> bool {
-        if (stop_requested) {
-            // Breaks the callback loop.
-            return false;
-        }
-
-        const auto physical_name = Common::FS::PathToUTF8String(path);
-        const auto is_dir = Common::FS::IsDir(path);
+    const auto files = library_index.ScanContents(
+        dir_path, deep_scan, stop_requested, [this](const std::string& physical_name) {
+            watch_list.append(QString::fromStdString(physical_name));
+        });
 
-        if (!is_dir &&
-            (HasSupportedFileExtension(physical_name) || IsExtractedNCAMain(physical_name))) {
-            const auto file = vfs->OpenFile(physical_name, FileSys::OpenMode::Read);
-            if (!file) {
-                return true;
+    // Register the contents of all files first, so that updates and DLC anywhere in the directory
+    // are known when the programs are read.
+    for (const auto& file : files) {
+        for (const auto& content : file->contents) {
+            const auto nca = library_index.OpenRange(*file, content.offset, content.size);
+            if (nca != nullptr) {
+                provider->AddEntry(content.title_type, content.record_type, content.title_id,
+                                   nca);
             }
+        }
+    }
 
-            auto loader = Loader::GetLoader(system, file);
-            if (!loader) {
-                return true;
-            }
+    library_index.ReadPrograms(files, stop_requested);
 
-            const auto file_type = loader->GetFileType();
-            if (file_type == Loader::FileType::Unknown || file_type == Loader::FileType::Error) {
-                return true;
-            }
+    for (const auto& file : files) {
+        if (stop_requested) {
+            break;
+        }
 
-            u64 program_id = 0;
-            const auto res2 = loader->ReadProgramId(program_id);
-
-            if (target == ScanTarget::FillManualContentProvider) {
-                if (res2 == Loader::ResultStatus::Success && file_type == Loader::FileType::NCA) {
-                    provider->AddEntry(FileSys::TitleType::Application,
-                                       FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
-                                       program_id, file);
-                } else if (res2 == Loader::ResultStatus::Success &&
-                           (file_type == Loader::FileType::XCI ||
-                            file_type == Loader::FileType::NSP)) {
-                    const auto nsp = file_type == Loader::FileType::NSP
-                                         ? std::make_shared<FileSys::NSP>(file)
-                                         : FileSys::XCI{file}.GetSecurePartitionNSP();
-                    for (const auto& title : nsp->GetNCAs()) {
-                        for (const auto& entry : title.second) {
-                            provider->AddEntry(entry.first.first, entry.first.second, title.first,
-                                               entry.second->GetBaseFile());
-                        }
-                    }
-                }
-            } else {
-                std::vector<u64> program_ids;
-                loader->ReadProgramIds(program_ids);
-
-                if (res2 == Loader::ResultStatus::Success && program_ids.size() > 1 &&
-                    (file_type == Loader::FileType::XCI || file_type == Loader::FileType::NSP)) {
-                    for (const auto id : program_ids) {
-                        loader = Loader::GetLoader(system, file, id);
-                        if (!loader) {
-                            continue;
-                        }
-
-                        std::vector<u8> icon;
-                        [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                        std::string name = " ";
-                        [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
-
-                        const FileSys::PatchManager patch{id, system.GetFileSystemController(),
-                                                          system.GetContentProvider()};
-
-                        auto entry = MakeGameListEntry(
-                            physical_name, name, Common::FS::GetSize(physical_name), icon, *loader,
-                            id, compatibility_list, play_time_manager, patch);
-
-                        RecordEvent(
-                            [=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
+        for (const auto& program : file->programs) {
+            const FileSys::PatchManager patch{program.program_id,
+                                              system.GetFileSystemController(),
+                                              system.GetContentProvider()};
+
+            auto entry = MakeGameListEntry(
+                file->path, program.title, file->size, program.icon, file->file_type,
+                program.program_id, compatibility_list, play_time_manager, patch,
+                [this, &patch, &file, &program] {
+                    FileSys::VirtualFile update_raw;
+                    if (program.update_size != 0) {
+                        update_raw = library_index.OpenRange(*file, program.update_offset,
+                                                             program.update_size);
                     }
-                } else {
-                    std::vector<u8> icon;
-                    [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                    std::string name = " ";
-                    [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
-
-                    const FileSys::PatchManager patch{program_id, system.GetFileSystemController(),
-                                                      system.GetContentProvider()};
+                    return FormatPatchNameVersions(patch, file->file_type, update_raw,
+                                                   program.romfs_updatable);
+                });
 
-                    auto entry = MakeGameListEntry(
-                        physical_name, name, Common::FS::GetSize(physical_name), icon, *loader,
-                        program_id, compatibility_list, play_time_manager, patch);
-
-                    RecordEvent(
-                        [=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
-                }
-            }
-        } else if (is_dir) {
-            watch_list.append(QString::fromStdString(physical_name));
+            RecordEvent([=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
         }
-
-        return true;
-    };
-
-    if (deep_scan) {
-        Common::FS::IterateDirEntriesRecursively(dir_path, callback,
-                                                 Common::FS::DirEntryFilter::All);
-    } else {
-        Common::FS::IterateDirEntries(dir_path, callback, Common::FS::DirEntryFilter::File);
     }
 }
 
@@ -448,6 +384,10 @@ void GameListWorker::run() {
     watch_list.clear();
     provider->ClearAllEntries();
 
+    if (UISettings::values.cache_game_list) {
+        library_index.Load();
+    }
+
     const auto DirEntryReady = [&](GameListDir* game_list_dir) {
         RecordEvent([=](GameList* game_list) { game_list->AddDirEntry(game_list_dir); });
     };
@@ -473,13 +413,15 @@ void GameListWorker::run() {
             watch_list.append(QString::fromStdString(game_dir.path));
             auto* const game_list_dir = new GameListDir(game_dir);
             DirEntryReady(game_list_dir);
-            ScanFileSystem(ScanTarget::FillManualContentProvider, game_dir.path, game_dir.deep_scan,
-                           game_list_dir);
-            ScanFileSystem(ScanTarget::PopulateGameList, game_dir.path, game_dir.deep_scan,
-                           game_list_dir);
+            ScanFileSystem(game_dir.path, game_dir.deep_scan, game_list_dir);
         }
     }
 
+    // A partial scan would drop the files it did not reach from the index.
+    if (UISettings::values.cache_game_list && !stop_requested) {
+        library_index.Save();
+    }
+
     RecordEvent([this](GameList* game_list) { game_list->DonePopulating(watch_list); });
     processing_completed.Set();
 }
@@ -14,6 +14,7 @@
 #include <QString>
 
 #include "common/thread.h"
+#include "core/game_library_index.h"
 #include "yuzu/compatibility_list.h"
 #include "yuzu/play_time_manager.h"
 
@@ -68,13 +69,7 @@ private:
 private:
     void AddTitlesToGameList(GameListDir* parent_dir);
 
-    enum class ScanTarget {
-        FillManualContentProvider,
-        PopulateGameList,
-    };
-
-    void ScanFileSystem(ScanTarget target, const std::string& dir_path, bool deep_scan,
-                        GameListDir* parent_dir);
+    void ScanFileSystem(const std::string& dir_path, bool deep_scan, GameListDir* parent_dir);
 
     std::shared_ptr<FileSys::VfsFilesystem> vfs;
     FileSys::ManualContentProvider* provider;
@@ -91,4 +86,5 @@ private:
     Common::Event processing_completed;
 
     Core::System& system;
+    Core::GameLibraryIndex library_index;
 };